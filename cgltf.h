@@ -34,23 +34,164 @@
  * `void cgltf_free(cgltf_data*)` frees the allocated `cgltf_data`
  * variable.
  *
+ * `cgltf_size cgltf_write_cache(const cgltf_data*, void* buffer, cgltf_size
+ * size)` serializes parsed data into a relocatable blob, so that later runs
+ * can skip the JSON. All objects, arrays and strings are stored in one block
+ * with offsets in place of pointers, followed by a table of the pointers to
+ * relocate; the JSON is kept for `cgltf_copy_extras_json()`, and so are the
+ * BIN chunk and the buffers that were loaded. Returns the size of the cache,
+ * and only writes it if `buffer` is large enough. `cgltf_result
+ * cgltf_parse_cache(const cgltf_options*, void* cache, cgltf_size,
+ * cgltf_data**)` turns such a blob back into `cgltf_data` by relocating the
+ * pointers in place, without any allocation; the memory, which must be
+ * writable and 8-byte aligned (e.g. a private copy-on-write mapping), stays
+ * owned by the caller and must outlive the data, and can only be parsed once.
+ * `cgltf_result cgltf_parse_cache_file(const cgltf_options*, const char* path,
+ * cgltf_data**)` reads the file in one go, honoring `file_read` but not
+ * `map_files`, and hands it to `cgltf_free()`. Caches are specific to the
+ * build that wrote them: caches from other versions of cgltf or with other
+ * pointer or struct sizes are rejected with `cgltf_result_unknown_format`.
+ * Caches are trusted input: the relocations are checked to stay inside the
+ * block, but the element counts and strings are not, so a cache must come
+ * from `cgltf_write_cache()` rather than from an untrusted source.
+ *
  * `cgltf_result cgltf_load_buffers(const cgltf_options*, cgltf_data*,
  * const char* gltf_path)` can be optionally called to open and read buffer
  * files using the `FILE*` APIs. The `gltf_path` argument is the path to
  * the original glTF file, which allows the parser to resolve the path to
  * buffer files.
  *
+ * `cgltf_result cgltf_load_buffer(const cgltf_options*, cgltf_data*,
+ * cgltf_size index, const char* gltf_path)` loads a single buffer the same
+ * way. It only touches `cgltf_data::buffers[index]`, so different buffers can
+ * be loaded concurrently, e.g. by dispatching one job per buffer whose `data`
+ * is still NULL, provided that the allocation and file callbacks are
+ * thread-safe. Calling `cgltf_load_buffers()` once all jobs are done skips the
+ * buffers that were loaded and retries the others, which reports the first
+ * failure in buffer order.
+ *
  * `cgltf_result cgltf_load_buffer_base64(const cgltf_options* options,
  * cgltf_size size, const char* base64, void** out_data)` decodes
  * base64-encoded data content. Used internally by `cgltf_load_buffers()`
- * and may be useful if you're not dealing with normal files.
+ * and may be useful if you're not dealing with normal files. Large inputs are
+ * decoded with SSSE3, AVX2 or NEON when the compiler targets them.
  *
  * `cgltf_result cgltf_parse_file(const cgltf_options* options, const
  * char* path, cgltf_data** out_data)` can be used to open the given
  * file using `FILE*` APIs and parse the data using `cgltf_parse()`.
  *
+ * If `cgltf_options::map_files` is set, `cgltf_parse_file()` and
+ * `cgltf_load_buffers()` map files into memory with `mmap` or `MapViewOfFile`
+ * instead of reading them. `cgltf_data::file_data`, `cgltf_data::bin` and
+ * `cgltf_buffer::data` then point straight into the read-only mappings, which
+ * are unmapped by `cgltf_free()`. Define `CGLTF_NO_FILE_MAPPING` to compile
+ * without mapping support, in which case files are always read.
+ *
+ * All file access can be redirected by setting `cgltf_options::file_read`,
+ * which takes precedence over `map_files`. It receives the path of the file
+ * and the expected size in `*size` (0 if unknown) and returns the contents
+ * and their actual size through `size` and `data`. The returned memory is
+ * used as is, without copying, and is handed to `cgltf_options::file_release`
+ * by `cgltf_free()`; if `file_release` is NULL, the application keeps
+ * ownership of the data. The release callback and `file_user_data` are
+ * recorded by `cgltf_parse()`, so `cgltf_load_buffers()` must be called with
+ * the same file callbacks.
+ *
+ * If `cgltf_options::arena_allocation` is set, all objects, arrays and strings
+ * created by `cgltf_parse()` are carved from a few large blocks, which are
+ * sized from the JSON size and released at once by `cgltf_free()`. Buffers
+ * loaded by `cgltf_load_buffers()` still use `cgltf_options::memory_alloc`.
+ *
+ * If `cgltf_options::strings_in_place` is set, `cgltf_parse()` makes a single
+ * copy of the JSON chunk and null-terminates names, URIs and other strings
+ * inside it, so that they do not need an allocation each. The strings then
+ * share the lifetime of the `cgltf_data`, just like allocated ones. Combined
+ * with `arena_allocation`, the copy is placed in the arena as well.
+ *
+ * `cgltf_options::sections` restricts parsing to the given top-level sections;
+ * the others are skipped without being materialized and stay empty. Sections
+ * that the requested ones cannot do without are added automatically: meshes,
+ * skins and animations need accessors, accessors and images need buffer views,
+ * buffer views need buffers, and skins, animations and scenes need nodes.
+ * References into skipped sections (for example `cgltf_node::mesh` when only
+ * nodes are parsed) are set to NULL.
+ *
+ * A zero-initialized `cgltf_context` can be passed in `cgltf_options::context`
+ * to reuse memory across many `cgltf_parse()` calls, e.g. one context per
+ * worker thread. The context keeps the JSON token buffer, which only grows
+ * when a document needs more tokens than any before it, and with
+ * `arena_allocation` it takes back the largest arena block when the data is
+ * freed and hands it to the next parse. A context must only be used by one
+ * thread at a time, including `cgltf_free()` calls for data parsed with it, and
+ * always with the same allocation callbacks. `void cgltf_context_free(
+ * cgltf_context*)` releases the kept memory; data parsed into an arena with
+ * the context must be freed before that.
+ *
+ * Large documents can be parsed on several threads by setting
+ * `cgltf_options::parallel_for` to a function that calls `task(task_data, i)`
+ * for every `i` below `count`, in any order and on any threads, and returns
+ * once all calls are done, e.g. on top of a job system; it receives
+ * `cgltf_options::parallel_user_data`. The elements of the `accessors`,
+ * `bufferViews`, `meshes`, `materials` and `nodes` arrays are then parsed in
+ * batches of `CGLTF_PARALLEL_BATCH_SIZE`, after finding their token ranges,
+ * and so are the pointer fixups of meshes, accessors and materials. Smaller
+ * arrays are parsed serially, and so is everything with `arena_allocation`,
+ * whose blocks are not thread-safe. The memory callbacks must be thread-safe.
+ * Errors do not depend on scheduling: the first invalid element is reported.
+ *
+ * A zero-initialized `cgltf_stats` can be passed in `cgltf_options::stats` to
+ * profile the loading of an asset. `cgltf_parse()`, `cgltf_parse_file()`,
+ * `cgltf_load_buffers()` and `cgltf_validate_parallel()` add the number of
+ * tokens, the bytes of JSON, files and base64 data and the number and size of
+ * the successful `memory_alloc` calls they make to it, so that one `cgltf_stats` can sum
+ * up all steps. Times are only measured with a `cgltf_stats::clock`, since
+ * cgltf has no clock of its own; they cover file I/O, tokenizing, building the
+ * objects, resolving references, base64 decoding and validation. With
+ * `arena_allocation`, the arena blocks count as allocations rather than the
+ * objects carved from them. Elements parsed through `parallel_for` count
+ * their allocations per batch, so the callbacks are never shared between
+ * threads; the clock is only called from the calling thread.
+ *
+ * `cgltf_result cgltf_parse_asset_info(const cgltf_options*, const void*,
+ * cgltf_size, cgltf_asset_info*)` is a cheap alternative to `cgltf_parse()` for
+ * tools that only need to know what a file contains. It checks the GLB header
+ * and scans the JSON without tokenizing or allocating anything, and fills in the
+ * asset strings, the number of elements of every top-level array and the
+ * extension lists. The strings and lists are `cgltf_json_span`s pointing into
+ * the passed-in data, without quotes and with JSON escapes left as they are;
+ * `extensions_used` and `extensions_required` span the whole JSON array. Only
+ * `cgltf_options::type` is used.
+ *
+ * `cgltf_result cgltf_stream_init(const cgltf_options*, cgltf_stream*)` starts
+ * parsing a GLB file whose bytes arrive piece by piece, e.g. over the network.
+ * Every piece is passed to `cgltf_result cgltf_stream_feed(cgltf_stream*,
+ * const void*, cgltf_size)` in order. As soon as the JSON chunk is complete it
+ * is parsed into `cgltf_stream::data` and `on_data` is called; the BIN chunk
+ * is then copied into a new allocation that becomes the `data` of the first
+ * buffer, as `cgltf_load_buffers()` would have set it, and `on_buffer_view` is
+ * called for every buffer view of that buffer once all of its bytes are in, in
+ * the order in which they end. The contents of a buffer view may only be read
+ * once it has been signaled; `cgltf_stream::complete` is set after the last
+ * byte of the file. After an error the stream stops, and every later call to
+ * `cgltf_stream_feed()` returns the same error, which is also kept in
+ * `cgltf_stream::error`. `void cgltf_stream_free(cgltf_stream*)` releases the
+ * state of the stream but not the parsed data, which is freed with
+ * `cgltf_free()` afterwards. Streams only accept GLB files.
+ *
  * `cgltf_result cgltf_validate(cgltf_data*)` can be used to do additional
- * checks to make sure the parsed glTF data is valid.
+ * checks to make sure the parsed glTF data is valid. Index bounds are
+ * computed with SSE2, AVX2 or NEON when the compiler targets them.
+ *
+ * `cgltf_result cgltf_validate_parallel(const cgltf_options*, cgltf_data*)`
+ * does the same checks, spreading accessors and meshes across
+ * `cgltf_options::parallel_for` when there are enough of them; the first
+ * failure in element order is reported, as with `cgltf_validate()`.
+ *
+ * `cgltf_validate_accessor`, `cgltf_validate_primitive` and
+ * `cgltf_validate_mesh` run the checks of a single object, including the
+ * bounds of the buffer views that it uses, so that streaming loaders can
+ * validate only what they touch once its buffers are loaded. Mesh checks
+ * include those of its primitives, but not of their accessors.
  *
  * `cgltf_node_transform_local` converts the translation / rotation / scale properties of a node
  * into a mat4.
@@ -58,14 +199,78 @@
  * `cgltf_node_transform_world` calls `cgltf_node_transform_local` on every ancestor in order
  * to compute the root-to-node transformation.
  *
+ * `cgltf_scene_compute_world_transforms` computes the world matrices of all nodes of a scene in
+ * a single top-down traversal, computing every local matrix only once. It neither recurses nor
+ * allocates, so hierarchies of any depth are fine. `out_matrices` must hold 16 floats for each node
+ * in `cgltf_data::nodes` and is indexed by node index; matrices of nodes that are not part of the scene are left untouched. If `scene` is NULL, all nodes are processed.
+ *
+ * `cgltf_skin_compute_joint_matrices` fills the joint matrix palette of a skin, the world matrix of
+ * every joint times its inverse bind matrix, without walking up the node hierarchy. `world_matrices`
+ * is indexed by node index as filled by `cgltf_scene_compute_world_transforms`, and
+ * `inverse_bind_matrices` holds 16 floats per joint, decoded once with `cgltf_accessor_unpack_floats`
+ * from `cgltf_skin::inverse_bind_matrices`; NULL stands for identity matrices, as when the skin has
+ * none. `out_matrices` receives 16 floats per joint.
+ *
+ * `cgltf_node_table_create` copies the fields of all nodes that a traversal of the hierarchy
+ * needs into a `cgltf_node_table`, one array per field in a single allocation: parent, children,
+ * mesh and translation / rotation / scale as node and mesh indices and packed floats, with the
+ * matrices of the few nodes that have one out of line. Everything else stays in `cgltf_node`, which
+ * `cgltf_node_table::data` still refers to. `cgltf_node_table::order` lists the nodes reachable
+ * from the roots with every parent before its children, so that
+ * `cgltf_node_table_compute_world_transforms` is a single loop over the nodes; it produces the
+ * same matrices as `cgltf_scene_compute_world_transforms` with a NULL scene. The table is a copy
+ * and is not updated when the nodes change. `cgltf_accessor_table_create` does the same for the
+ * count, offset, stride, buffer view, type, component type and flags of all accessors, leaving the
+ * bounds and sparse storage in `cgltf_accessor`. Tables are released with `cgltf_node_table_free`
+ * and `cgltf_accessor_table_free`.
+ *
+ * `cgltf_animation_clip_create` decodes the keyframes of all samplers of an animation into one
+ * allocation, assuming that `cgltf_load_buffers` has already been called, and prepares one
+ * `cgltf_animation_track` per channel. `cgltf_animation_clip_sample` then evaluates every track at
+ * the given time, clamped to the keyframes, and writes its translation, rotation quaternion, scale
+ * or morph weights to `out + track.output_offset`; `out` must hold `cgltf_animation_clip::output_count`
+ * floats. Rotations are interpolated with slerp and normalized. Each track remembers the keyframe it
+ * found, so sampling at increasing times only steps forward; other times fall back to a binary
+ * search. A clip must only be sampled by one thread at a time, and is released with
+ * `cgltf_animation_clip_free`.
+ *
  * `cgltf_accessor_read_float` reads a certain element from an accessor and converts it to
  * floating point, assuming that `cgltf_load_buffers` has already been called. The passed-in element
  * size is the number of floats in the output buffer, which should be in the range [1, 16]. Returns
- * false if the passed-in element_size is too small, or if the accessor is sparse.
+ * false if the passed-in element_size is too small, or if the accessor data is not available.
+ * Sparse accessors are supported; the sparse indices are binary searched, so lookups take
+ * logarithmic time in the number of sparse elements.
  *
  * `cgltf_accessor_read_index` is similar to its floating-point counterpart, but it returns size_t
  * and only works with single-component data types.
  *
+ * `cgltf_accessor_unpack_floats` converts all elements of an accessor into a tightly packed
+ * float array, which is considerably faster than calling `cgltf_accessor_read_float` for every
+ * element. If `out` is NULL, returns the number of floats required, otherwise writes as many
+ * whole elements as fit into `float_count` floats and returns the number of floats written.
+ * `cgltf_accessor_unpack_floats_range` does the same for `count` elements starting at `first`.
+ * Both apply sparse substitution in a single pass after decoding the base data (or zeros if the
+ * accessor has no buffer view), and return 0 if the accessor has no loaded data.
+ * Tightly packed 8-bit and 16-bit data is converted with SSE2, AVX2 or NEON when the compiler
+ * targets them; define `CGLTF_NO_SIMD` to always use the scalar code.
+ *
+ * `cgltf_accessor_unpack_indices` writes the indices of an unsigned integer scalar accessor into
+ * an array with `out_component_size` (1, 2 or 4) bytes per index. If `out` is NULL, returns the
+ * number of indices in the accessor, otherwise the number of indices written, which is limited by
+ * `index_count`. Returns 0 if the indices do not fit into the requested size without truncation.
+ *
+ * `cgltf_primitive_write_vertices` fills an interleaved vertex buffer with the attributes of a
+ * primitive, with one `cgltf_vertex_element` per attribute giving its byte offset and output
+ * format. If `out` is NULL, returns the number of vertices of the primitive, otherwise writes up to
+ * `vertex_count` vertices of `cgltf_vertex_layout::stride` bytes each and returns their number, or
+ * 0 if an element does not fit into the stride or the data is not loaded. Vertices are written in
+ * blocks, all elements of a block at once. Elements stored in exactly the requested format are
+ * copied, and if all of them come from one buffer view with the same stride and relative offsets,
+ * the whole buffer is a single copy, which also copies the bytes between elements. Other elements
+ * are converted, rounding to nearest and clamping normalized values to the target range.
+ * Attributes that the primitive lacks and components that the accessor lacks are set to
+ * (0, 0, 0, 1).
+ *
  * `cgltf_result cgltf_copy_extras_json(const cgltf_data*, const cgltf_extras*,
  * char* dest, cgltf_size* dest_size)` allows to retrieve the "extras" data that
  * can be attached to many glTF objects (which can be arbitrary JSON data). The
@@ -96,15 +301,6 @@ typedef enum cgltf_file_type
 	cgltf_file_type_glb,
 } cgltf_file_type;
 
-typedef struct cgltf_options
-{
-	cgltf_file_type type; /* invalid == auto detect */
-	cgltf_size json_token_count; /* 0 == auto */
-	void* (*memory_alloc)(void* user, cgltf_size size);
-	void (*memory_free) (void* user, void* ptr);
-	void* memory_user_data;
-} cgltf_options;
-
 typedef enum cgltf_result
 {
 	cgltf_result_success,
@@ -118,6 +314,84 @@ typedef enum cgltf_result
 	cgltf_result_out_of_memory,
 } cgltf_result;
 
+typedef enum cgltf_section
+{
+	cgltf_section_meshes = 1 << 0,
+	cgltf_section_accessors = 1 << 1,
+	cgltf_section_buffer_views = 1 << 2,
+	cgltf_section_buffers = 1 << 3,
+	cgltf_section_materials = 1 << 4,
+	cgltf_section_images = 1 << 5,
+	cgltf_section_textures = 1 << 6,
+	cgltf_section_samplers = 1 << 7,
+	cgltf_section_skins = 1 << 8,
+	cgltf_section_cameras = 1 << 9,
+	cgltf_section_lights = 1 << 10,
+	cgltf_section_nodes = 1 << 11,
+	cgltf_section_scenes = 1 << 12,
+	cgltf_section_animations = 1 << 13,
+	cgltf_section_all = (1 << 14) - 1,
+} cgltf_section;
+
+typedef struct cgltf_context
+{
+	void* tokens;
+	cgltf_size tokens_capacity;
+	struct cgltf_arena_block* arena_block;
+	void (*memory_free) (void* user, void* ptr);
+	void* memory_user_data;
+} cgltf_context;
+
+typedef struct cgltf_stats
+{
+	double (*clock)(void* user); /* optional, returns the current time in seconds; without it, times stay zero */
+	void* clock_user_data;
+
+	cgltf_size tokens_count;
+	cgltf_size json_size; /* bytes of JSON tokenized */
+	cgltf_size files_count;
+	cgltf_size file_size; /* bytes read or mapped from files */
+	cgltf_size base64_size; /* bytes decoded from data URIs */
+	cgltf_size allocations_count; /* successful calls to memory_alloc */
+	cgltf_size allocations_size;
+
+	double file_time;
+	double tokenize_time;
+	double parse_time; /* building objects from the tokens */
+	double fixup_time; /* resolving references between objects */
+	double base64_time;
+	double validate_time;
+} cgltf_stats;
+
+typedef struct cgltf_options
+{
+	cgltf_file_type type; /* invalid == auto detect */
+	cgltf_size json_token_count; /* 0 == auto */
+	void* (*memory_alloc)(void* user, cgltf_size size);
+	void (*memory_free) (void* user, void* ptr);
+	void* memory_user_data;
+	cgltf_bool map_files; /* map files into memory instead of reading them, see cgltf_parse_file */
+	cgltf_result (*file_read)(void* user, const char* path, cgltf_size* size, void** data);
+	void (*file_release)(void* user, void* data);
+	void* file_user_data;
+	cgltf_bool arena_allocation; /* allocate parsed objects from a few large blocks instead of one allocation each */
+	cgltf_bool strings_in_place; /* point strings into one writable copy of the JSON instead of allocating each */
+	cgltf_int sections; /* 0 == all, otherwise a combination of cgltf_section flags to parse */
+	cgltf_context* context; /* optional, keeps buffers for the next cgltf_parse call with the same context */
+	cgltf_bool compact_json; /* cgltf_write: leave out line breaks and indentation */
+	void (*parallel_for)(void* user, cgltf_size count, void (*task)(void* task_data, cgltf_size index), void* task_data); /* optional, see cgltf_parse */
+	void* parallel_user_data;
+	cgltf_stats* stats; /* optional, statistics are added to it, see cgltf_parse */
+} cgltf_options;
+
+typedef enum cgltf_data_free_method
+{
+	cgltf_data_free_method_memory_free,
+	cgltf_data_free_method_unmap,
+	cgltf_data_free_method_file_release,
+	cgltf_data_free_method_none,
+} cgltf_data_free_method;
+
 typedef enum cgltf_buffer_view_type
 {
 	cgltf_buffer_view_type_invalid,
@@ -215,6 +489,7 @@ typedef struct cgltf_buffer
 	cgltf_size size;
 	char* uri;
 	void* data; /* loaded by cgltf_load_buffers */
+	cgltf_data_free_method data_free_method;
 	cgltf_extras extras;
 } cgltf_buffer;
 
@@ -487,6 +762,8 @@ typedef struct cgltf_data
 {
 	cgltf_file_type file_type;
 	void* file_data;
+	cgltf_size file_size;
+	cgltf_data_free_method file_data_free_method;
 
 	cgltf_asset asset;
 
@@ -550,8 +827,169 @@ typedef struct cgltf_data
 
 	void (*memory_free) (void* user, void* ptr);
 	void* memory_user_data;
+
+	void (*file_release) (void* user, void* data);
+	void* file_user_data;
+
+	struct cgltf_arena* arena;
+	char* json_copy;
+	cgltf_bool cached; /* all objects live in file_data, see cgltf_parse_cache */
 } cgltf_data;
 
+typedef struct cgltf_json_span
+{
+	const char* data;
+	cgltf_size size;
+} cgltf_json_span;
+
+typedef struct cgltf_asset_info
+{
+	cgltf_file_type file_type;
+
+	cgltf_json_span copyright;
+	cgltf_json_span generator;
+	cgltf_json_span version;
+	cgltf_json_span min_version;
+
+	cgltf_json_span extensions_used;
+	cgltf_size extensions_used_count;
+
+	cgltf_json_span extensions_required;
+	cgltf_size extensions_required_count;
+
+	cgltf_size meshes_count;
+	cgltf_size materials_count;
+	cgltf_size accessors_count;
+	cgltf_size buffer_views_count;
+	cgltf_size buffers_count;
+	cgltf_size images_count;
+	cgltf_size textures_count;
+	cgltf_size samplers_count;
+	cgltf_size skins_count;
+	cgltf_size cameras_count;
+	cgltf_size lights_count;
+	cgltf_size nodes_count;
+	cgltf_size scenes_count;
+	cgltf_size animations_count;
+
+	cgltf_size bin_size;
+} cgltf_asset_info;
+
+typedef struct cgltf_animation_track
+{
+	const cgltf_float* times;
+	const cgltf_float* values; /* in-tangent, value and out-tangent per keyframe for cubic splines */
+	cgltf_size keyframes_count;
+	cgltf_size components_count; /* 3 for translation and scale, 4 for rotation, one per morph target for weights */
+	cgltf_size output_offset; /* first float of this track in the output of cgltf_animation_clip_sample */
+	cgltf_size cursor; /* keyframe found by the last sample */
+	cgltf_interpolation_type interpolation;
+	cgltf_animation_path_type target_path;
+	cgltf_node* target_node;
+} cgltf_animation_track;
+
+typedef struct cgltf_animation_clip
+{
+	const cgltf_animation* animation;
+	cgltf_animation_track* tracks; /* one per channel */
+	cgltf_size tracks_count;
+	cgltf_size output_count; /* number of floats written by cgltf_animation_clip_sample */
+	cgltf_float duration;
+
+	void (*memory_free) (void* user, void* ptr);
+	void* memory_user_data;
+} cgltf_animation_clip;
+
+typedef struct cgltf_node_table
+{
+	const cgltf_data* data; /* for the fields of cgltf_node that are not in the table */
+	cgltf_size nodes_count;
+	cgltf_int* parents; /* node index, -1 for roots */
+	cgltf_size* children_offsets; /* nodes_count + 1 entries, the children of node i are children[children_offsets[i]] to children[children_offsets[i + 1] - 1] */
+	cgltf_int* children; /* node indices */
+	cgltf_int* meshes; /* mesh index, -1 for nodes without a mesh */
+	cgltf_float* translations; /* 3 per node */
+	cgltf_float* rotations; /* 4 per node */
+	cgltf_float* scales; /* 3 per node */
+	cgltf_int* matrix_indices; /* index into matrices, -1 for nodes with translation / rotation / scale */
+	cgltf_float* matrices; /* 16 per node with a matrix */
+	cgltf_size matrices_count;
+	cgltf_int* order; /* nodes reachable from the roots, every parent before its children */
+	cgltf_size order_count;
+
+	void (*memory_free) (void* user, void* ptr);
+	void* memory_user_data;
+} cgltf_node_table;
+
+typedef enum cgltf_accessor_flags
+{
+	cgltf_accessor_flag_normalized = 1,
+	cgltf_accessor_flag_sparse = 2,
+	cgltf_accessor_flag_min = 4,
+	cgltf_accessor_flag_max = 8
+} cgltf_accessor_flags;
+
+typedef struct cgltf_accessor_table
+{
+	const cgltf_data* data; /* for the fields of cgltf_accessor that are not in the table */
+	cgltf_size accessors_count;
+	cgltf_size* counts;
+	cgltf_size* offsets;
+	cgltf_size* strides;
+	cgltf_int* buffer_views; /* buffer view index, -1 for accessors without a buffer view */
+	unsigned char* component_types; /* cgltf_component_type */
+	unsigned char* types; /* cgltf_type */
+	unsigned char* flags; /* cgltf_accessor_flags */
+
+	void (*memory_free) (void* user, void* ptr);
+	void* memory_user_data;
+} cgltf_accessor_table;
+
+#define CGLTF_VERTEX_ELEMENTS_MAX 32
+
+typedef struct cgltf_vertex_element
+{
+	cgltf_attribute_type attribute_type;
+	cgltf_int index; /* set index, as in TEXCOORD_1 */
+	cgltf_type type; /* number of components written */
+	cgltf_component_type component_type;
+	cgltf_bool normalized;
+	cgltf_size offset; /* in bytes from the start of the vertex */
+} cgltf_vertex_element;
+
+typedef struct cgltf_vertex_layout
+{
+	const cgltf_vertex_element* elements;
+	cgltf_size elements_count; /* at most CGLTF_VERTEX_ELEMENTS_MAX */
+	cgltf_size stride; /* in bytes */
+} cgltf_vertex_layout;
+
+typedef struct cgltf_stream
+{
+	/* optional, set by the caller after cgltf_stream_init */
+	void (*on_data)(void* user, cgltf_data* data);
+	void (*on_buffer_view)(void* user, cgltf_data* data, cgltf_buffer_view* buffer_view);
+	void* user_data;
+
+	cgltf_data* data; /* set once the JSON chunk has been parsed, released by the caller with cgltf_free */
+	cgltf_size received; /* bytes of the file fed so far */
+	cgltf_size bin_received; /* bytes of the BIN chunk stored in data->buffers[0].data so far */
+	cgltf_bool complete;
+	cgltf_result error; /* the first error, which every later cgltf_stream_feed returns */
+
+	/* internal */
+	cgltf_options options;
+	unsigned char header[20];
+	unsigned char* json_chunk;
+	unsigned char* bin;
+	cgltf_size total_size;
+	cgltf_size json_size;
+	cgltf_size bin_size;
+	cgltf_buffer_view** views; /* views of the BIN chunk, sorted by their end */
+	cgltf_size views_count;
+	cgltf_size views_signaled;
+} cgltf_stream;
+
 cgltf_result cgltf_parse(
 		const cgltf_options* options,
 		const void* data,
@@ -563,25 +1001,75 @@ cgltf_result cgltf_parse_file(
 		const char* path,
 		cgltf_data** out_data);
 
+cgltf_result cgltf_parse_asset_info(
+		const cgltf_options* options,
+		const void* data,
+		cgltf_size size,
+		cgltf_asset_info* out_info);
+
+cgltf_result cgltf_stream_init(const cgltf_options* options, cgltf_stream* stream);
+cgltf_result cgltf_stream_feed(cgltf_stream* stream, const void* bytes, cgltf_size size);
+void cgltf_stream_free(cgltf_stream* stream);
+
 cgltf_result cgltf_load_buffers(
 		const cgltf_options* options,
 		cgltf_data* data,
 		const char* gltf_path);
 
+cgltf_result cgltf_load_buffer(
+		const cgltf_options* options,
+		cgltf_data* data,
+		cgltf_size index,
+		const char* gltf_path);
+
 
 cgltf_result cgltf_load_buffer_base64(const cgltf_options* options, cgltf_size size, const char* base64, void** out_data);
 
 cgltf_result cgltf_validate(
 		cgltf_data* data);
 
+cgltf_result cgltf_validate_parallel(
+		const cgltf_options* options,
+		cgltf_data* data);
+
+cgltf_result cgltf_validate_accessor(const cgltf_accessor* accessor);
+cgltf_result cgltf_validate_primitive(const cgltf_primitive* primitive);
+cgltf_result cgltf_validate_mesh(const cgltf_mesh* mesh);
+
 void cgltf_free(cgltf_data* data);
 
+cgltf_size cgltf_write_cache(const cgltf_data* data, void* buffer, cgltf_size size);
+cgltf_result cgltf_parse_cache(const cgltf_options* options, void* cache, cgltf_size size, cgltf_data** out_data);
+cgltf_result cgltf_parse_cache_file(const cgltf_options* options, const char* path, cgltf_data** out_data);
+
+void cgltf_context_free(cgltf_context* context);
+
 void cgltf_node_transform_local(const cgltf_node* node, cgltf_float* out_matrix);
 void cgltf_node_transform_world(const cgltf_node* node, cgltf_float* out_matrix);
+void cgltf_scene_compute_world_transforms(const cgltf_data* data, const cgltf_scene* scene, cgltf_float* out_matrices);
+void cgltf_skin_compute_joint_matrices(const cgltf_data* data, const cgltf_skin* skin, const cgltf_float* world_matrices, const cgltf_float* inverse_bind_matrices, cgltf_float* out_matrices);
+
+cgltf_result cgltf_animation_clip_create(const cgltf_options* options, const cgltf_animation* animation, cgltf_animation_clip* out_clip);
+void cgltf_animation_clip_sample(cgltf_animation_clip* clip, cgltf_float time, cgltf_float* out);
+void cgltf_animation_clip_free(cgltf_animation_clip* clip);
+
+cgltf_result cgltf_node_table_create(const cgltf_options* options, const cgltf_data* data, cgltf_node_table* out_table);
+void cgltf_node_table_compute_world_transforms(const cgltf_node_table* table, cgltf_float* out_matrices);
+void cgltf_node_table_free(cgltf_node_table* table);
+
+cgltf_result cgltf_accessor_table_create(const cgltf_options* options, const cgltf_data* data, cgltf_accessor_table* out_table);
+void cgltf_accessor_table_free(cgltf_accessor_table* table);
 
 cgltf_bool cgltf_accessor_read_float(const cgltf_accessor* accessor, cgltf_size index, cgltf_float* out, cgltf_size element_size);
 cgltf_size cgltf_accessor_read_index(const cgltf_accessor* accessor, cgltf_size index);
 
+cgltf_size cgltf_accessor_unpack_floats(const cgltf_accessor* accessor, cgltf_float* out, cgltf_size float_count);
+cgltf_size cgltf_accessor_unpack_floats_range(const cgltf_accessor* accessor, cgltf_size first, cgltf_size count, cgltf_float* out, cgltf_size float_count);
+
+cgltf_size cgltf_accessor_unpack_indices(const cgltf_accessor* accessor, void* out, cgltf_size out_component_size, cgltf_size index_count);
+
+cgltf_size cgltf_primitive_write_vertices(const cgltf_primitive* primitive, const cgltf_vertex_layout* layout, void* out, cgltf_size vertex_count);
+
 cgltf_result cgltf_copy_extras_json(const cgltf_data* data, const cgltf_extras* extras, char* dest, cgltf_size* dest_size);
 
 #ifdef __cplusplus
@@ -606,10 +1094,37 @@ cgltf_result cgltf_copy_extras_json(const cgltf_data* data, const cgltf_extras*
 
 #include <stdint.h> /* For uint8_t, uint32_t */
 #include <string.h> /* For strncpy */
-#include <stdlib.h> /* For malloc, free */
+#include <stdlib.h> /* For malloc, free, qsort */
 #include <stdio.h>  /* For fopen */
 #include <limits.h> /* For UINT_MAX etc */
 
+#if !defined(CGLTF_NO_FILE_MAPPING) && defined(_WIN32)
+#define CGLTF_FILE_MAPPING_WIN32
+#include <windows.h> /* For CreateFileMapping, MapViewOfFile */
+#elif !defined(CGLTF_NO_FILE_MAPPING) && (defined(__unix__) || defined(__APPLE__))
+#define CGLTF_FILE_MAPPING_POSIX
+#include <fcntl.h> /* For open */
+#include <unistd.h> /* For close */
+#include <sys/mman.h> /* For mmap, munmap */
+#include <sys/stat.h> /* For fstat */
+#endif
+
+#if !defined(CGLTF_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define CGLTF_SIMD_SSE2
+#include <emmintrin.h> /* For SSE2 intrinsics */
+#if defined(__SSSE3__) || defined(__AVX2__)
+#define CGLTF_SIMD_SSSE3
+#include <tmmintrin.h> /* For SSSE3 intrinsics */
+#endif
+#if defined(__AVX2__)
+#define CGLTF_SIMD_AVX2
+#include <immintrin.h> /* For AVX2 intrinsics */
+#endif
+#elif !defined(CGLTF_NO_SIMD) && (defined(__aarch64__) || defined(_M_ARM64))
+#define CGLTF_SIMD_NEON
+#include <arm_neon.h> /* For NEON intrinsics */
+#endif
+
 /* JSMN_PARENT_LINKS is necessary to make parsing large structures linear in input size */
 #define JSMN_PARENT_LINKS
 
@@ -673,6 +1188,84 @@ static void cgltf_default_free(void* user, void* ptr)
 	free(ptr);
 }
 
+static void cgltf_stats_alloc(cgltf_stats* stats, cgltf_size size)
+{
+	if (stats)
+	{
+		stats->allocations_count++;
+		stats->allocations_size += size;
+	}
+}
+
+typedef struct cgltf_stats_allocator
+{
+	void* (*memory_alloc)(void* user, cgltf_size size);
+	void (*memory_free) (void* user, void* ptr);
+	void* memory_user_data;
+	cgltf_stats* stats;
+} cgltf_stats_allocator;
+
+static void* cgltf_stats_counting_alloc(void* user, cgltf_size size)
+{
+	cgltf_stats_allocator* allocator = (cgltf_stats_allocator*)user;
+	void* result = allocator->memory_alloc(allocator->memory_user_data, size);
+	if (result)
+	{
+		cgltf_stats_alloc(allocator->stats, size);
+	}
+	return result;
+}
+
+static void cgltf_stats_counting_free(void* user, void* ptr)
+{
+	cgltf_stats_allocator* allocator = (cgltf_stats_allocator*)user;
+	allocator->memory_free(allocator->memory_user_data, ptr);
+}
+
+/* Copies the options and, if they have stats that do not count allocations yet, routes memory_alloc through allocator
+ * to count them; returns whether it did, so that an entry point can call itself again with the counting options */
+static cgltf_bool cgltf_stats_count_allocations(const cgltf_options* options, cgltf_stats_allocator* allocator, cgltf_options* out_options)
+{
+	*out_options = *options;
+
+	if (!options->stats || options->memory_alloc == &cgltf_stats_counting_alloc)
+	{
+		return 0;
+	}
+
+	allocator->memory_alloc = options->memory_alloc ? options->memory_alloc : &cgltf_default_alloc;
+	allocator->memory_free = options->memory_free ? options->memory_free : &cgltf_default_free;
+	allocator->memory_user_data = options->memory_user_data;
+	allocator->stats = options->stats;
+
+	out_options->memory_alloc = &cgltf_stats_counting_alloc;
+	out_options->memory_free = &cgltf_stats_counting_free;
+	out_options->memory_user_data = allocator;
+	return 1;
+}
+
+/* Memory that outlives the call, like the data and the buffers kept by a context, is freed with the caller's allocator,
+ * since the counting one only lives as long as the call */
+static cgltf_options cgltf_caller_options(const cgltf_options* options)
+{
+	cgltf_options result = *options;
+
+	if (options->memory_alloc == &cgltf_stats_counting_alloc)
+	{
+		const cgltf_stats_allocator* allocator = (const cgltf_stats_allocator*)options->memory_user_data;
+		result.memory_alloc = allocator->memory_alloc;
+		result.memory_free = allocator->memory_free;
+		result.memory_user_data = allocator->memory_user_data;
+	}
+
+	return result;
+}
+
+static double cgltf_stats_clock(const cgltf_stats* stats)
+{
+	return stats && stats->clock ? stats->clock(stats->clock_user_data) : 0.0;
+}
+
 static void* cgltf_calloc(cgltf_options* options, size_t element_size, cgltf_size count)
 {
 	if (SIZE_MAX / element_size < count)
@@ -688,65 +1281,170 @@ static void* cgltf_calloc(cgltf_options* options, size_t element_size, cgltf_siz
 	return result;
 }
 
-static cgltf_result cgltf_parse_json(cgltf_options* options, const uint8_t* json_chunk, cgltf_size size, cgltf_data** out_data);
+typedef struct cgltf_arena_block
+{
+	struct cgltf_arena_block* next;
+	cgltf_size size;
+	cgltf_size used;
+} cgltf_arena_block;
 
-cgltf_result cgltf_parse(const cgltf_options* options, const void* data, cgltf_size size, cgltf_data** out_data)
+typedef struct cgltf_arena
 {
-	if (size < GlbHeaderSize)
+	void* (*memory_alloc)(void* user, cgltf_size size);
+	void (*memory_free) (void* user, void* ptr);
+	void* memory_user_data;
+	cgltf_arena_block* blocks;
+	cgltf_context* context;
+	cgltf_stats* stats;
+} cgltf_arena;
+
+/* Allocations are aligned to 16 bytes, so block headers are padded to that as well */
+#define CGLTF_ARENA_ALIGNMENT 16
+#define CGLTF_ARENA_HEADER_SIZE ((sizeof(cgltf_arena_block) + CGLTF_ARENA_ALIGNMENT - 1) & ~(cgltf_size)(CGLTF_ARENA_ALIGNMENT - 1))
+
+static cgltf_arena_block* cgltf_arena_add_block(cgltf_arena* arena, cgltf_size size)
+{
+	if (size > SIZE_MAX - CGLTF_ARENA_HEADER_SIZE)
 	{
-		return cgltf_result_data_too_short;
+		return NULL;
 	}
 
-	if (options == NULL)
+	cgltf_arena_block* block = (cgltf_arena_block*)arena->memory_alloc(arena->memory_user_data, CGLTF_ARENA_HEADER_SIZE + size);
+	if (!block)
 	{
-		return cgltf_result_invalid_options;
+		return NULL;
 	}
 
-	cgltf_options fixed_options = *options;
-	if (fixed_options.memory_alloc == NULL)
+	// The blocks outlive the call, so they come from the caller's allocator and are counted here
+	cgltf_stats_alloc(arena->stats, CGLTF_ARENA_HEADER_SIZE + size);
+
+	block->next = arena->blocks;
+	block->size = size;
+	block->used = 0;
+	arena->blocks = block;
+	return block;
+}
+
+static void* cgltf_arena_alloc(void* user, cgltf_size size)
+{
+	cgltf_arena* arena = (cgltf_arena*)user;
+	cgltf_arena_block* block = arena->blocks;
+
+	size = (size + CGLTF_ARENA_ALIGNMENT - 1) & ~(cgltf_size)(CGLTF_ARENA_ALIGNMENT - 1);
+
+	if (block->size - block->used < size)
 	{
-		fixed_options.memory_alloc = &cgltf_default_alloc;
+		// Grow geometrically so that a bad size estimate only costs a few extra blocks
+		block = cgltf_arena_add_block(arena, size > block->size * 2 ? size : block->size * 2);
+		if (!block)
+		{
+			return NULL;
+		}
 	}
-	if (fixed_options.memory_free == NULL)
+
+	void* result = (uint8_t*)block + CGLTF_ARENA_HEADER_SIZE + block->used;
+	block->used += size;
+	return result;
+}
+
+static void cgltf_arena_free(void* user, void* ptr)
+{
+	// Individual allocations are released together with the arena
+	(void)user;
+	(void)ptr;
+}
+
+static cgltf_arena* cgltf_arena_create(const cgltf_options* options, cgltf_size size)
+{
+	cgltf_arena* arena = (cgltf_arena*)options->memory_alloc(options->memory_user_data, sizeof(cgltf_arena));
+	if (!arena)
 	{
-		fixed_options.memory_free = &cgltf_default_free;
+		return NULL;
 	}
 
-	uint32_t tmp;
-	// Magic
-	memcpy(&tmp, data, 4);
-	if (tmp != GlbMagic)
+	cgltf_options caller_options = cgltf_caller_options(options);
+	arena->stats = options->stats;
+	arena->memory_alloc = caller_options.memory_alloc;
+	arena->memory_free = caller_options.memory_free;
+	arena->memory_user_data = caller_options.memory_user_data;
+	arena->blocks = NULL;
+	arena->context = options->context;
+
+	cgltf_context* context = options->context;
+
+	if (context && context->arena_block)
 	{
-		if (fixed_options.type == cgltf_file_type_invalid)
+		cgltf_arena_block* block = context->arena_block;
+		context->arena_block = NULL;
+
+		if (block->size >= size)
 		{
-			fixed_options.type = cgltf_file_type_gltf;
+			block->next = NULL;
+			block->used = 0;
+			arena->blocks = block;
+			return arena;
 		}
-		else if (fixed_options.type == cgltf_file_type_glb)
+
+		context->memory_free(context->memory_user_data, block);
+	}
+
+	if (!cgltf_arena_add_block(arena, size))
+	{
+		options->memory_free(options->memory_user_data, arena);
+		return NULL;
+	}
+
+	return arena;
+}
+
+static void cgltf_arena_destroy(cgltf_arena* arena)
+{
+	cgltf_arena_block* block = arena->blocks;
+	cgltf_arena_block* largest = NULL;
+
+	// A context keeps the largest block, so that parsing a similar document again does not need new blocks
+	if (arena->context && !arena->context->arena_block)
+	{
+		for (cgltf_arena_block* it = block; it; it = it->next)
 		{
-			return cgltf_result_unknown_format;
+			largest = (!largest || it->size > largest->size) ? it : largest;
 		}
 	}
 
-	if (fixed_options.type == cgltf_file_type_gltf)
+	while (block)
 	{
-		cgltf_result json_result = cgltf_parse_json(&fixed_options, (const uint8_t*)data, size, out_data);
-		if (json_result != cgltf_result_success)
+		cgltf_arena_block* next = block->next;
+
+		if (block != largest)
 		{
-			return json_result;
+			arena->memory_free(arena->memory_user_data, block);
 		}
 
-		(*out_data)->file_type = cgltf_file_type_gltf;
-
-		return cgltf_result_success;
+		block = next;
 	}
 
-	const uint8_t* ptr = (const uint8_t*)data;
-	// Version
-	memcpy(&tmp, ptr + 4, 4);
-	uint32_t version = tmp;
-	if (version != GlbVersion)
+	if (largest)
 	{
-		return cgltf_result_unknown_format;
+		arena->context->arena_block = largest;
+		arena->context->memory_free = arena->memory_free;
+		arena->context->memory_user_data = arena->memory_user_data;
+	}
+
+	arena->memory_free(arena->memory_user_data, arena);
+}
+
+static cgltf_result cgltf_parse_json(cgltf_options* options, const uint8_t* json_chunk, cgltf_size size, cgltf_data** out_data);
+
+static cgltf_result cgltf_parse_glb_chunks(const void* data, cgltf_size size, const uint8_t** out_json, cgltf_size* out_json_size, const void** out_bin, cgltf_size* out_bin_size)
+{
+	uint32_t tmp;
+	const uint8_t* ptr = (const uint8_t*)data;
+	// Version
+	memcpy(&tmp, ptr + 4, 4);
+	uint32_t version = tmp;
+	if (version != GlbVersion)
+	{
+		return cgltf_result_unknown_format;
 	}
 
 	// Total length
@@ -780,9 +1478,6 @@ cgltf_result cgltf_parse(const cgltf_options* options, const void* data, cgltf_s
 
 	json_chunk += GlbChunkHeaderSize;
 
-	const void* bin = 0;
-	cgltf_size bin_size = 0;
-
 	if (GlbHeaderSize + GlbChunkHeaderSize + json_length + GlbChunkHeaderSize <= size)
 	{
 		// We can read another chunk
@@ -805,1073 +1500,4639 @@ cgltf_result cgltf_parse(const cgltf_options* options, const void* data, cgltf_s
 
 		bin_chunk += GlbChunkHeaderSize;
 
-		bin = bin_chunk;
-		bin_size = bin_length;
-	}
-
-	cgltf_result json_result = cgltf_parse_json(&fixed_options, json_chunk, json_length, out_data);
-	if (json_result != cgltf_result_success)
-	{
-		return json_result;
+		*out_bin = bin_chunk;
+		*out_bin_size = bin_length;
 	}
 
-	(*out_data)->file_type = cgltf_file_type_glb;
-	(*out_data)->bin = bin;
-	(*out_data)->bin_size = bin_size;
+	*out_json = json_chunk;
+	*out_json_size = json_length;
 
 	return cgltf_result_success;
 }
 
-cgltf_result cgltf_parse_file(const cgltf_options* options, const char* path, cgltf_data** out_data)
+cgltf_result cgltf_parse(const cgltf_options* options, const void* data, cgltf_size size, cgltf_data** out_data)
 {
+	if (size < GlbHeaderSize)
+	{
+		return cgltf_result_data_too_short;
+	}
+
 	if (options == NULL)
 	{
 		return cgltf_result_invalid_options;
 	}
 
-	void* (*memory_alloc)(void*, cgltf_size) = options->memory_alloc ? options->memory_alloc : &cgltf_default_alloc;
-	void (*memory_free)(void*, void*) = options->memory_free ? options->memory_free : &cgltf_default_free;
-
-	FILE* file = fopen(path, "rb");
-	if (!file)
+	cgltf_stats_allocator counter;
+	cgltf_options fixed_options;
+	if (cgltf_stats_count_allocations(options, &counter, &fixed_options))
 	{
-		return cgltf_result_file_not_found;
+		return cgltf_parse(&fixed_options, data, size, out_data);
 	}
 
-	fseek(file, 0, SEEK_END);
-
-	long length = ftell(file);
-	if (length < 0)
+	if (fixed_options.memory_alloc == NULL)
 	{
-		fclose(file);
-		return cgltf_result_io_error;
+		fixed_options.memory_alloc = &cgltf_default_alloc;
+	}
+	if (fixed_options.memory_free == NULL)
+	{
+		fixed_options.memory_free = &cgltf_default_free;
 	}
 
-	fseek(file, 0, SEEK_SET);
-
-	char* file_data = (char*)memory_alloc(options->memory_user_data, length);
-	if (!file_data)
+	uint32_t tmp;
+	// Magic
+	memcpy(&tmp, data, 4);
+	if (tmp != GlbMagic)
 	{
-		fclose(file);
-		return cgltf_result_out_of_memory;
+		if (fixed_options.type == cgltf_file_type_invalid)
+		{
+			fixed_options.type = cgltf_file_type_gltf;
+		}
+		else if (fixed_options.type == cgltf_file_type_glb)
+		{
+			return cgltf_result_unknown_format;
+		}
 	}
 
-	cgltf_size file_size = (cgltf_size)length;
-	cgltf_size read_size = fread(file_data, 1, file_size, file);
+	if (fixed_options.type == cgltf_file_type_gltf)
+	{
+		cgltf_result json_result = cgltf_parse_json(&fixed_options, (const uint8_t*)data, size, out_data);
+		if (json_result != cgltf_result_success)
+		{
+			return json_result;
+		}
 
-	fclose(file);
+		(*out_data)->file_type = cgltf_file_type_gltf;
 
-	if (read_size != file_size)
-	{
-		memory_free(options->memory_user_data, file_data);
-		return cgltf_result_io_error;
+		return cgltf_result_success;
 	}
 
-	cgltf_result result = cgltf_parse(options, file_data, file_size, out_data);
+	const uint8_t* json_chunk = NULL;
+	cgltf_size json_length = 0;
+	const void* bin = NULL;
+	cgltf_size bin_size = 0;
 
-	if (result != cgltf_result_success)
+	cgltf_result glb_result = cgltf_parse_glb_chunks(data, size, &json_chunk, &json_length, &bin, &bin_size);
+	if (glb_result != cgltf_result_success)
 	{
-		memory_free(options->memory_user_data, file_data);
-		return result;
+		return glb_result;
 	}
 
-	(*out_data)->file_data = file_data;
+	cgltf_result json_result = cgltf_parse_json(&fixed_options, json_chunk, json_length, out_data);
+	if (json_result != cgltf_result_success)
+	{
+		return json_result;
+	}
+
+	(*out_data)->file_type = cgltf_file_type_glb;
+	(*out_data)->bin = bin;
+	(*out_data)->bin_size = bin_size;
 
 	return cgltf_result_success;
 }
 
-static void cgltf_combine_paths(char* path, const char* base, const char* uri)
+cgltf_result cgltf_stream_init(const cgltf_options* options, cgltf_stream* stream)
 {
-	const char* s0 = strrchr(base, '/');
-	const char* s1 = strrchr(base, '\\');
-	const char* slash = s0 ? (s1 && s1 > s0 ? s1 : s0) : s1;
-
-	if (slash)
+	if (options == NULL || options->type == cgltf_file_type_gltf)
 	{
-		size_t prefix = slash - base + 1;
+		return cgltf_result_invalid_options;
+	}
 
-		strncpy(path, base, prefix);
-		strcpy(path + prefix, uri);
+	memset(stream, 0, sizeof(cgltf_stream));
+	stream->options = *options;
+	if (stream->options.memory_alloc == NULL)
+	{
+		stream->options.memory_alloc = &cgltf_default_alloc;
 	}
-	else
+	if (stream->options.memory_free == NULL)
 	{
-		strcpy(path, uri);
+		stream->options.memory_free = &cgltf_default_free;
 	}
+
+	return cgltf_result_success;
 }
 
-static cgltf_result cgltf_load_buffer_file(const cgltf_options* options, cgltf_size size, const char* uri, const char* gltf_path, void** out_data)
+static int cgltf_compare_buffer_view_ends(const void* a, const void* b)
 {
-	void* (*memory_alloc)(void*, cgltf_size) = options->memory_alloc ? options->memory_alloc : &cgltf_default_alloc;
-	void (*memory_free)(void*, void*) = options->memory_free ? options->memory_free : &cgltf_default_free;
+	const cgltf_buffer_view* view_a = *(const cgltf_buffer_view* const*)a;
+	const cgltf_buffer_view* view_b = *(const cgltf_buffer_view* const*)b;
+	cgltf_size end_a = view_a->offset + view_a->size;
+	cgltf_size end_b = view_b->offset + view_b->size;
+	return end_a < end_b ? -1 : end_a > end_b;
+}
 
-	char* path = (char*)memory_alloc(options->memory_user_data, strlen(uri) + strlen(gltf_path) + 1);
-	if (!path)
+static void cgltf_stream_signal_buffer_views(cgltf_stream* stream)
+{
+	while (stream->views_signaled < stream->views_count)
 	{
-		return cgltf_result_out_of_memory;
-	}
-
-	cgltf_combine_paths(path, gltf_path, uri);
+		cgltf_buffer_view* view = stream->views[stream->views_signaled];
 
-	FILE* file = fopen(path, "rb");
+		if (view->offset + view->size > stream->bin_received)
+		{
+			break;
+		}
 
-	memory_free(options->memory_user_data, path);
+		stream->views_signaled++;
 
-	if (!file)
-	{
-		return cgltf_result_file_not_found;
+		if (stream->on_buffer_view)
+		{
+			stream->on_buffer_view(stream->user_data, stream->data, view);
+		}
 	}
+}
 
-	char* file_data = (char*)memory_alloc(options->memory_user_data, size);
-	if (!file_data)
+/* Called whenever a part of the file has been received: the GLB and JSON chunk headers, the JSON chunk or the BIN chunk header */
+static cgltf_result cgltf_stream_advance(cgltf_stream* stream)
+{
+	uint32_t tmp;
+	cgltf_size json_end = GlbHeaderSize + GlbChunkHeaderSize + stream->json_size;
+
+	if (stream->received == GlbHeaderSize + GlbChunkHeaderSize)
 	{
-		fclose(file);
-		return cgltf_result_out_of_memory;
-	}
+		memcpy(&tmp, stream->header, 4);
+		if (tmp != GlbMagic)
+		{
+			return cgltf_result_unknown_format;
+		}
 
-	cgltf_size read_size = fread(file_data, 1, size, file);
+		memcpy(&tmp, stream->header + 4, 4);
+		if (tmp != GlbVersion)
+		{
+			return cgltf_result_unknown_format;
+		}
 
-	fclose(file);
+		memcpy(&tmp, stream->header + 8, 4);
+		stream->total_size = tmp;
 
-	if (read_size != size)
-	{
-		memory_free(options->memory_user_data, file_data);
-		return cgltf_result_io_error;
-	}
+		memcpy(&tmp, stream->header + 12, 4);
+		stream->json_size = tmp;
 
-	*out_data = file_data;
+		memcpy(&tmp, stream->header + 16, 4);
+		if (tmp != GlbMagicJsonChunk)
+		{
+			return cgltf_result_unknown_format;
+		}
 
-	return cgltf_result_success;
-}
+		if (GlbHeaderSize + GlbChunkHeaderSize + stream->json_size > stream->total_size)
+		{
+			return cgltf_result_data_too_short;
+		}
 
-cgltf_result cgltf_load_buffer_base64(const cgltf_options* options, cgltf_size size, const char* base64, void** out_data)
-{
-	void* (*memory_alloc)(void*, cgltf_size) = options->memory_alloc ? options->memory_alloc : &cgltf_default_alloc;
-	void (*memory_free)(void*, void*) = options->memory_free ? options->memory_free : &cgltf_default_free;
+		stream->json_chunk = (unsigned char*)stream->options.memory_alloc(stream->options.memory_user_data, GlbHeaderSize + GlbChunkHeaderSize + stream->json_size);
+		if (!stream->json_chunk)
+		{
+			return cgltf_result_out_of_memory;
+		}
 
-	unsigned char* data = (unsigned char*)memory_alloc(options->memory_user_data, size);
-	if (!data)
-	{
-		return cgltf_result_out_of_memory;
+		memcpy(stream->json_chunk, stream->header, GlbHeaderSize + GlbChunkHeaderSize);
+		json_end = GlbHeaderSize + GlbChunkHeaderSize + stream->json_size;
 	}
 
-	unsigned int buffer = 0;
-	unsigned int buffer_bits = 0;
-
-	for (cgltf_size i = 0; i < size; ++i)
+	if (stream->received == json_end && !stream->data)
 	{
-		while (buffer_bits < 8)
+		cgltf_options options = stream->options;
+		cgltf_result result = cgltf_parse_json(&options, stream->json_chunk + GlbHeaderSize + GlbChunkHeaderSize, stream->json_size, &stream->data);
+		if (result != cgltf_result_success)
 		{
-			char ch = *base64++;
-
-			int index =
-				(unsigned)(ch - 'A') < 26 ? (ch - 'A') :
-				(unsigned)(ch - 'a') < 26 ? (ch - 'a') + 26 :
-				(unsigned)(ch - '0') < 10 ? (ch - '0') + 52 :
-				ch == '+' ? 62 :
-				ch == '/' ? 63 :
-				-1;
+			return result;
+		}
 
-			if (index < 0)
-			{
-				memory_free(options->memory_user_data, data);
-				return cgltf_result_io_error;
-			}
+		/* The data owns the JSON chunk from now on, since it points into it */
+		stream->data->file_type = cgltf_file_type_glb;
+		stream->data->file_data = stream->json_chunk;
+		stream->data->file_size = json_end;
+		stream->data->file_data_free_method = cgltf_data_free_method_memory_free;
+		stream->json_chunk = NULL;
 
-			buffer = (buffer << 6) | index;
-			buffer_bits += 6;
+		if (stream->on_data)
+		{
+			stream->on_data(stream->user_data, stream->data);
 		}
-
-		data[i] = (unsigned char)(buffer >> (buffer_bits - 8));
-		buffer_bits -= 8;
 	}
+	else if (stream->received == json_end + GlbChunkHeaderSize)
+	{
+		if (!stream->data)
+		{
+			return cgltf_result_invalid_json;
+		}
 
-	*out_data = data;
-
-	return cgltf_result_success;
-}
+		memcpy(&tmp, stream->header, 4);
+		stream->bin_size = tmp;
 
-cgltf_result cgltf_load_buffers(const cgltf_options* options, cgltf_data* data, const char* gltf_path)
-{
-	if (options == NULL)
-	{
-		return cgltf_result_invalid_options;
-	}
+		memcpy(&tmp, stream->header + 4, 4);
+		if (tmp != GlbMagicBinChunk)
+		{
+			return cgltf_result_unknown_format;
+		}
 
-	if (data->buffers_count && data->buffers[0].data == NULL && data->buffers[0].uri == NULL && data->bin)
-	{
-		if (data->bin_size < data->buffers[0].size)
+		if (json_end + GlbChunkHeaderSize + stream->bin_size > stream->total_size)
 		{
 			return cgltf_result_data_too_short;
 		}
 
-		data->buffers[0].data = (void*)data->bin;
-	}
+		cgltf_data* data = stream->data;
+		cgltf_buffer* buffer = data->buffers_count ? &data->buffers[0] : NULL;
 
-	for (cgltf_size i = 0; i < data->buffers_count; ++i)
-	{
-		if (data->buffers[i].data)
+		/* Like cgltf_load_buffers, the BIN chunk fills the first buffer if it has no URI */
+		if (!buffer || buffer->uri || buffer->data)
 		{
-			continue;
+			return cgltf_result_success;
 		}
 
-		const char* uri = data->buffers[i].uri;
+		if (stream->bin_size < buffer->size)
+		{
+			return cgltf_result_data_too_short;
+		}
 
-		if (uri == NULL)
+		buffer->data = stream->options.memory_alloc(stream->options.memory_user_data, stream->bin_size ? stream->bin_size : 1);
+		if (!buffer->data)
 		{
-			continue;
+			return cgltf_result_out_of_memory;
 		}
+		buffer->data_free_method = cgltf_data_free_method_memory_free;
+		stream->bin = (unsigned char*)buffer->data;
 
-		if (strncmp(uri, "data:", 5) == 0)
+		for (cgltf_size i = 0; i < data->buffer_views_count; ++i)
 		{
-			const char* comma = strchr(uri, ',');
+			stream->views_count += data->buffer_views[i].buffer == buffer;
+		}
 
-			if (comma && comma - uri >= 7 && strncmp(comma - 7, ";base64", 7) == 0)
+		if (stream->views_count)
+		{
+			stream->views = (cgltf_buffer_view**)stream->options.memory_alloc(stream->options.memory_user_data, stream->views_count * sizeof(cgltf_buffer_view*));
+			if (!stream->views)
 			{
-				cgltf_result res = cgltf_load_buffer_base64(options, data->buffers[i].size, comma + 1, &data->buffers[i].data);
+				return cgltf_result_out_of_memory;
+			}
 
-				if (res != cgltf_result_success)
+			cgltf_size count = 0;
+			for (cgltf_size i = 0; i < data->buffer_views_count; ++i)
+			{
+				if (data->buffer_views[i].buffer == buffer)
 				{
-					return res;
+					stream->views[count++] = &data->buffer_views[i];
 				}
 			}
-			else
-			{
-				return cgltf_result_unknown_format;
-			}
-		}
-		else if (strstr(uri, "://") == NULL)
-		{
-			cgltf_result res = cgltf_load_buffer_file(options, data->buffers[i].size, uri, gltf_path, &data->buffers[i].data);
 
-			if (res != cgltf_result_success)
-			{
-				return res;
-			}
-		}
-		else
-		{
-			return cgltf_result_unknown_format;
+			qsort(stream->views, stream->views_count, sizeof(cgltf_buffer_view*), &cgltf_compare_buffer_view_ends);
 		}
+
+		cgltf_stream_signal_buffer_views(stream);
 	}
 
 	return cgltf_result_success;
 }
 
-static cgltf_size cgltf_calc_size(cgltf_type type, cgltf_component_type component_type);
-
-static cgltf_size cgltf_calc_index_bound(cgltf_buffer_view* buffer_view, cgltf_size offset, cgltf_component_type component_type, cgltf_size count)
+cgltf_result cgltf_stream_feed(cgltf_stream* stream, const void* bytes, cgltf_size size)
 {
-	char* data = (char*)buffer_view->buffer->data + offset + buffer_view->offset;
-	cgltf_size bound = 0;
+	const uint8_t* ptr = (const uint8_t*)bytes;
 
-	switch (component_type)
+	if (stream->error != cgltf_result_success)
 	{
-	case cgltf_component_type_r_8u:
-		for (size_t i = 0; i < count; ++i)
+		return stream->error;
+	}
+
+	while (size > 0 && !stream->complete)
+	{
+		cgltf_size prefix_size = GlbHeaderSize + GlbChunkHeaderSize;
+		cgltf_size json_end = prefix_size + stream->json_size;
+		cgltf_size bin_begin = json_end + GlbChunkHeaderSize;
+		cgltf_size received = stream->received;
+		cgltf_size end;
+		uint8_t* target;
+
+		if (received < prefix_size)
 		{
-			cgltf_size v = ((unsigned char*)data)[i];
-			bound = bound > v ? bound : v;
+			end = prefix_size;
+			target = stream->header + received;
 		}
-		break;
-
-	case cgltf_component_type_r_16u:
-		for (size_t i = 0; i < count; ++i)
+		else if (received < json_end)
 		{
-			cgltf_size v = ((unsigned short*)data)[i];
-			bound = bound > v ? bound : v;
+			end = json_end;
+			target = stream->json_chunk + received;
 		}
-		break;
-
-	case cgltf_component_type_r_32u:
-		for (size_t i = 0; i < count; ++i)
+		else if (received < bin_begin && bin_begin <= stream->total_size)
 		{
-			cgltf_size v = ((unsigned int*)data)[i];
-			bound = bound > v ? bound : v;
+			end = bin_begin;
+			target = stream->header + (received - json_end);
+		}
+		else if (received < bin_begin + stream->bin_size && bin_begin <= stream->total_size)
+		{
+			end = bin_begin + stream->bin_size;
+			target = stream->bin ? stream->bin + (received - bin_begin) : NULL;
+		}
+		else
+		{
+			/* Padding and chunks that follow the BIN chunk are skipped */
+			end = stream->total_size;
+			target = NULL;
 		}
-		break;
-
-	default:
-		;
-	}
 
-	return bound;
-}
+		cgltf_size length = end - received < size ? end - received : size;
 
-cgltf_result cgltf_validate(cgltf_data* data)
-{
-	for (cgltf_size i = 0; i < data->accessors_count; ++i)
-	{
-		cgltf_accessor* accessor = &data->accessors[i];
+		if (target)
+		{
+			memcpy(target, ptr, length);
+		}
 
-		cgltf_size element_size = cgltf_calc_size(accessor->type, accessor->component_type);
+		ptr += length;
+		size -= length;
+		stream->received += length;
 
-		if (accessor->buffer_view)
+		if (received >= bin_begin && end == bin_begin + stream->bin_size && stream->bin)
 		{
-			cgltf_size req_size = accessor->offset + accessor->stride * (accessor->count - 1) + element_size;
-
-			if (accessor->buffer_view->size < req_size)
+			stream->bin_received = stream->received - bin_begin;
+			cgltf_stream_signal_buffer_views(stream);
+		}
+		else if (stream->received == end)
+		{
+			// The stream keeps the caller's options between calls, so allocations are only counted while advancing
+			cgltf_options caller_options = stream->options;
+			cgltf_stats_allocator counter;
+			cgltf_stats_count_allocations(&caller_options, &counter, &stream->options);
+			cgltf_result result = cgltf_stream_advance(stream);
+			stream->options = caller_options;
+			if (result != cgltf_result_success)
 			{
-				return cgltf_result_data_too_short;
+				stream->error = result;
+				return result;
 			}
 		}
 
-		if (accessor->is_sparse)
+		if (stream->data && stream->received >= stream->total_size)
 		{
-			cgltf_accessor_sparse* sparse = &accessor->sparse;
-
-			cgltf_size indices_component_size = cgltf_calc_size(cgltf_type_scalar, sparse->indices_component_type);
-			cgltf_size indices_req_size = sparse->indices_byte_offset + indices_component_size * sparse->count;
-			cgltf_size values_req_size = sparse->values_byte_offset + element_size * sparse->count;
-
-			if (sparse->indices_buffer_view->size < indices_req_size ||
-				sparse->values_buffer_view->size < values_req_size)
-			{
-				return cgltf_result_data_too_short;
-			}
+			stream->complete = 1;
+		}
+	}
 
-			if (sparse->indices_component_type != cgltf_component_type_r_8u &&
-				sparse->indices_component_type != cgltf_component_type_r_16u &&
-				sparse->indices_component_type != cgltf_component_type_r_32u)
-			{
-				return cgltf_result_invalid_gltf;
-			}
+	return cgltf_result_success;
+}
 
-			if (sparse->indices_buffer_view->buffer->data)
-			{
-				cgltf_size index_bound = cgltf_calc_index_bound(sparse->indices_buffer_view, sparse->indices_byte_offset, sparse->indices_component_type, sparse->count);
+void cgltf_stream_free(cgltf_stream* stream)
+{
+	stream->options.memory_free(stream->options.memory_user_data, stream->json_chunk);
+	stream->options.memory_free(stream->options.memory_user_data, stream->views);
+	stream->json_chunk = NULL;
+	stream->views = NULL;
+}
 
-				if (index_bound >= accessor->count)
-				{
-					return cgltf_result_data_too_short;
-				}
-			}
-		}
-	}
+static cgltf_result cgltf_read_file(const cgltf_options* options, const char* path, cgltf_size size, cgltf_size* out_size, void** out_data)
+{
+	void* (*memory_alloc)(void*, cgltf_size) = options->memory_alloc ? options->memory_alloc : &cgltf_default_alloc;
+	void (*memory_free)(void*, void*) = options->memory_free ? options->memory_free : &cgltf_default_free;
 
-	for (cgltf_size i = 0; i < data->buffer_views_count; ++i)
+	FILE* file = fopen(path, "rb");
+	if (!file)
 	{
-		cgltf_size req_size = data->buffer_views[i].offset + data->buffer_views[i].size;
-
-		if (data->buffer_views[i].buffer && data->buffer_views[i].buffer->size < req_size)
-		{
-			return cgltf_result_data_too_short;
-		}
+		return cgltf_result_file_not_found;
 	}
 
-	for (cgltf_size i = 0; i < data->meshes_count; ++i)
+	if (size == 0)
 	{
-		if (data->meshes[i].weights)
-		{
-			if (data->meshes[i].primitives_count && data->meshes[i].primitives[0].targets_count != data->meshes[i].weights_count)
-			{
-				return cgltf_result_invalid_gltf;
-			}
-		}
+		fseek(file, 0, SEEK_END);
 
-		for (cgltf_size j = 0; j < data->meshes[i].primitives_count; ++j)
+		long length = ftell(file);
+		if (length < 0)
 		{
-			if (data->meshes[i].primitives[j].targets_count != data->meshes[i].primitives[0].targets_count)
-			{
-				return cgltf_result_invalid_gltf;
-			}
-
-			if (data->meshes[i].primitives[j].attributes_count)
-			{
-				cgltf_accessor* first = data->meshes[i].primitives[j].attributes[0].data;
-
-				for (cgltf_size k = 0; k < data->meshes[i].primitives[j].attributes_count; ++k)
-				{
-					if (data->meshes[i].primitives[j].attributes[k].data->count != first->count)
-					{
-						return cgltf_result_invalid_gltf;
-					}
-				}
+			fclose(file);
+			return cgltf_result_io_error;
+		}
 
-				for (cgltf_size k = 0; k < data->meshes[i].primitives[j].targets_count; ++k)
-				{
-					for (cgltf_size m = 0; m < data->meshes[i].primitives[j].targets[k].attributes_count; ++m)
-					{
-						if (data->meshes[i].primitives[j].targets[k].attributes[m].data->count != first->count)
-						{
-							return cgltf_result_invalid_gltf;
-						}
-					}
-				}
+		fseek(file, 0, SEEK_SET);
 
-				cgltf_accessor* indices = data->meshes[i].primitives[j].indices;
+		size = (cgltf_size)length;
+	}
 
-				if (indices &&
-					indices->component_type != cgltf_component_type_r_8u &&
-					indices->component_type != cgltf_component_type_r_16u &&
-					indices->component_type != cgltf_component_type_r_32u)
-				{
-					return cgltf_result_invalid_gltf;
-				}
+	char* file_data = (char*)memory_alloc(options->memory_user_data, size);
+	if (!file_data)
+	{
+		fclose(file);
+		return cgltf_result_out_of_memory;
+	}
 
-				if (indices && indices->buffer_view && indices->buffer_view->buffer->data)
-				{
-					cgltf_size index_bound = cgltf_calc_index_bound(indices->buffer_view, indices->offset, indices->component_type, indices->count);
+	cgltf_size read_size = fread(file_data, 1, size, file);
 
-					if (index_bound >= first->count)
-					{
-						return cgltf_result_data_too_short;
-					}
-				}
-			}
-		}
-	}
+	fclose(file);
 
-	for (cgltf_size i = 0; i < data->nodes_count; ++i)
+	if (read_size != size)
 	{
-		if (data->nodes[i].weights && data->nodes[i].mesh)
-		{
-			if (data->nodes[i].mesh->primitives_count && data->nodes[i].mesh->primitives[0].targets_count != data->nodes[i].weights_count)
-			{
-				return cgltf_result_invalid_gltf;
-			}
-		}
+		memory_free(options->memory_user_data, file_data);
+		return cgltf_result_io_error;
 	}
 
+	*out_size = size;
+	*out_data = file_data;
+
 	return cgltf_result_success;
 }
 
-cgltf_result cgltf_copy_extras_json(const cgltf_data* data, const cgltf_extras* extras, char* dest, cgltf_size* dest_size)
+#if defined(CGLTF_FILE_MAPPING_WIN32) || defined(CGLTF_FILE_MAPPING_POSIX)
+static cgltf_result cgltf_map_file(const char* path, cgltf_size size, cgltf_size* out_size, void** out_data)
 {
-	cgltf_size json_size = extras->end_offset - extras->start_offset;
+#if defined(CGLTF_FILE_MAPPING_WIN32)
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return cgltf_result_file_not_found;
+	}
 
-	if (!dest)
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size) || (unsigned long long)file_size.QuadPart > SIZE_MAX)
 	{
-		if (dest_size)
-		{
-			*dest_size = json_size + 1;
-			return cgltf_result_success;
-		}
-		return cgltf_result_invalid_options;
+		CloseHandle(file);
+		return cgltf_result_io_error;
 	}
 
-	if (*dest_size + 1 < json_size)
+	cgltf_size length = (cgltf_size)file_size.QuadPart;
+#else
+	int file = open(path, O_RDONLY);
+	if (file < 0)
 	{
-		strncpy(dest, data->json + extras->start_offset, *dest_size - 1);
-		dest[*dest_size - 1] = 0;
+		return cgltf_result_file_not_found;
 	}
-	else
+
+	struct stat file_stat;
+	if (fstat(file, &file_stat) != 0 || file_stat.st_size < 0)
 	{
-		strncpy(dest, data->json + extras->start_offset, json_size);
-		dest[json_size] = 0;
+		close(file);
+		return cgltf_result_io_error;
 	}
 
-	return cgltf_result_success;
-}
+	cgltf_size length = (cgltf_size)file_stat.st_size;
+#endif
 
-void cgltf_free(cgltf_data* data)
-{
-	if (!data)
+	cgltf_result result = cgltf_result_success;
+
+	if (size == 0)
 	{
-		return;
+		size = length;
+		// An empty mapping cannot be created and there would be nothing to parse
+		result = size == 0 ? cgltf_result_data_too_short : cgltf_result_success;
+	}
+	else if (length < size)
+	{
+		result = cgltf_result_io_error;
 	}
 
-	data->memory_free(data->memory_user_data, data->asset.copyright);
-	data->memory_free(data->memory_user_data, data->asset.generator);
-	data->memory_free(data->memory_user_data, data->asset.version);
-	data->memory_free(data->memory_user_data, data->asset.min_version);
-
-	data->memory_free(data->memory_user_data, data->accessors);
-	data->memory_free(data->memory_user_data, data->buffer_views);
+	void* file_data = NULL;
 
-	for (cgltf_size i = 0; i < data->buffers_count; ++i)
+#if defined(CGLTF_FILE_MAPPING_WIN32)
+	if (result == cgltf_result_success)
 	{
-		if (data->buffers[i].data != data->bin)
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+		// The view keeps the mapping alive, so both handles can be closed right away
+		file_data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size) : NULL;
+
+		if (mapping)
 		{
-			data->memory_free(data->memory_user_data, data->buffers[i].data);
+			CloseHandle(mapping);
 		}
 
-		data->memory_free(data->memory_user_data, data->buffers[i].uri);
+		result = file_data ? cgltf_result_success : cgltf_result_io_error;
 	}
 
-	data->memory_free(data->memory_user_data, data->buffers);
+	CloseHandle(file);
+#else
+	if (result == cgltf_result_success)
+	{
+		file_data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
 
-	for (cgltf_size i = 0; i < data->meshes_count; ++i)
+		result = file_data != MAP_FAILED ? cgltf_result_success : cgltf_result_io_error;
+	}
+
+	close(file);
+#endif
+
+	if (result != cgltf_result_success)
 	{
-		data->memory_free(data->memory_user_data, data->meshes[i].name);
+		return result;
+	}
 
-		for (cgltf_size j = 0; j < data->meshes[i].primitives_count; ++j)
-		{
-			for (cgltf_size k = 0; k < data->meshes[i].primitives[j].attributes_count; ++k)
-			{
-				data->memory_free(data->memory_user_data, data->meshes[i].primitives[j].attributes[k].name);
-			}
+	*out_size = size;
+	*out_data = file_data;
 
-			data->memory_free(data->memory_user_data, data->meshes[i].primitives[j].attributes);
+	return cgltf_result_success;
+}
 
-			for (cgltf_size k = 0; k < data->meshes[i].primitives[j].targets_count; ++k)
-			{
-				for (cgltf_size m = 0; m < data->meshes[i].primitives[j].targets[k].attributes_count; ++m)
-				{
-					data->memory_free(data->memory_user_data, data->meshes[i].primitives[j].targets[k].attributes[m].name);
-				}
+static void cgltf_unmap_file(void* data, cgltf_size size)
+{
+#if defined(CGLTF_FILE_MAPPING_WIN32)
+	(void)size;
+	UnmapViewOfFile(data);
+#else
+	munmap(data, size);
+#endif
+}
+#endif
 
-				data->memory_free(data->memory_user_data, data->meshes[i].primitives[j].targets[k].attributes);
-			}
+static cgltf_result cgltf_read_or_map_file(const cgltf_options* options, const char* path, cgltf_size size, cgltf_size* out_size, void** out_data, cgltf_data_free_method* out_free_method)
+{
+	if (options->file_read)
+	{
+		cgltf_size file_size = size;
+		void* file_data = NULL;
 
-			data->memory_free(data->memory_user_data, data->meshes[i].primitives[j].targets);
+		cgltf_result result = options->file_read(options->file_user_data, path, &file_size, &file_data);
+		if (result != cgltf_result_success)
+		{
+			return result;
 		}
 
-		data->memory_free(data->memory_user_data, data->meshes[i].primitives);
-		data->memory_free(data->memory_user_data, data->meshes[i].weights);
-	}
+		if (file_size < size)
+		{
+			if (options->file_release)
+			{
+				options->file_release(options->file_user_data, file_data);
+			}
+			return cgltf_result_io_error;
+		}
 
-	data->memory_free(data->memory_user_data, data->meshes);
+		*out_size = file_size;
+		*out_data = file_data;
+		*out_free_method = cgltf_data_free_method_file_release;
+		return cgltf_result_success;
+	}
 
-	for (cgltf_size i = 0; i < data->materials_count; ++i)
+#if defined(CGLTF_FILE_MAPPING_WIN32) || defined(CGLTF_FILE_MAPPING_POSIX)
+	if (options->map_files)
 	{
-		data->memory_free(data->memory_user_data, data->materials[i].name);
+		*out_free_method = cgltf_data_free_method_unmap;
+		return cgltf_map_file(path, size, out_size, out_data);
 	}
+#endif
 
-	data->memory_free(data->memory_user_data, data->materials);
+	*out_free_method = cgltf_data_free_method_memory_free;
+	return cgltf_read_file(options, path, size, out_size, out_data);
+}
 
-	for (cgltf_size i = 0; i < data->images_count; ++i) 
-	{
-		data->memory_free(data->memory_user_data, data->images[i].name);
-		data->memory_free(data->memory_user_data, data->images[i].uri);
-		data->memory_free(data->memory_user_data, data->images[i].mime_type);
-	}
+static cgltf_result cgltf_load_file(const cgltf_options* options, const char* path, cgltf_size size, cgltf_size* out_size, void** out_data, cgltf_data_free_method* out_free_method)
+{
+	cgltf_stats* stats = options->stats;
+	double start = cgltf_stats_clock(stats);
 
-	data->memory_free(data->memory_user_data, data->images);
+	cgltf_result result = cgltf_read_or_map_file(options, path, size, out_size, out_data, out_free_method);
 
-	for (cgltf_size i = 0; i < data->textures_count; ++i)
+	if (stats)
 	{
-		data->memory_free(data->memory_user_data, data->textures[i].name);
+		stats->file_time += cgltf_stats_clock(stats) - start;
+		stats->files_count += result == cgltf_result_success;
+		stats->file_size += result == cgltf_result_success ? *out_size : 0;
 	}
 
-	data->memory_free(data->memory_user_data, data->textures);
+	return result;
+}
 
-	data->memory_free(data->memory_user_data, data->samplers);
+static void cgltf_free_file_data(void (*memory_free)(void*, void*), void* memory_user_data, void (*file_release)(void*, void*), void* file_user_data, void* data, cgltf_size size, cgltf_data_free_method free_method)
+{
+	if (!data)
+	{
+		return;
+	}
 
-	for (cgltf_size i = 0; i < data->skins_count; ++i)
+	if (free_method == cgltf_data_free_method_none)
 	{
-		data->memory_free(data->memory_user_data, data->skins[i].name);
-		data->memory_free(data->memory_user_data, data->skins[i].joints);
+		return;
 	}
 
-	data->memory_free(data->memory_user_data, data->skins);
+	if (free_method == cgltf_data_free_method_file_release)
+	{
+		if (file_release)
+		{
+			file_release(file_user_data, data);
+		}
+		return;
+	}
 
-	for (cgltf_size i = 0; i < data->cameras_count; ++i)
+#if defined(CGLTF_FILE_MAPPING_WIN32) || defined(CGLTF_FILE_MAPPING_POSIX)
+	if (free_method == cgltf_data_free_method_unmap)
 	{
-		data->memory_free(data->memory_user_data, data->cameras[i].name);
+		cgltf_unmap_file(data, size);
+		return;
 	}
+#else
+	(void)size;
+	(void)free_method;
+#endif
 
-	data->memory_free(data->memory_user_data, data->cameras);
+	memory_free(memory_user_data, data);
+}
 
-	for (cgltf_size i = 0; i < data->lights_count; ++i)
+cgltf_result cgltf_parse_file(const cgltf_options* options, const char* path, cgltf_data** out_data)
+{
+	if (options == NULL)
 	{
-		data->memory_free(data->memory_user_data, data->lights[i].name);
+		return cgltf_result_invalid_options;
 	}
 
-	data->memory_free(data->memory_user_data, data->lights);
-
-	for (cgltf_size i = 0; i < data->nodes_count; ++i)
+	cgltf_stats_allocator counter;
+	cgltf_options counted_options;
+	if (cgltf_stats_count_allocations(options, &counter, &counted_options))
 	{
-		data->memory_free(data->memory_user_data, data->nodes[i].name);
-		data->memory_free(data->memory_user_data, data->nodes[i].children);
-		data->memory_free(data->memory_user_data, data->nodes[i].weights);
+		return cgltf_parse_file(&counted_options, path, out_data);
 	}
 
-	data->memory_free(data->memory_user_data, data->nodes);
+	void (*memory_free)(void*, void*) = options->memory_free ? options->memory_free : &cgltf_default_free;
 
-	for (cgltf_size i = 0; i < data->scenes_count; ++i)
+	void* file_data = NULL;
+	cgltf_size file_size = 0;
+	cgltf_data_free_method free_method;
+
+	cgltf_result result = cgltf_load_file(options, path, 0, &file_size, &file_data, &free_method);
+
+	if (result != cgltf_result_success)
 	{
-		data->memory_free(data->memory_user_data, data->scenes[i].name);
-		data->memory_free(data->memory_user_data, data->scenes[i].nodes);
+		return result;
 	}
 
-	data->memory_free(data->memory_user_data, data->scenes);
+	result = cgltf_parse(options, file_data, file_size, out_data);
 
-	for (cgltf_size i = 0; i < data->animations_count; ++i)
+	if (result != cgltf_result_success)
 	{
-		data->memory_free(data->memory_user_data, data->animations[i].name);
-		data->memory_free(data->memory_user_data, data->animations[i].samplers);
-		data->memory_free(data->memory_user_data, data->animations[i].channels);
+		cgltf_free_file_data(memory_free, options->memory_user_data, options->file_release, options->file_user_data, file_data, file_size, free_method);
+		return result;
 	}
 
-	data->memory_free(data->memory_user_data, data->animations);
-
-	data->memory_free(data->memory_user_data, data->file_data);
+	(*out_data)->file_data = file_data;
+	(*out_data)->file_size = file_size;
+	(*out_data)->file_data_free_method = free_method;
 
-	data->memory_free(data->memory_user_data, data);
+	return cgltf_result_success;
 }
 
-void cgltf_node_transform_local(const cgltf_node* node, cgltf_float* out_matrix)
+static void cgltf_combine_paths(char* path, const char* base, const char* uri)
 {
-	cgltf_float* lm = out_matrix;
+	const char* s0 = strrchr(base, '/');
+	const char* s1 = strrchr(base, '\\');
+	const char* slash = s0 ? (s1 && s1 > s0 ? s1 : s0) : s1;
 
-	if (node->has_matrix)
+	if (slash)
 	{
-		memcpy(lm, node->matrix, sizeof(float) * 16);
+		size_t prefix = slash - base + 1;
+
+		strncpy(path, base, prefix);
+		strcpy(path + prefix, uri);
 	}
 	else
 	{
-		float tx = node->translation[0];
-		float ty = node->translation[1];
-		float tz = node->translation[2];
+		strcpy(path, uri);
+	}
+}
+
+static cgltf_result cgltf_load_buffer_file(const cgltf_options* options, cgltf_size size, const char* uri, const char* gltf_path, void** out_data, cgltf_data_free_method* out_free_method)
+{
+	void* (*memory_alloc)(void*, cgltf_size) = options->memory_alloc ? options->memory_alloc : &cgltf_default_alloc;
+	void (*memory_free)(void*, void*) = options->memory_free ? options->memory_free : &cgltf_default_free;
+
+	char* path = (char*)memory_alloc(options->memory_user_data, strlen(uri) + strlen(gltf_path) + 1);
+	if (!path)
+	{
+		return cgltf_result_out_of_memory;
+	}
+
+	cgltf_combine_paths(path, gltf_path, uri);
+
+	cgltf_size file_size = 0;
+	cgltf_result result = cgltf_load_file(options, path, size, &file_size, out_data, out_free_method);
 
-		float qx = node->rotation[0];
-		float qy = node->rotation[1];
-		float qz = node->rotation[2];
-		float qw = node->rotation[3];
+	memory_free(options->memory_user_data, path);
 
-		float sx = node->scale[0];
-		float sy = node->scale[1];
-		float sz = node->scale[2];
+	return result;
+}
 
-		lm[0] = (1 - 2 * qy*qy - 2 * qz*qz) * sx;
-		lm[1] = (2 * qx*qy + 2 * qz*qw) * sy;
-		lm[2] = (2 * qx*qz - 2 * qy*qw) * sz;
-		lm[3] = 0.f;
+/* Maps base64 characters to their 6-bit values; everything else maps to 255 */
+static const unsigned char cgltf_base64_table[256] = {
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 62, 255, 255, 255, 63,
+	52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 255, 255, 255, 255, 255, 255,
+	255, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+	15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 255, 255, 255, 255, 255,
+	255, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+	41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+};
 
-		lm[4] = (2 * qx*qy - 2 * qz*qw) * sx;
-		lm[5] = (1 - 2 * qx*qx - 2 * qz*qz) * sy;
-		lm[6] = (2 * qy*qz + 2 * qx*qw) * sz;
-		lm[7] = 0.f;
+#if defined(CGLTF_SIMD_SSSE3)
+/* Translates 16 characters to 6-bit values, or returns 0 if one of them is invalid */
+static int cgltf_base64_translate_ssse3(__m128i* chars)
+{
+	const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+	const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+	const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+	const __m128i mask_2f = _mm_set1_epi8(0x2f);
 
-		lm[8] = (2 * qx*qz + 2 * qy*qw) * sx;
-		lm[9] = (2 * qy*qz - 2 * qx*qw) * sy;
-		lm[10] = (1 - 2 * qx*qx - 2 * qy*qy) * sz;
-		lm[11] = 0.f;
+	/* Each character class is a bit in lut_hi, indexed by the high nibble; lut_lo has the bits of the classes
+	 * that do not contain the character, indexed by the low nibble */
+	__m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(*chars, 4), mask_2f);
+	__m128i lo_nibbles = _mm_and_si128(*chars, mask_2f);
+	__m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+	__m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
 
-		lm[12] = tx;
-		lm[13] = ty;
-		lm[14] = tz;
-		lm[15] = 1.f;
+	if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0)
+	{
+		return 0;
 	}
+
+	/* The offset to the 6-bit value only depends on the high nibble, except for '/' */
+	__m128i eq_2f = _mm_cmpeq_epi8(*chars, mask_2f);
+	*chars = _mm_add_epi8(*chars, _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2f, hi_nibbles)));
+	return 1;
 }
 
-void cgltf_node_transform_world(const cgltf_node* node, cgltf_float* out_matrix)
+/* Packs the 6-bit values of every 4 bytes into 3 bytes, leaving the 24 bits of each 32-bit lane in its low bytes */
+static __m128i cgltf_base64_pack_ssse3(__m128i values)
 {
-	cgltf_float* lm = out_matrix;
-	cgltf_node_transform_local(node, lm);
+	__m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+	return _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+}
+#endif
 
-	const cgltf_node* parent = node->parent;
+/* Decodes a prefix of the given groups of 4 characters into 3 bytes each and returns the number of groups decoded.
+ * The caller decodes the rest, which includes reporting invalid characters. */
+static cgltf_size cgltf_base64_decode_simd(const char* base64, cgltf_size groups, unsigned char* out)
+{
+	cgltf_size i = 0;
 
-	while (parent)
+#if defined(CGLTF_SIMD_AVX2)
+	const __m256i shuffle = _mm256_setr_epi8(
+		2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+		2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+	const __m256i permute = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+
+	const __m256i lut_lo = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a));
+	const __m256i lut_hi = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10));
+	const __m256i lut_roll = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+	const __m256i mask_2f = _mm256_set1_epi8(0x2f);
+
+	/* Same as cgltf_base64_translate_ssse3 and cgltf_base64_pack_ssse3, on 32 characters; every iteration stores 32 bytes, of which 24 are decoded */
+	for (; i + 11 <= groups; i += 8)
 	{
-		float pm[16];
-		cgltf_node_transform_local(parent, pm);
+		__m256i chars = _mm256_loadu_si256((const __m256i*)(base64 + i * 4));
+		__m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(chars, 4), mask_2f);
+		__m256i lo_nibbles = _mm256_and_si256(chars, mask_2f);
+		__m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+		__m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
 
-		for (int i = 0; i < 4; ++i)
+		if (_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256())) != 0)
 		{
-			float l0 = lm[i * 4 + 0];
-			float l1 = lm[i * 4 + 1];
-			float l2 = lm[i * 4 + 2];
+			break;
+		}
+
+		__m256i eq_2f = _mm256_cmpeq_epi8(chars, mask_2f);
+		__m256i values = _mm256_add_epi8(chars, _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_2f, hi_nibbles)));
+		__m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+		__m256i packed = _mm256_shuffle_epi8(_mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000)), shuffle);
+		_mm256_storeu_si256((__m256i*)(out + i * 3), _mm256_permutevar8x32_epi32(packed, permute));
+	}
+#endif
+
+#if defined(CGLTF_SIMD_SSSE3)
+	const __m128i shuffle_128 = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
 
-			float r0 = l0 * pm[0] + l1 * pm[4] + l2 * pm[8];
-			float r1 = l0 * pm[1] + l1 * pm[5] + l2 * pm[9];
-			float r2 = l0 * pm[2] + l1 * pm[6] + l2 * pm[10];
+	/* Every iteration stores 16 bytes, of which 12 are decoded */
+	for (; i + 6 <= groups; i += 4)
+	{
+		__m128i chars = _mm_loadu_si128((const __m128i*)(base64 + i * 4));
 
-			lm[i * 4 + 0] = r0;
-			lm[i * 4 + 1] = r1;
-			lm[i * 4 + 2] = r2;
+		if (!cgltf_base64_translate_ssse3(&chars))
+		{
+			break;
 		}
 
-		lm[12] += pm[12];
-		lm[13] += pm[13];
-		lm[14] += pm[14];
+		_mm_storeu_si128((__m128i*)(out + i * 3), _mm_shuffle_epi8(cgltf_base64_pack_ssse3(chars), shuffle_128));
+	}
+#elif defined(CGLTF_SIMD_NEON)
+	for (; i + 16 <= groups; i += 16)
+	{
+		uint8x16x4_t chars = vld4q_u8((const uint8_t*)base64 + i * 4);
+		uint8x16_t invalid = vdupq_n_u8(0);
 
-		parent = parent->parent;
+		for (int j = 0; j < 4; ++j)
+		{
+			uint8x16_t c = chars.val[j];
+			uint8x16_t upper = vsubq_u8(c, vdupq_n_u8('A'));
+			uint8x16_t lower = vsubq_u8(c, vdupq_n_u8('a' - 26));
+			uint8x16_t digit = vaddq_u8(c, vdupq_n_u8(52 - '0'));
+			uint8x16_t value = vdupq_n_u8(255);
+			value = vbslq_u8(vceqq_u8(c, vdupq_n_u8('+')), vdupq_n_u8(62), value);
+			value = vbslq_u8(vceqq_u8(c, vdupq_n_u8('/')), vdupq_n_u8(63), value);
+			value = vbslq_u8(vcltq_u8(vsubq_u8(c, vdupq_n_u8('0')), vdupq_n_u8(10)), digit, value);
+			value = vbslq_u8(vcltq_u8(vsubq_u8(c, vdupq_n_u8('a')), vdupq_n_u8(26)), lower, value);
+			value = vbslq_u8(vcltq_u8(upper, vdupq_n_u8(26)), upper, value);
+			invalid = vorrq_u8(invalid, value);
+			chars.val[j] = value;
+		}
+
+		if (vmaxvq_u8(invalid) > 63)
+		{
+			break;
+		}
+
+		uint8x16x3_t bytes;
+		bytes.val[0] = vorrq_u8(vshlq_n_u8(chars.val[0], 2), vshrq_n_u8(chars.val[1], 4));
+		bytes.val[1] = vorrq_u8(vshlq_n_u8(chars.val[1], 4), vshrq_n_u8(chars.val[2], 2));
+		bytes.val[2] = vorrq_u8(vshlq_n_u8(chars.val[2], 6), chars.val[3]);
+		vst3q_u8(out + i * 3, bytes);
 	}
+#else
+	(void)base64;
+	(void)groups;
+	(void)out;
+#endif
+
+	return i;
 }
 
-static cgltf_size cgltf_component_read_index(const void* in, cgltf_component_type component_type)
+cgltf_result cgltf_load_buffer_base64(const cgltf_options* options, cgltf_size size, const char* base64, void** out_data)
 {
-	switch (component_type)
+	cgltf_stats_allocator counter;
+	cgltf_options counted_options;
+	if (cgltf_stats_count_allocations(options, &counter, &counted_options))
 	{
-		case cgltf_component_type_r_16:
-			return *((const int16_t*) in);
-		case cgltf_component_type_r_16u:
-			return *((const uint16_t*) in);
-		case cgltf_component_type_r_32u:
-			return *((const uint32_t*) in);
-		case cgltf_component_type_r_32f:
-			return (cgltf_size)*((const float*) in);
-		case cgltf_component_type_r_8:
-			return *((const int8_t*) in);
-		case cgltf_component_type_r_8u:
-		case cgltf_component_type_invalid:
-		default:
-			return *((const uint8_t*) in);
+		return cgltf_load_buffer_base64(&counted_options, size, base64, out_data);
 	}
-}
 
-static cgltf_float cgltf_component_read_float(const void* in, cgltf_component_type component_type, cgltf_bool normalized)
-{
-	if (component_type == cgltf_component_type_r_32f)
+	void* (*memory_alloc)(void*, cgltf_size) = options->memory_alloc ? options->memory_alloc : &cgltf_default_alloc;
+	void (*memory_free)(void*, void*) = options->memory_free ? options->memory_free : &cgltf_default_free;
+
+	unsigned char* data = (unsigned char*)memory_alloc(options->memory_user_data, size);
+	if (!data)
 	{
-		return *((const float*) in);
+		return cgltf_result_out_of_memory;
 	}
 
-	if (normalized)
+	// Whole groups of 4 characters are decoded at once, but only as far as the string is known to reach
+	cgltf_size chars = (size * 4 + 2) / 3;
+	const char* terminator = (const char*)memchr(base64, 0, chars);
+	cgltf_size groups = (terminator ? (cgltf_size)(terminator - base64) : chars) / 4;
+
+	for (cgltf_size i = cgltf_base64_decode_simd(base64, groups, data); i < groups; ++i)
 	{
-		switch (component_type)
+		const unsigned char* ch = (const unsigned char*)base64 + i * 4;
+		unsigned int a = cgltf_base64_table[ch[0]];
+		unsigned int b = cgltf_base64_table[ch[1]];
+		unsigned int c = cgltf_base64_table[ch[2]];
+		unsigned int d = cgltf_base64_table[ch[3]];
+
+		if ((a | b | c | d) > 63)
 		{
-			case cgltf_component_type_r_32u:
-				return *((const uint32_t*) in) / (float) UINT_MAX;
-			case cgltf_component_type_r_16:
-				return *((const int16_t*) in) / (float) SHRT_MAX;
-			case cgltf_component_type_r_16u:
-				return *((const uint16_t*) in) / (float) USHRT_MAX;
-			case cgltf_component_type_r_8:
-				return *((const int8_t*) in) / (float) SCHAR_MAX;
-			case cgltf_component_type_r_8u:
-			case cgltf_component_type_invalid:
-			default:
-				return *((const uint8_t*) in) / (float) CHAR_MAX;
+			memory_free(options->memory_user_data, data);
+			return cgltf_result_io_error;
 		}
+
+		unsigned int bits = (a << 18) | (b << 12) | (c << 6) | d;
+		data[i * 3 + 0] = (unsigned char)(bits >> 16);
+		data[i * 3 + 1] = (unsigned char)(bits >> 8);
+		data[i * 3 + 2] = (unsigned char)bits;
 	}
 
-	return (cgltf_float)cgltf_component_read_index(in, component_type);
-}
+	base64 += groups * 4;
 
-static cgltf_size cgltf_num_components(cgltf_type type);
-static cgltf_size cgltf_component_size(cgltf_component_type component_type);
+	unsigned int buffer = 0;
+	unsigned int buffer_bits = 0;
 
-static cgltf_bool cgltf_element_read_float(const uint8_t* element, cgltf_type type, cgltf_component_type component_type, cgltf_bool normalized, cgltf_float* out, cgltf_size element_size)
-{
-	cgltf_size num_components = cgltf_num_components(type);
+	for (cgltf_size i = groups * 3; i < size; ++i)
+	{
+		while (buffer_bits < 8)
+		{
+			unsigned int index = cgltf_base64_table[(unsigned char)*base64++];
 
-	if (element_size < num_components) {
-		return 0;
+			if (index > 63)
+			{
+				memory_free(options->memory_user_data, data);
+				return cgltf_result_io_error;
+			}
+
+			buffer = (buffer << 6) | index;
+			buffer_bits += 6;
+		}
+
+		data[i] = (unsigned char)(buffer >> (buffer_bits - 8));
+		buffer_bits -= 8;
 	}
 
-	// There are three special cases for component extraction, see #data-alignment in the 2.0 spec.
+	*out_data = data;
 
-	cgltf_size component_size = cgltf_component_size(component_type);
+	return cgltf_result_success;
+}
 
-	if (type == cgltf_type_mat2 && component_size == 1)
+cgltf_result cgltf_load_buffer(const cgltf_options* options, cgltf_data* data, cgltf_size index, const char* gltf_path)
+{
+	if (options == NULL || index >= data->buffers_count)
 	{
-		out[0] = cgltf_component_read_float(element, component_type, normalized);
-		out[1] = cgltf_component_read_float(element + 1, component_type, normalized);
-		out[2] = cgltf_component_read_float(element + 4, component_type, normalized);
-		out[3] = cgltf_component_read_float(element + 5, component_type, normalized);
-		return 1;
+		return cgltf_result_invalid_options;
 	}
 
-	if (type == cgltf_type_mat3 && component_size == 1)
+	cgltf_stats_allocator counter;
+	cgltf_options counted_options;
+	if (cgltf_stats_count_allocations(options, &counter, &counted_options))
 	{
-		out[0] = cgltf_component_read_float(element, component_type, normalized);
-		out[1] = cgltf_component_read_float(element + 1, component_type, normalized);
-		out[2] = cgltf_component_read_float(element + 2, component_type, normalized);
-		out[3] = cgltf_component_read_float(element + 4, component_type, normalized);
-		out[4] = cgltf_component_read_float(element + 5, component_type, normalized);
-		out[5] = cgltf_component_read_float(element + 6, component_type, normalized);
-		out[6] = cgltf_component_read_float(element + 8, component_type, normalized);
-		out[7] = cgltf_component_read_float(element + 9, component_type, normalized);
-		out[8] = cgltf_component_read_float(element + 10, component_type, normalized);
-		return 1;
+		return cgltf_load_buffer(&counted_options, data, index, gltf_path);
 	}
 
-	if (type == cgltf_type_mat3 && component_size == 2)
+	cgltf_buffer* buffer = &data->buffers[index];
+
+	if (buffer->data)
 	{
-		out[0] = cgltf_component_read_float(element, component_type, normalized);
-		out[1] = cgltf_component_read_float(element + 2, component_type, normalized);
-		out[2] = cgltf_component_read_float(element + 4, component_type, normalized);
-		out[3] = cgltf_component_read_float(element + 8, component_type, normalized);
-		out[4] = cgltf_component_read_float(element + 10, component_type, normalized);
-		out[5] = cgltf_component_read_float(element + 12, component_type, normalized);
-		out[6] = cgltf_component_read_float(element + 16, component_type, normalized);
-		out[7] = cgltf_component_read_float(element + 18, component_type, normalized);
-		out[8] = cgltf_component_read_float(element + 20, component_type, normalized);
-		return 1;
+		return cgltf_result_success;
 	}
 
-	for (cgltf_size i = 0; i < num_components; ++i)
+	const char* uri = buffer->uri;
+
+	if (uri == NULL)
 	{
-		out[i] = cgltf_component_read_float(element + component_size * i, component_type, normalized);
+		if (index == 0 && data->bin)
+		{
+			if (data->bin_size < buffer->size)
+			{
+				return cgltf_result_data_too_short;
+			}
+
+			buffer->data = (void*)data->bin;
+		}
+
+		return cgltf_result_success;
 	}
-	return 1;
-}
 
+	if (strncmp(uri, "data:", 5) == 0)
+	{
+		const char* comma = strchr(uri, ',');
 
-cgltf_bool cgltf_accessor_read_float(const cgltf_accessor* accessor, cgltf_size index, cgltf_float* out, cgltf_size element_size)
-{
-	if (accessor->is_sparse || accessor->buffer_view == NULL)
+		if (comma && comma - uri >= 7 && strncmp(comma - 7, ";base64", 7) == 0)
+		{
+			cgltf_stats* stats = options->stats;
+			double start = cgltf_stats_clock(stats);
+
+			buffer->data_free_method = cgltf_data_free_method_memory_free;
+			cgltf_result result = cgltf_load_buffer_base64(options, buffer->size, comma + 1, &buffer->data);
+
+			if (stats)
+			{
+				stats->base64_time += cgltf_stats_clock(stats) - start;
+				stats->base64_size += result == cgltf_result_success ? buffer->size : 0;
+			}
+
+			return result;
+		}
+		else
+		{
+			return cgltf_result_unknown_format;
+		}
+	}
+	else if (strstr(uri, "://") == NULL)
 	{
-		return 0;
+		return cgltf_load_buffer_file(options, buffer->size, uri, gltf_path, &buffer->data, &buffer->data_free_method);
+	}
+	else
+	{
+		return cgltf_result_unknown_format;
 	}
-
-	cgltf_size offset = accessor->offset + accessor->buffer_view->offset;
-	const uint8_t* element = (const uint8_t*) accessor->buffer_view->buffer->data;
-	element += offset + accessor->stride * index;
-	return cgltf_element_read_float(element, accessor->type, accessor->component_type, accessor->normalized, out, element_size);
 }
 
-cgltf_size cgltf_accessor_read_index(const cgltf_accessor* accessor, cgltf_size index)
+cgltf_result cgltf_load_buffers(const cgltf_options* options, cgltf_data* data, const char* gltf_path)
 {
-	if (accessor->buffer_view)
+	if (options == NULL)
 	{
-		cgltf_size offset = accessor->offset + accessor->buffer_view->offset;
-		const uint8_t* element = (const uint8_t*) accessor->buffer_view->buffer->data;
-		element += offset + accessor->stride * index;
-		return cgltf_component_read_index(element, accessor->component_type);
+		return cgltf_result_invalid_options;
 	}
 
-	return 0;
-}
+	// Buffers that were already loaded through cgltf_load_buffer are skipped, so the first
+	// failure in buffer order is reported no matter in which order the others completed
+	for (cgltf_size i = 0; i < data->buffers_count; ++i)
+	{
+		cgltf_result res = cgltf_load_buffer(options, data, i, gltf_path);
 
-#define CGLTF_ERROR_JSON -1
-#define CGLTF_ERROR_NOMEM -2
+		if (res != cgltf_result_success)
+		{
+			return res;
+		}
+	}
 
-#define CGLTF_CHECK_TOKTYPE(tok_, type_) if ((tok_).type != (type_)) { return CGLTF_ERROR_JSON; }
-#define CGLTF_CHECK_KEY(tok_) if ((tok_).type != JSMN_STRING || (tok_).size == 0) { return CGLTF_ERROR_JSON; } /* checking size for 0 verifies that a value follows the key */
+	return cgltf_result_success;
+}
 
-#define CGLTF_PTRINDEX(type, idx) (type*)(cgltf_size)(idx + 1)
-#define CGLTF_PTRFIXUP(var, data, size) if (var) { if ((cgltf_size)var > size) { return CGLTF_ERROR_JSON; } var = &data[(cgltf_size)var-1]; }
-#define CGLTF_PTRFIXUP_REQ(var, data, size) if (!var || (cgltf_size)var > size) { return CGLTF_ERROR_JSON; } var = &data[(cgltf_size)var-1];
+#ifndef CGLTF_PARALLEL_BATCH_SIZE
+/* Number of consecutive elements that one parallel_for task works on */
+#define CGLTF_PARALLEL_BATCH_SIZE 256
+#endif
 
-static int cgltf_json_strcmp(jsmntok_t const* tok, const uint8_t* json_chunk, const char* str)
+typedef struct cgltf_parallel_job
 {
-	CGLTF_CHECK_TOKTYPE(*tok, JSMN_STRING);
-	size_t const str_len = strlen(str);
-	size_t const name_length = tok->end - tok->start;
-	return (str_len == name_length) ? strncmp((const char*)json_chunk + tok->start, str, str_len) : 128;
+	int (*run)(void* user, cgltf_size index);
+	void* user;
+	cgltf_size count;
+	int* results;
+} cgltf_parallel_job;
+
+static void cgltf_parallel_batch(void* user, cgltf_size batch)
+{
+	cgltf_parallel_job* job = (cgltf_parallel_job*)user;
+	cgltf_size end = (batch + 1) * CGLTF_PARALLEL_BATCH_SIZE;
+	end = end < job->count ? end : job->count;
+
+	int result = 0;
+	for (cgltf_size i = batch * CGLTF_PARALLEL_BATCH_SIZE; i < end && result >= 0; ++i)
+	{
+		result = job->run(job->user, i);
+	}
+	job->results[batch] = result < 0 ? result : 0;
 }
 
-static int cgltf_json_to_int(jsmntok_t const* tok, const uint8_t* json_chunk)
+/* Arena allocation is not thread-safe, and small arrays are not worth the tasks */
+static cgltf_bool cgltf_parallel_enabled(const cgltf_options* options, cgltf_size count)
 {
-	CGLTF_CHECK_TOKTYPE(*tok, JSMN_PRIMITIVE);
-	char tmp[128];
-	int size = (cgltf_size)(tok->end - tok->start) < sizeof(tmp) ? tok->end - tok->start : sizeof(tmp) - 1;
-	strncpy(tmp, (const char*)json_chunk + tok->start, size);
-	tmp[size] = 0;
-	return atoi(tmp);
+	return options->parallel_for && !options->arena_allocation && count >= 2 * CGLTF_PARALLEL_BATCH_SIZE;
 }
 
-static cgltf_float cgltf_json_to_float(jsmntok_t const* tok, const uint8_t* json_chunk)
+/* Calls run for every index, in batches through parallel_for if it is enabled, and returns the first negative result in
+ * index order, so that errors do not depend on scheduling */
+static int cgltf_run_elements(const cgltf_options* options, cgltf_size count, int (*run)(void* user, cgltf_size index), void* user)
 {
-	CGLTF_CHECK_TOKTYPE(*tok, JSMN_PRIMITIVE);
-	char tmp[128];
-	int size = (cgltf_size)(tok->end - tok->start) < sizeof(tmp) ? tok->end - tok->start : sizeof(tmp) - 1;
-	strncpy(tmp, (const char*)json_chunk + tok->start, size);
-	tmp[size] = 0;
-	return (cgltf_float)atof(tmp);
-}
-
-static cgltf_bool cgltf_json_to_bool(jsmntok_t const* tok, const uint8_t* json_chunk)
-{
-	int size = tok->end - tok->start;
-	return size == 4 && memcmp(json_chunk + tok->start, "true", 4) == 0;
-}
-
-static int cgltf_skip_json(jsmntok_t const* tokens, int i)
-{
-	if (tokens[i].type == JSMN_ARRAY)
+	if (!cgltf_parallel_enabled(options, count))
 	{
-		int size = tokens[i].size;
-		++i;
-		for (int j = 0; j < size; ++j)
+		for (cgltf_size i = 0; i < count; ++i)
 		{
-			i = cgltf_skip_json(tokens, i);
-			if (i < 0)
+			int result = run(user, i);
+			if (result < 0)
 			{
-				return i;
+				return result;
 			}
 		}
+		return 0;
 	}
-	else if (tokens[i].type == JSMN_OBJECT)
+
+	cgltf_size batches = (count + CGLTF_PARALLEL_BATCH_SIZE - 1) / CGLTF_PARALLEL_BATCH_SIZE;
+	int* results = (int*)options->memory_alloc(options->memory_user_data, batches * sizeof(int));
+	if (!results)
 	{
-		int size = tokens[i].size;
-		++i;
-		for (int j = 0; j < size; ++j)
-		{
-			CGLTF_CHECK_KEY(tokens[i]);
-			++i;
-			i = cgltf_skip_json(tokens, i);
-			if (i < 0)
-			{
-				return i;
-			}
-		}
+		// Without memory for the results, the elements are still processed, just serially
+		cgltf_options serial_options = *options;
+		serial_options.parallel_for = NULL;
+		return cgltf_run_elements(&serial_options, count, run, user);
 	}
-	else if (tokens[i].type == JSMN_PRIMITIVE
-		 || tokens[i].type == JSMN_STRING)
+
+	cgltf_parallel_job job;
+	job.run = run;
+	job.user = user;
+	job.count = count;
+	job.results = results;
+	options->parallel_for(options->parallel_user_data, batches, &cgltf_parallel_batch, &job);
+
+	int result = 0;
+	for (cgltf_size i = 0; i < batches && result == 0; ++i)
 	{
-		return i + 1;
+		result = results[i];
 	}
-	return i;
+	options->memory_free(options->memory_user_data, results);
+	return result;
 }
 
-static void cgltf_fill_float_array(float* out_array, int size, float value)
+static cgltf_size cgltf_calc_size(cgltf_type type, cgltf_component_type component_type);
+
+/* Reduces a prefix of count tightly packed indices to their maximum and returns the length of the prefix; the caller
+ * handles the rest. The data does not need to be aligned. */
+static cgltf_size cgltf_index_bound_simd(const uint8_t* data, cgltf_component_type component_type, cgltf_size count, cgltf_size* out_bound)
 {
-	for (int j = 0; j < size; ++j)
+	cgltf_size i = 0;
+	cgltf_size bound = 0;
+
+#if defined(CGLTF_SIMD_AVX2)
+	__m256i m = _mm256_setzero_si256();
+
+	switch (component_type)
 	{
-		out_array[j] = value;
+	case cgltf_component_type_r_8u:
+		for (; i + 32 <= count; i += 32)
+		{
+			m = _mm256_max_epu8(m, _mm256_loadu_si256((const __m256i*)(data + i)));
+		}
+		break;
+
+	case cgltf_component_type_r_16u:
+		for (; i + 16 <= count; i += 16)
+		{
+			m = _mm256_max_epu16(m, _mm256_loadu_si256((const __m256i*)(data + i * 2)));
+		}
+		break;
+
+	case cgltf_component_type_r_32u:
+		for (; i + 8 <= count; i += 8)
+		{
+			m = _mm256_max_epu32(m, _mm256_loadu_si256((const __m256i*)(data + i * 4)));
+		}
+		break;
+
+	default:
+		return 0;
 	}
-}
 
-static int cgltf_parse_json_float_array(jsmntok_t const* tokens, int i, const uint8_t* json_chunk, float* out_array, int size)
-{
-	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_ARRAY);
-	if (tokens[i].size != size)
+	uint8_t lanes[32];
+	_mm256_storeu_si256((__m256i*)lanes, m);
+#elif defined(CGLTF_SIMD_SSE2)
+	/* SSE2 only compares signed 16 and 32-bit lanes, so those are biased into the signed range and back */
+	__m128i m = _mm_setzero_si128();
+
+	switch (component_type)
 	{
-		return CGLTF_ERROR_JSON;
+	case cgltf_component_type_r_8u:
+		for (; i + 16 <= count; i += 16)
+		{
+			m = _mm_max_epu8(m, _mm_loadu_si128((const __m128i*)(data + i)));
+		}
+		break;
+
+	case cgltf_component_type_r_16u:
+	{
+		const __m128i bias = _mm_set1_epi16((short)0x8000);
+		m = bias;
+		for (; i + 8 <= count; i += 8)
+		{
+			m = _mm_max_epi16(m, _mm_xor_si128(_mm_loadu_si128((const __m128i*)(data + i * 2)), bias));
+		}
+		m = _mm_xor_si128(m, bias);
+		break;
 	}
-	++i;
-	for (int j = 0; j < size; ++j)
+
+	case cgltf_component_type_r_32u:
 	{
-		CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_PRIMITIVE);
-		out_array[j] = cgltf_json_to_float(tokens + i, json_chunk);
-		++i;
+		const __m128i bias = _mm_set1_epi32((int)0x80000000u);
+		m = bias;
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(data + i * 4)), bias);
+			__m128i greater = _mm_cmpgt_epi32(v, m);
+			m = _mm_or_si128(_mm_and_si128(greater, v), _mm_andnot_si128(greater, m));
+		}
+		m = _mm_xor_si128(m, bias);
+		break;
 	}
-	return i;
-}
 
-static int cgltf_parse_json_string(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, char** out_string)
-{
-	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_STRING);
-	if (*out_string)
+	default:
+		return 0;
+	}
+
+	uint8_t lanes[16];
+	_mm_storeu_si128((__m128i*)lanes, m);
+#elif defined(CGLTF_SIMD_NEON)
+	uint8_t lanes[16];
+
+	switch (component_type)
 	{
-		return CGLTF_ERROR_JSON;
+	case cgltf_component_type_r_8u:
+	{
+		uint8x16_t m = vdupq_n_u8(0);
+		for (; i + 16 <= count; i += 16)
+		{
+			m = vmaxq_u8(m, vld1q_u8(data + i));
+		}
+		vst1q_u8(lanes, m);
+		break;
 	}
-	int size = tokens[i].end - tokens[i].start;
-	char* result = (char*)options->memory_alloc(options->memory_user_data, size + 1);
-	if (!result)
+
+	case cgltf_component_type_r_16u:
 	{
-		return CGLTF_ERROR_NOMEM;
+		uint16x8_t m = vdupq_n_u16(0);
+		for (; i + 8 <= count; i += 8)
+		{
+			m = vmaxq_u16(m, vreinterpretq_u16_u8(vld1q_u8(data + i * 2)));
+		}
+		vst1q_u8(lanes, vreinterpretq_u8_u16(m));
+		break;
 	}
-	strncpy(result, (const char*)json_chunk + tokens[i].start, size);
-	result[size] = 0;
-	*out_string = result;
-	return i + 1;
-}
 
-static int cgltf_parse_json_array(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, size_t element_size, void** out_array, cgltf_size* out_size)
-{
-	(void)json_chunk;
-	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_ARRAY);
-	if (*out_array)
+	case cgltf_component_type_r_32u:
 	{
-		return CGLTF_ERROR_JSON;
+		uint32x4_t m = vdupq_n_u32(0);
+		for (; i + 4 <= count; i += 4)
+		{
+			m = vmaxq_u32(m, vreinterpretq_u32_u8(vld1q_u8(data + i * 4)));
+		}
+		vst1q_u8(lanes, vreinterpretq_u8_u32(m));
+		break;
 	}
-	int size = tokens[i].size;
-	void* result = cgltf_calloc(options, element_size, size);
-	if (!result)
+
+	default:
+		return 0;
+	}
+#else
+	(void)data;
+	(void)component_type;
+	(void)count;
+	uint8_t lanes[1] = {0};
+#endif
+
+	cgltf_size lane_size = component_type == cgltf_component_type_r_32u ? 4 : component_type == cgltf_component_type_r_16u ? 2 : 1;
+	for (cgltf_size j = 0; j + lane_size <= sizeof(lanes); j += lane_size)
 	{
-		return CGLTF_ERROR_NOMEM;
+		cgltf_size v;
+		if (lane_size == 4)
+		{
+			uint32_t lane;
+			memcpy(&lane, lanes + j, 4);
+			v = lane;
+		}
+		else if (lane_size == 2)
+		{
+			uint16_t lane;
+			memcpy(&lane, lanes + j, 2);
+			v = lane;
+		}
+		else
+		{
+			v = lanes[j];
+		}
+		bound = bound > v ? bound : v;
 	}
-	*out_array = result;
-	*out_size = size;
-	return i + 1;
+
+	*out_bound = bound;
+	return i;
 }
 
-static int cgltf_parse_json_string_array(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, char*** out_array, cgltf_size* out_size)
+static cgltf_size cgltf_calc_index_bound(cgltf_buffer_view* buffer_view, cgltf_size offset, cgltf_component_type component_type, cgltf_size count)
 {
-    CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_ARRAY);
-    i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(char*), (void**)out_array, out_size);
+	char* data = (char*)buffer_view->buffer->data + offset + buffer_view->offset;
+	cgltf_size bound = 0;
+	cgltf_size i = cgltf_index_bound_simd((const uint8_t*)data, component_type, count, &bound);
 
-    for (cgltf_size j = 0; j < *out_size; ++j)
-    {
-        i = cgltf_parse_json_string(options, tokens, i, json_chunk, j + (*out_array));
-        if (i < 0)
-        {
-            return i;
-        }
-    }
-    return i;
+	switch (component_type)
+	{
+	case cgltf_component_type_r_8u:
+		for (; i < count; ++i)
+		{
+			cgltf_size v = ((unsigned char*)data)[i];
+			bound = bound > v ? bound : v;
+		}
+		break;
+
+	case cgltf_component_type_r_16u:
+		for (; i < count; ++i)
+		{
+			cgltf_size v = ((unsigned short*)data)[i];
+			bound = bound > v ? bound : v;
+		}
+		break;
+
+	case cgltf_component_type_r_32u:
+		for (; i < count; ++i)
+		{
+			cgltf_size v = ((unsigned int*)data)[i];
+			bound = bound > v ? bound : v;
+		}
+		break;
+
+	default:
+		;
+	}
+
+	return bound;
 }
 
-static void cgltf_parse_attribute_type(const char* name, cgltf_attribute_type* out_type, int* out_index)
+static cgltf_bool cgltf_buffer_view_in_bounds(const cgltf_buffer_view* buffer_view)
 {
-	const char* us = strchr(name, '_');
-	size_t len = us ? us - name : strlen(name);
+	return !buffer_view->buffer || buffer_view->buffer->size >= buffer_view->offset + buffer_view->size;
+}
 
-	if (len == 8 && strncmp(name, "POSITION", 8) == 0)
+cgltf_result cgltf_validate_accessor(const cgltf_accessor* accessor)
+{
+	cgltf_size element_size = cgltf_calc_size(accessor->type, accessor->component_type);
+
+	if (accessor->buffer_view)
 	{
-		*out_type = cgltf_attribute_type_position;
+		cgltf_size req_size = accessor->offset + accessor->stride * (accessor->count - 1) + element_size;
+
+		if (accessor->buffer_view->size < req_size || !cgltf_buffer_view_in_bounds(accessor->buffer_view))
+		{
+			return cgltf_result_data_too_short;
+		}
 	}
-	else if (len == 6 && strncmp(name, "NORMAL", 6) == 0)
+
+	if (accessor->is_sparse)
 	{
-		*out_type = cgltf_attribute_type_normal;
+		const cgltf_accessor_sparse* sparse = &accessor->sparse;
+
+		cgltf_size indices_component_size = cgltf_calc_size(cgltf_type_scalar, sparse->indices_component_type);
+		cgltf_size indices_req_size = sparse->indices_byte_offset + indices_component_size * sparse->count;
+		cgltf_size values_req_size = sparse->values_byte_offset + element_size * sparse->count;
+
+		if (sparse->indices_buffer_view->size < indices_req_size ||
+			sparse->values_buffer_view->size < values_req_size ||
+			!cgltf_buffer_view_in_bounds(sparse->indices_buffer_view) ||
+			!cgltf_buffer_view_in_bounds(sparse->values_buffer_view))
+		{
+			return cgltf_result_data_too_short;
+		}
+
+		if (sparse->indices_component_type != cgltf_component_type_r_8u &&
+			sparse->indices_component_type != cgltf_component_type_r_16u &&
+			sparse->indices_component_type != cgltf_component_type_r_32u)
+		{
+			return cgltf_result_invalid_gltf;
+		}
+
+		if (sparse->indices_buffer_view->buffer->data)
+		{
+			cgltf_size index_bound = cgltf_calc_index_bound(sparse->indices_buffer_view, sparse->indices_byte_offset, sparse->indices_component_type, sparse->count);
+
+			if (index_bound >= accessor->count)
+			{
+				return cgltf_result_data_too_short;
+			}
+		}
 	}
-	else if (len == 7 && strncmp(name, "TANGENT", 7) == 0)
+
+	return cgltf_result_success;
+}
+
+cgltf_result cgltf_validate_primitive(const cgltf_primitive* primitive)
+{
+	if (!primitive->attributes_count)
 	{
-		*out_type = cgltf_attribute_type_tangent;
+		return cgltf_result_success;
 	}
-	else if (len == 8 && strncmp(name, "TEXCOORD", 8) == 0)
+
+	cgltf_accessor* first = primitive->attributes[0].data;
+
+	for (cgltf_size k = 0; k < primitive->attributes_count; ++k)
 	{
-		*out_type = cgltf_attribute_type_texcoord;
+		if (primitive->attributes[k].data->count != first->count)
+		{
+			return cgltf_result_invalid_gltf;
+		}
 	}
-	else if (len == 5 && strncmp(name, "COLOR", 5) == 0)
+
+	for (cgltf_size k = 0; k < primitive->targets_count; ++k)
 	{
-		*out_type = cgltf_attribute_type_color;
+		for (cgltf_size m = 0; m < primitive->targets[k].attributes_count; ++m)
+		{
+			if (primitive->targets[k].attributes[m].data->count != first->count)
+			{
+				return cgltf_result_invalid_gltf;
+			}
+		}
 	}
-	else if (len == 6 && strncmp(name, "JOINTS", 6) == 0)
+
+	cgltf_accessor* indices = primitive->indices;
+
+	if (indices &&
+		indices->component_type != cgltf_component_type_r_8u &&
+		indices->component_type != cgltf_component_type_r_16u &&
+		indices->component_type != cgltf_component_type_r_32u)
 	{
-		*out_type = cgltf_attribute_type_joints;
+		return cgltf_result_invalid_gltf;
 	}
-	else if (len == 7 && strncmp(name, "WEIGHTS", 7) == 0)
+
+	if (indices && indices->buffer_view && indices->buffer_view->buffer->data)
 	{
-		*out_type = cgltf_attribute_type_weights;
+		cgltf_size index_bound = cgltf_calc_index_bound(indices->buffer_view, indices->offset, indices->component_type, indices->count);
+
+		if (index_bound >= first->count)
+		{
+			return cgltf_result_data_too_short;
+		}
+	}
+
+	return cgltf_result_success;
+}
+
+cgltf_result cgltf_validate_mesh(const cgltf_mesh* mesh)
+{
+	if (mesh->weights)
+	{
+		if (mesh->primitives_count && mesh->primitives[0].targets_count != mesh->weights_count)
+		{
+			return cgltf_result_invalid_gltf;
+		}
+	}
+
+	for (cgltf_size j = 0; j < mesh->primitives_count; ++j)
+	{
+		if (mesh->primitives[j].targets_count != mesh->primitives[0].targets_count)
+		{
+			return cgltf_result_invalid_gltf;
+		}
+
+		cgltf_result result = cgltf_validate_primitive(&mesh->primitives[j]);
+
+		if (result != cgltf_result_success)
+		{
+			return result;
+		}
+	}
+
+	return cgltf_result_success;
+}
+
+/* Validation results are passed through cgltf_run_elements as negative numbers */
+static int cgltf_validate_accessor_task(void* user, cgltf_size index)
+{
+	return -(int)cgltf_validate_accessor(&((cgltf_data*)user)->accessors[index]);
+}
+
+static int cgltf_validate_mesh_task(void* user, cgltf_size index)
+{
+	return -(int)cgltf_validate_mesh(&((cgltf_data*)user)->meshes[index]);
+}
+
+static cgltf_result cgltf_validate_elements(const cgltf_options* options, cgltf_data* data)
+{
+	cgltf_options fixed_options = *options;
+	if (fixed_options.memory_alloc == NULL)
+	{
+		fixed_options.memory_alloc = &cgltf_default_alloc;
+	}
+	if (fixed_options.memory_free == NULL)
+	{
+		fixed_options.memory_free = &cgltf_default_free;
+	}
+	fixed_options.arena_allocation = 0;
+
+	int result = cgltf_run_elements(&fixed_options, data->accessors_count, &cgltf_validate_accessor_task, data);
+
+	if (result < 0)
+	{
+		return (cgltf_result)-result;
+	}
+
+	for (cgltf_size i = 0; i < data->buffer_views_count; ++i)
+	{
+		if (!cgltf_buffer_view_in_bounds(&data->buffer_views[i]))
+		{
+			return cgltf_result_data_too_short;
+		}
+	}
+
+	result = cgltf_run_elements(&fixed_options, data->meshes_count, &cgltf_validate_mesh_task, data);
+
+	if (result < 0)
+	{
+		return (cgltf_result)-result;
+	}
+
+	for (cgltf_size i = 0; i < data->nodes_count; ++i)
+	{
+		if (data->nodes[i].weights && data->nodes[i].mesh)
+		{
+			if (data->nodes[i].mesh->primitives_count && data->nodes[i].mesh->primitives[0].targets_count != data->nodes[i].weights_count)
+			{
+				return cgltf_result_invalid_gltf;
+			}
+		}
+	}
+
+	return cgltf_result_success;
+}
+
+cgltf_result cgltf_validate_parallel(const cgltf_options* options, cgltf_data* data)
+{
+	cgltf_stats_allocator counter;
+	cgltf_options counted_options;
+	if (cgltf_stats_count_allocations(options, &counter, &counted_options))
+	{
+		return cgltf_validate_parallel(&counted_options, data);
+	}
+
+	double start = cgltf_stats_clock(options->stats);
+
+	cgltf_result result = cgltf_validate_elements(options, data);
+
+	if (options->stats)
+	{
+		options->stats->validate_time += cgltf_stats_clock(options->stats) - start;
+	}
+
+	return result;
+}
+
+cgltf_result cgltf_validate(cgltf_data* data)
+{
+	cgltf_options options;
+	memset(&options, 0, sizeof(options));
+	return cgltf_validate_parallel(&options, data);
+}
+
+cgltf_result cgltf_copy_extras_json(const cgltf_data* data, const cgltf_extras* extras, char* dest, cgltf_size* dest_size)
+{
+	cgltf_size json_size = extras->end_offset - extras->start_offset;
+
+	if (!dest)
+	{
+		if (dest_size)
+		{
+			*dest_size = json_size + 1;
+			return cgltf_result_success;
+		}
+		return cgltf_result_invalid_options;
+	}
+
+	if (*dest_size + 1 < json_size)
+	{
+		strncpy(dest, data->json + extras->start_offset, *dest_size - 1);
+		dest[*dest_size - 1] = 0;
 	}
 	else
 	{
-		*out_type = cgltf_attribute_type_invalid;
+		strncpy(dest, data->json + extras->start_offset, json_size);
+		dest[json_size] = 0;
+	}
+
+	return cgltf_result_success;
+}
+
+static void cgltf_free_string(cgltf_data* data, char* string)
+{
+	// Strings parsed in place point into the JSON copy and are released with it
+	if (data->json_copy && string >= data->json_copy && string < data->json_copy + data->json_size)
+	{
+		return;
+	}
+
+	data->memory_free(data->memory_user_data, string);
+}
+
+static void cgltf_free_objects(cgltf_data* data)
+{
+	cgltf_free_string(data, data->asset.copyright);
+	cgltf_free_string(data, data->asset.generator);
+	cgltf_free_string(data, data->asset.version);
+	cgltf_free_string(data, data->asset.min_version);
+
+	data->memory_free(data->memory_user_data, data->accessors);
+	data->memory_free(data->memory_user_data, data->buffer_views);
+
+	for (cgltf_size i = 0; i < data->buffers_count; ++i)
+	{
+		cgltf_free_string(data, data->buffers[i].uri);
+	}
+
+	data->memory_free(data->memory_user_data, data->buffers);
+
+	for (cgltf_size i = 0; i < data->meshes_count; ++i)
+	{
+		cgltf_free_string(data, data->meshes[i].name);
+
+		for (cgltf_size j = 0; j < data->meshes[i].primitives_count; ++j)
+		{
+			for (cgltf_size k = 0; k < data->meshes[i].primitives[j].attributes_count; ++k)
+			{
+				cgltf_free_string(data, data->meshes[i].primitives[j].attributes[k].name);
+			}
+
+			data->memory_free(data->memory_user_data, data->meshes[i].primitives[j].attributes);
+
+			for (cgltf_size k = 0; k < data->meshes[i].primitives[j].targets_count; ++k)
+			{
+				for (cgltf_size m = 0; m < data->meshes[i].primitives[j].targets[k].attributes_count; ++m)
+				{
+					cgltf_free_string(data, data->meshes[i].primitives[j].targets[k].attributes[m].name);
+				}
+
+				data->memory_free(data->memory_user_data, data->meshes[i].primitives[j].targets[k].attributes);
+			}
+
+			data->memory_free(data->memory_user_data, data->meshes[i].primitives[j].targets);
+		}
+
+		data->memory_free(data->memory_user_data, data->meshes[i].primitives);
+		data->memory_free(data->memory_user_data, data->meshes[i].weights);
+	}
+
+	data->memory_free(data->memory_user_data, data->meshes);
+
+	for (cgltf_size i = 0; i < data->materials_count; ++i)
+	{
+		cgltf_free_string(data, data->materials[i].name);
+	}
+
+	data->memory_free(data->memory_user_data, data->materials);
+
+	for (cgltf_size i = 0; i < data->images_count; ++i) 
+	{
+		cgltf_free_string(data, data->images[i].name);
+		cgltf_free_string(data, data->images[i].uri);
+		cgltf_free_string(data, data->images[i].mime_type);
+	}
+
+	data->memory_free(data->memory_user_data, data->images);
+
+	for (cgltf_size i = 0; i < data->textures_count; ++i)
+	{
+		cgltf_free_string(data, data->textures[i].name);
+	}
+
+	data->memory_free(data->memory_user_data, data->textures);
+
+	data->memory_free(data->memory_user_data, data->samplers);
+
+	for (cgltf_size i = 0; i < data->skins_count; ++i)
+	{
+		cgltf_free_string(data, data->skins[i].name);
+		data->memory_free(data->memory_user_data, data->skins[i].joints);
+	}
+
+	data->memory_free(data->memory_user_data, data->skins);
+
+	for (cgltf_size i = 0; i < data->cameras_count; ++i)
+	{
+		cgltf_free_string(data, data->cameras[i].name);
+	}
+
+	data->memory_free(data->memory_user_data, data->cameras);
+
+	for (cgltf_size i = 0; i < data->lights_count; ++i)
+	{
+		cgltf_free_string(data, data->lights[i].name);
+	}
+
+	data->memory_free(data->memory_user_data, data->lights);
+
+	for (cgltf_size i = 0; i < data->nodes_count; ++i)
+	{
+		cgltf_free_string(data, data->nodes[i].name);
+		data->memory_free(data->memory_user_data, data->nodes[i].children);
+		data->memory_free(data->memory_user_data, data->nodes[i].weights);
+	}
+
+	data->memory_free(data->memory_user_data, data->nodes);
+
+	for (cgltf_size i = 0; i < data->scenes_count; ++i)
+	{
+		cgltf_free_string(data, data->scenes[i].name);
+		data->memory_free(data->memory_user_data, data->scenes[i].nodes);
+	}
+
+	data->memory_free(data->memory_user_data, data->scenes);
+
+	for (cgltf_size i = 0; i < data->animations_count; ++i)
+	{
+		cgltf_free_string(data, data->animations[i].name);
+		data->memory_free(data->memory_user_data, data->animations[i].samplers);
+		data->memory_free(data->memory_user_data, data->animations[i].channels);
+	}
+
+	data->memory_free(data->memory_user_data, data->animations);
+
+	for (cgltf_size i = 0; i < data->extensions_used_count; ++i)
+	{
+		cgltf_free_string(data, data->extensions_used[i]);
+	}
+
+	data->memory_free(data->memory_user_data, data->extensions_used);
+
+	for (cgltf_size i = 0; i < data->extensions_required_count; ++i)
+	{
+		cgltf_free_string(data, data->extensions_required[i]);
+	}
+
+	data->memory_free(data->memory_user_data, data->extensions_required);
+}
+
+void cgltf_free(cgltf_data* data)
+{
+	if (!data)
+	{
+		return;
+	}
+
+	const uint8_t* cache_begin = data->cached ? (const uint8_t*)data->file_data : NULL;
+	const uint8_t* cache_end = cache_begin ? cache_begin + data->file_size : NULL;
+
+	for (cgltf_size i = 0; i < data->buffers_count; ++i)
+	{
+		const uint8_t* buffer_data = (const uint8_t*)data->buffers[i].data;
+
+		if (buffer_data != data->bin && !(buffer_data >= cache_begin && buffer_data < cache_end))
+		{
+			cgltf_free_file_data(data->memory_free, data->memory_user_data, data->file_release, data->file_user_data, data->buffers[i].data, data->buffers[i].size, data->buffers[i].data_free_method);
+		}
 	}
 
-	if (us && *out_type != cgltf_attribute_type_invalid)
-	{
-		*out_index = atoi(us + 1);
+	if (data->cached)
+	{
+		/* The data itself lives in the cache */
+		cgltf_free_file_data(data->memory_free, data->memory_user_data, data->file_release, data->file_user_data, data->file_data, data->file_size, data->file_data_free_method);
+		return;
+	}
+
+	if (data->arena)
+	{
+		cgltf_arena_destroy(data->arena);
+	}
+	else
+	{
+		cgltf_free_objects(data);
+		data->memory_free(data->memory_user_data, data->json_copy);
+	}
+
+	cgltf_free_file_data(data->memory_free, data->memory_user_data, data->file_release, data->file_user_data, data->file_data, data->file_size, data->file_data_free_method);
+
+	data->memory_free(data->memory_user_data, data);
+}
+
+#define CGLTF_CACHE_MAGIC 0x48434743 /* "CGCH" */
+#define CGLTF_CACHE_VERSION 1
+
+typedef struct cgltf_cache_header
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t layout;
+	uint32_t reserved;
+	cgltf_size size;
+	cgltf_size relocations_offset;
+	cgltf_size relocations_count;
+} cgltf_cache_header;
+
+/* Changes with the size of pointers and objects, so that caches written by other builds are rejected */
+static uint32_t cgltf_cache_layout(void)
+{
+	return (uint32_t)(sizeof(void*) + sizeof(cgltf_size) * 3 + sizeof(cgltf_data) * 5 + sizeof(cgltf_buffer) * 7 +
+		sizeof(cgltf_buffer_view) * 11 + sizeof(cgltf_accessor) * 13 + sizeof(cgltf_attribute) * 17 + sizeof(cgltf_image) * 19 +
+		sizeof(cgltf_sampler) * 23 + sizeof(cgltf_texture) * 29 + sizeof(cgltf_texture_view) * 31 + sizeof(cgltf_material) * 37 +
+		sizeof(cgltf_morph_target) * 41 + sizeof(cgltf_primitive) * 43 + sizeof(cgltf_mesh) * 47 + sizeof(cgltf_skin) * 53 +
+		sizeof(cgltf_camera) * 59 + sizeof(cgltf_light) * 61 + sizeof(cgltf_node) * 67 + sizeof(cgltf_scene) * 71 +
+		sizeof(cgltf_animation_sampler) * 73 + sizeof(cgltf_animation_channel) * 79 + sizeof(cgltf_animation) * 83);
+}
+
+/* Lays out the cache when out is NULL, and writes it in a second pass with the same offsets */
+typedef struct cgltf_cache_writer
+{
+	uint8_t* out;
+	cgltf_size size;
+	cgltf_size relocations_offset;
+	cgltf_size relocations_count;
+
+	const cgltf_data* data;
+	cgltf_size accessors;
+	cgltf_size buffer_views;
+	cgltf_size buffers;
+	cgltf_size images;
+	cgltf_size textures;
+	cgltf_size samplers;
+	cgltf_size materials;
+	cgltf_size meshes;
+	cgltf_size skins;
+	cgltf_size cameras;
+	cgltf_size lights;
+	cgltf_size nodes;
+	cgltf_size scenes;
+} cgltf_cache_writer;
+
+static cgltf_size cgltf_cache_alloc(cgltf_cache_writer* writer, const void* source, cgltf_size size)
+{
+	if (!source)
+	{
+		return 0;
+	}
+
+	cgltf_size offset = (writer->size + 7) & ~(cgltf_size)7;
+	writer->size = offset + size;
+
+	if (writer->out && size)
+	{
+		memcpy(writer->out + offset, source, size);
+	}
+
+	return offset;
+}
+
+/* Stores the offset of target in the pointer at slot, 0 for NULL, and records the slot for relocation */
+static void cgltf_cache_set(cgltf_cache_writer* writer, cgltf_size slot, cgltf_size target)
+{
+	if (writer->out)
+	{
+		memcpy(writer->out + slot, &target, sizeof(target));
+
+		if (target)
+		{
+			memcpy(writer->out + writer->relocations_offset + writer->relocations_count * sizeof(cgltf_size), &slot, sizeof(slot));
+		}
+	}
+
+	writer->relocations_count += target != 0;
+}
+
+static void cgltf_cache_clear(cgltf_cache_writer* writer, cgltf_size slot, cgltf_size size)
+{
+	if (writer->out)
+	{
+		memset(writer->out + slot, 0, size);
+	}
+}
+
+static cgltf_size cgltf_cache_array(cgltf_cache_writer* writer, cgltf_size slot, const void* array, cgltf_size size)
+{
+	cgltf_size offset = cgltf_cache_alloc(writer, array, size);
+	cgltf_cache_set(writer, slot, offset);
+	return offset;
+}
+
+static void cgltf_cache_string(cgltf_cache_writer* writer, cgltf_size slot, const char* string)
+{
+	cgltf_cache_set(writer, slot, cgltf_cache_alloc(writer, string, string ? strlen(string) + 1 : 0));
+}
+
+/* References point into arrays that have already been laid out at array_offset */
+static void cgltf_cache_ref(cgltf_cache_writer* writer, cgltf_size slot, const void* pointer, const void* array, cgltf_size array_offset)
+{
+	cgltf_cache_set(writer, slot, pointer ? array_offset + (cgltf_size)((const char*)pointer - (const char*)array) : 0);
+}
+
+#define CGLTF_CACHE_SLOT(offset_, type_, field_) ((offset_) + offsetof(type_, field_))
+
+static void cgltf_cache_attributes(cgltf_cache_writer* writer, cgltf_size slot, const cgltf_attribute* attributes, cgltf_size count)
+{
+	cgltf_size offset = cgltf_cache_array(writer, slot, attributes, count * sizeof(cgltf_attribute));
+
+	for (cgltf_size i = 0; i < count; ++i)
+	{
+		cgltf_size attribute = offset + i * sizeof(cgltf_attribute);
+		cgltf_cache_string(writer, CGLTF_CACHE_SLOT(attribute, cgltf_attribute, name), attributes[i].name);
+		cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(attribute, cgltf_attribute, data), attributes[i].data, writer->data->accessors, writer->accessors);
+	}
+}
+
+static void cgltf_cache_nodes(cgltf_cache_writer* writer, cgltf_size slot, cgltf_node* const* nodes, cgltf_size count)
+{
+	cgltf_size offset = cgltf_cache_array(writer, slot, nodes, count * sizeof(cgltf_node*));
+
+	for (cgltf_size i = 0; i < count; ++i)
+	{
+		cgltf_cache_ref(writer, offset + i * sizeof(cgltf_node*), nodes[i], writer->data->nodes, writer->nodes);
+	}
+}
+
+static void cgltf_cache_texture_view(cgltf_cache_writer* writer, cgltf_size offset, const cgltf_texture_view* view)
+{
+	cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(offset, cgltf_texture_view, texture), view->texture, writer->data->textures, writer->textures);
+}
+
+static void cgltf_cache_write(cgltf_cache_writer* writer, const cgltf_data* data)
+{
+	cgltf_cache_header header;
+	memset(&header, 0, sizeof(header));
+	cgltf_cache_alloc(writer, &header, sizeof(header));
+
+	cgltf_size d = cgltf_cache_alloc(writer, data, sizeof(cgltf_data));
+
+	/* All arrays that can be referenced come first, so that their offsets are known */
+	writer->data = data;
+	writer->accessors = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(d, cgltf_data, accessors), data->accessors, data->accessors_count * sizeof(cgltf_accessor));
+	writer->buffer_views = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(d, cgltf_data, buffer_views), data->buffer_views, data->buffer_views_count * sizeof(cgltf_buffer_view));
+	writer->buffers = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(d, cgltf_data, buffers), data->buffers, data->buffers_count * sizeof(cgltf_buffer));
+	writer->images = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(d, cgltf_data, images), data->images, data->images_count * sizeof(cgltf_image));
+	writer->textures = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(d, cgltf_data, textures), data->textures, data->textures_count * sizeof(cgltf_texture));
+	writer->samplers = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(d, cgltf_data, samplers), data->samplers, data->samplers_count * sizeof(cgltf_sampler));
+	writer->materials = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(d, cgltf_data, materials), data->materials, data->materials_count * sizeof(cgltf_material));
+	writer->meshes = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(d, cgltf_data, meshes), data->meshes, data->meshes_count * sizeof(cgltf_mesh));
+	writer->skins = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(d, cgltf_data, skins), data->skins, data->skins_count * sizeof(cgltf_skin));
+	writer->cameras = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(d, cgltf_data, cameras), data->cameras, data->cameras_count * sizeof(cgltf_camera));
+	writer->lights = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(d, cgltf_data, lights), data->lights, data->lights_count * sizeof(cgltf_light));
+	writer->nodes = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(d, cgltf_data, nodes), data->nodes, data->nodes_count * sizeof(cgltf_node));
+	writer->scenes = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(d, cgltf_data, scenes), data->scenes, data->scenes_count * sizeof(cgltf_scene));
+
+	cgltf_cache_string(writer, CGLTF_CACHE_SLOT(d, cgltf_data, asset.copyright), data->asset.copyright);
+	cgltf_cache_string(writer, CGLTF_CACHE_SLOT(d, cgltf_data, asset.generator), data->asset.generator);
+	cgltf_cache_string(writer, CGLTF_CACHE_SLOT(d, cgltf_data, asset.version), data->asset.version);
+	cgltf_cache_string(writer, CGLTF_CACHE_SLOT(d, cgltf_data, asset.min_version), data->asset.min_version);
+	cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(d, cgltf_data, scene), data->scene, data->scenes, writer->scenes);
+
+	/* The JSON is kept for cgltf_copy_extras_json, and the BIN chunk and loaded buffers are kept as they are */
+	cgltf_cache_array(writer, CGLTF_CACHE_SLOT(d, cgltf_data, json), data->json, data->json_size);
+	cgltf_size bin = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(d, cgltf_data, bin), data->bin, data->bin_size);
+
+	cgltf_size extensions = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(d, cgltf_data, extensions_used), data->extensions_used, data->extensions_used_count * sizeof(char*));
+	for (cgltf_size i = 0; i < data->extensions_used_count; ++i)
+	{
+		cgltf_cache_string(writer, extensions + i * sizeof(char*), data->extensions_used[i]);
+	}
+
+	extensions = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(d, cgltf_data, extensions_required), data->extensions_required, data->extensions_required_count * sizeof(char*));
+	for (cgltf_size i = 0; i < data->extensions_required_count; ++i)
+	{
+		cgltf_cache_string(writer, extensions + i * sizeof(char*), data->extensions_required[i]);
+	}
+
+	/* Ownership and callbacks belong to the process that loads the cache */
+	cgltf_cache_clear(writer, CGLTF_CACHE_SLOT(d, cgltf_data, file_data), sizeof(data->file_data));
+	cgltf_cache_clear(writer, CGLTF_CACHE_SLOT(d, cgltf_data, memory_free), sizeof(data->memory_free));
+	cgltf_cache_clear(writer, CGLTF_CACHE_SLOT(d, cgltf_data, memory_user_data), sizeof(data->memory_user_data));
+	cgltf_cache_clear(writer, CGLTF_CACHE_SLOT(d, cgltf_data, file_release), sizeof(data->file_release));
+	cgltf_cache_clear(writer, CGLTF_CACHE_SLOT(d, cgltf_data, file_user_data), sizeof(data->file_user_data));
+	cgltf_cache_clear(writer, CGLTF_CACHE_SLOT(d, cgltf_data, arena), sizeof(data->arena));
+	cgltf_cache_clear(writer, CGLTF_CACHE_SLOT(d, cgltf_data, json_copy), sizeof(data->json_copy));
+
+	for (cgltf_size i = 0; i < data->accessors_count; ++i)
+	{
+		const cgltf_accessor* accessor = &data->accessors[i];
+		cgltf_size a = writer->accessors + i * sizeof(cgltf_accessor);
+		cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(a, cgltf_accessor, buffer_view), accessor->buffer_view, data->buffer_views, writer->buffer_views);
+		cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(a, cgltf_accessor, sparse.indices_buffer_view), accessor->sparse.indices_buffer_view, data->buffer_views, writer->buffer_views);
+		cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(a, cgltf_accessor, sparse.values_buffer_view), accessor->sparse.values_buffer_view, data->buffer_views, writer->buffer_views);
+	}
+
+	for (cgltf_size i = 0; i < data->buffer_views_count; ++i)
+	{
+		cgltf_size v = writer->buffer_views + i * sizeof(cgltf_buffer_view);
+		cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(v, cgltf_buffer_view, buffer), data->buffer_views[i].buffer, data->buffers, writer->buffers);
+	}
+
+	for (cgltf_size i = 0; i < data->buffers_count; ++i)
+	{
+		const cgltf_buffer* buffer = &data->buffers[i];
+		cgltf_size b = writer->buffers + i * sizeof(cgltf_buffer);
+		cgltf_cache_string(writer, CGLTF_CACHE_SLOT(b, cgltf_buffer, uri), buffer->uri);
+
+		if (buffer->data && buffer->data == data->bin)
+		{
+			cgltf_cache_set(writer, CGLTF_CACHE_SLOT(b, cgltf_buffer, data), bin);
+		}
+		else
+		{
+			cgltf_cache_array(writer, CGLTF_CACHE_SLOT(b, cgltf_buffer, data), buffer->data, buffer->size);
+		}
+	}
+
+	for (cgltf_size i = 0; i < data->images_count; ++i)
+	{
+		const cgltf_image* image = &data->images[i];
+		cgltf_size m = writer->images + i * sizeof(cgltf_image);
+		cgltf_cache_string(writer, CGLTF_CACHE_SLOT(m, cgltf_image, name), image->name);
+		cgltf_cache_string(writer, CGLTF_CACHE_SLOT(m, cgltf_image, uri), image->uri);
+		cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(m, cgltf_image, buffer_view), image->buffer_view, data->buffer_views, writer->buffer_views);
+		cgltf_cache_string(writer, CGLTF_CACHE_SLOT(m, cgltf_image, mime_type), image->mime_type);
+	}
+
+	for (cgltf_size i = 0; i < data->textures_count; ++i)
+	{
+		const cgltf_texture* texture = &data->textures[i];
+		cgltf_size t = writer->textures + i * sizeof(cgltf_texture);
+		cgltf_cache_string(writer, CGLTF_CACHE_SLOT(t, cgltf_texture, name), texture->name);
+		cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(t, cgltf_texture, image), texture->image, data->images, writer->images);
+		cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(t, cgltf_texture, sampler), texture->sampler, data->samplers, writer->samplers);
+	}
+
+	for (cgltf_size i = 0; i < data->materials_count; ++i)
+	{
+		const cgltf_material* material = &data->materials[i];
+		cgltf_size m = writer->materials + i * sizeof(cgltf_material);
+		cgltf_cache_string(writer, CGLTF_CACHE_SLOT(m, cgltf_material, name), material->name);
+		cgltf_cache_texture_view(writer, CGLTF_CACHE_SLOT(m, cgltf_material, pbr_metallic_roughness.base_color_texture), &material->pbr_metallic_roughness.base_color_texture);
+		cgltf_cache_texture_view(writer, CGLTF_CACHE_SLOT(m, cgltf_material, pbr_metallic_roughness.metallic_roughness_texture), &material->pbr_metallic_roughness.metallic_roughness_texture);
+		cgltf_cache_texture_view(writer, CGLTF_CACHE_SLOT(m, cgltf_material, pbr_specular_glossiness.diffuse_texture), &material->pbr_specular_glossiness.diffuse_texture);
+		cgltf_cache_texture_view(writer, CGLTF_CACHE_SLOT(m, cgltf_material, pbr_specular_glossiness.specular_glossiness_texture), &material->pbr_specular_glossiness.specular_glossiness_texture);
+		cgltf_cache_texture_view(writer, CGLTF_CACHE_SLOT(m, cgltf_material, normal_texture), &material->normal_texture);
+		cgltf_cache_texture_view(writer, CGLTF_CACHE_SLOT(m, cgltf_material, occlusion_texture), &material->occlusion_texture);
+		cgltf_cache_texture_view(writer, CGLTF_CACHE_SLOT(m, cgltf_material, emissive_texture), &material->emissive_texture);
+	}
+
+	for (cgltf_size i = 0; i < data->meshes_count; ++i)
+	{
+		const cgltf_mesh* mesh = &data->meshes[i];
+		cgltf_size m = writer->meshes + i * sizeof(cgltf_mesh);
+		cgltf_cache_string(writer, CGLTF_CACHE_SLOT(m, cgltf_mesh, name), mesh->name);
+		cgltf_cache_array(writer, CGLTF_CACHE_SLOT(m, cgltf_mesh, weights), mesh->weights, mesh->weights_count * sizeof(cgltf_float));
+
+		cgltf_size primitives = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(m, cgltf_mesh, primitives), mesh->primitives, mesh->primitives_count * sizeof(cgltf_primitive));
+
+		for (cgltf_size j = 0; j < mesh->primitives_count; ++j)
+		{
+			const cgltf_primitive* primitive = &mesh->primitives[j];
+			cgltf_size p = primitives + j * sizeof(cgltf_primitive);
+			cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(p, cgltf_primitive, indices), primitive->indices, data->accessors, writer->accessors);
+			cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(p, cgltf_primitive, material), primitive->material, data->materials, writer->materials);
+			cgltf_cache_attributes(writer, CGLTF_CACHE_SLOT(p, cgltf_primitive, attributes), primitive->attributes, primitive->attributes_count);
+
+			cgltf_size targets = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(p, cgltf_primitive, targets), primitive->targets, primitive->targets_count * sizeof(cgltf_morph_target));
+
+			for (cgltf_size k = 0; k < primitive->targets_count; ++k)
+			{
+				cgltf_size t = targets + k * sizeof(cgltf_morph_target);
+				cgltf_cache_attributes(writer, CGLTF_CACHE_SLOT(t, cgltf_morph_target, attributes), primitive->targets[k].attributes, primitive->targets[k].attributes_count);
+			}
+		}
+	}
+
+	for (cgltf_size i = 0; i < data->skins_count; ++i)
+	{
+		const cgltf_skin* skin = &data->skins[i];
+		cgltf_size s = writer->skins + i * sizeof(cgltf_skin);
+		cgltf_cache_string(writer, CGLTF_CACHE_SLOT(s, cgltf_skin, name), skin->name);
+		cgltf_cache_nodes(writer, CGLTF_CACHE_SLOT(s, cgltf_skin, joints), skin->joints, skin->joints_count);
+		cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(s, cgltf_skin, skeleton), skin->skeleton, data->nodes, writer->nodes);
+		cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(s, cgltf_skin, inverse_bind_matrices), skin->inverse_bind_matrices, data->accessors, writer->accessors);
+	}
+
+	for (cgltf_size i = 0; i < data->cameras_count; ++i)
+	{
+		cgltf_cache_string(writer, CGLTF_CACHE_SLOT(writer->cameras + i * sizeof(cgltf_camera), cgltf_camera, name), data->cameras[i].name);
+	}
+
+	for (cgltf_size i = 0; i < data->lights_count; ++i)
+	{
+		cgltf_cache_string(writer, CGLTF_CACHE_SLOT(writer->lights + i * sizeof(cgltf_light), cgltf_light, name), data->lights[i].name);
+	}
+
+	for (cgltf_size i = 0; i < data->nodes_count; ++i)
+	{
+		const cgltf_node* node = &data->nodes[i];
+		cgltf_size n = writer->nodes + i * sizeof(cgltf_node);
+		cgltf_cache_string(writer, CGLTF_CACHE_SLOT(n, cgltf_node, name), node->name);
+		cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(n, cgltf_node, parent), node->parent, data->nodes, writer->nodes);
+		cgltf_cache_nodes(writer, CGLTF_CACHE_SLOT(n, cgltf_node, children), node->children, node->children_count);
+		cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(n, cgltf_node, skin), node->skin, data->skins, writer->skins);
+		cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(n, cgltf_node, mesh), node->mesh, data->meshes, writer->meshes);
+		cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(n, cgltf_node, camera), node->camera, data->cameras, writer->cameras);
+		cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(n, cgltf_node, light), node->light, data->lights, writer->lights);
+		cgltf_cache_array(writer, CGLTF_CACHE_SLOT(n, cgltf_node, weights), node->weights, node->weights_count * sizeof(cgltf_float));
+	}
+
+	for (cgltf_size i = 0; i < data->scenes_count; ++i)
+	{
+		cgltf_size s = writer->scenes + i * sizeof(cgltf_scene);
+		cgltf_cache_string(writer, CGLTF_CACHE_SLOT(s, cgltf_scene, name), data->scenes[i].name);
+		cgltf_cache_nodes(writer, CGLTF_CACHE_SLOT(s, cgltf_scene, nodes), data->scenes[i].nodes, data->scenes[i].nodes_count);
+	}
+
+	cgltf_size animations = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(d, cgltf_data, animations), data->animations, data->animations_count * sizeof(cgltf_animation));
+
+	for (cgltf_size i = 0; i < data->animations_count; ++i)
+	{
+		const cgltf_animation* animation = &data->animations[i];
+		cgltf_size a = animations + i * sizeof(cgltf_animation);
+		cgltf_cache_string(writer, CGLTF_CACHE_SLOT(a, cgltf_animation, name), animation->name);
+
+		cgltf_size samplers = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(a, cgltf_animation, samplers), animation->samplers, animation->samplers_count * sizeof(cgltf_animation_sampler));
+
+		for (cgltf_size j = 0; j < animation->samplers_count; ++j)
+		{
+			cgltf_size s = samplers + j * sizeof(cgltf_animation_sampler);
+			cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(s, cgltf_animation_sampler, input), animation->samplers[j].input, data->accessors, writer->accessors);
+			cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(s, cgltf_animation_sampler, output), animation->samplers[j].output, data->accessors, writer->accessors);
+		}
+
+		cgltf_size channels = cgltf_cache_array(writer, CGLTF_CACHE_SLOT(a, cgltf_animation, channels), animation->channels, animation->channels_count * sizeof(cgltf_animation_channel));
+
+		for (cgltf_size j = 0; j < animation->channels_count; ++j)
+		{
+			cgltf_size c = channels + j * sizeof(cgltf_animation_channel);
+			cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(c, cgltf_animation_channel, sampler), animation->channels[j].sampler, animation->samplers, samplers);
+			cgltf_cache_ref(writer, CGLTF_CACHE_SLOT(c, cgltf_animation_channel, target_node), animation->channels[j].target_node, data->nodes, writer->nodes);
+		}
+	}
+
+	writer->size = (writer->size + 7) & ~(cgltf_size)7;
+}
+
+cgltf_size cgltf_write_cache(const cgltf_data* data, void* buffer, cgltf_size size)
+{
+	cgltf_cache_writer writer;
+	memset(&writer, 0, sizeof(writer));
+	cgltf_cache_write(&writer, data);
+
+	cgltf_size relocations_offset = writer.size;
+	cgltf_size total_size = relocations_offset + writer.relocations_count * sizeof(cgltf_size);
+
+	if (!buffer || size < total_size)
+	{
+		return total_size;
+	}
+
+	/* Padding between and inside the objects must not carry over whatever was in the buffer */
+	memset(buffer, 0, total_size);
+
+	memset(&writer, 0, sizeof(writer));
+	writer.out = (uint8_t*)buffer;
+	writer.relocations_offset = relocations_offset;
+	cgltf_cache_write(&writer, data);
+
+	cgltf_cache_header header;
+	memset(&header, 0, sizeof(header));
+	header.magic = CGLTF_CACHE_MAGIC;
+	header.version = CGLTF_CACHE_VERSION;
+	header.layout = cgltf_cache_layout();
+	header.size = total_size;
+	header.relocations_offset = relocations_offset;
+	header.relocations_count = writer.relocations_count;
+	memcpy(buffer, &header, sizeof(header));
+
+	return total_size;
+}
+
+cgltf_result cgltf_parse_cache(const cgltf_options* options, void* cache, cgltf_size size, cgltf_data** out_data)
+{
+	if (options == NULL || ((uintptr_t)cache & 7) != 0)
+	{
+		return cgltf_result_invalid_options;
+	}
+
+	cgltf_cache_header header;
+
+	if (size < sizeof(header))
+	{
+		return cgltf_result_data_too_short;
+	}
+
+	memcpy(&header, cache, sizeof(header));
+
+	if (header.magic != CGLTF_CACHE_MAGIC || header.version != CGLTF_CACHE_VERSION || header.layout != cgltf_cache_layout())
+	{
+		return cgltf_result_unknown_format;
+	}
+
+	cgltf_size data_offset = (sizeof(header) + 7) & ~(cgltf_size)7;
+
+	if (header.size > size || header.size < data_offset + sizeof(cgltf_data) ||
+		header.relocations_offset > header.size || header.relocations_count > (header.size - header.relocations_offset) / sizeof(cgltf_size))
+	{
+		return cgltf_result_data_too_short;
+	}
+
+	/* The objects, starting with the data, end where the relocation table begins */
+	if (header.relocations_offset < data_offset + sizeof(cgltf_data))
+	{
+		return cgltf_result_invalid_gltf;
+	}
+
+	uint8_t* base = (uint8_t*)cache;
+	const uint8_t* relocations = base + header.relocations_offset;
+
+	for (cgltf_size i = 0; i < header.relocations_count; ++i)
+	{
+		cgltf_size slot;
+		cgltf_size target;
+		memcpy(&slot, relocations + i * sizeof(cgltf_size), sizeof(slot));
+
+		if (slot < data_offset || slot > header.relocations_offset || slot + sizeof(void*) > header.relocations_offset || slot % sizeof(void*) != 0)
+		{
+			return cgltf_result_invalid_gltf;
+		}
+
+		memcpy(&target, base + slot, sizeof(target));
+
+		if (target > header.relocations_offset)
+		{
+			return cgltf_result_invalid_gltf;
+		}
+
+		*(void**)(base + slot) = base + target;
+	}
+
+	cgltf_data* data = (cgltf_data*)(base + data_offset);
+	data->file_data = cache;
+	data->file_size = size;
+	data->file_data_free_method = cgltf_data_free_method_none;
+	cgltf_options caller_options = cgltf_caller_options(options);
+	data->memory_free = caller_options.memory_free ? caller_options.memory_free : &cgltf_default_free;
+	data->memory_user_data = caller_options.memory_user_data;
+	data->file_release = options->file_release;
+	data->file_user_data = options->file_user_data;
+	data->cached = 1;
+
+	*out_data = data;
+
+	return cgltf_result_success;
+}
+
+cgltf_result cgltf_parse_cache_file(const cgltf_options* options, const char* path, cgltf_data** out_data)
+{
+	if (options == NULL)
+	{
+		return cgltf_result_invalid_options;
+	}
+
+	cgltf_stats_allocator counter;
+	cgltf_options fixed_options;
+	if (cgltf_stats_count_allocations(options, &counter, &fixed_options))
+	{
+		return cgltf_parse_cache_file(&fixed_options, path, out_data);
+	}
+
+	/* Mapped files are read-only, and the pointers are relocated in place */
+	fixed_options.map_files = 0;
+
+	void (*memory_free)(void*, void*) = options->memory_free ? options->memory_free : &cgltf_default_free;
+
+	void* file_data = NULL;
+	cgltf_size file_size = 0;
+	cgltf_data_free_method free_method;
+
+	cgltf_result result = cgltf_load_file(&fixed_options, path, 0, &file_size, &file_data, &free_method);
+
+	if (result != cgltf_result_success)
+	{
+		return result;
+	}
+
+	result = cgltf_parse_cache(&fixed_options, file_data, file_size, out_data);
+
+	if (result != cgltf_result_success)
+	{
+		cgltf_free_file_data(memory_free, options->memory_user_data, options->file_release, options->file_user_data, file_data, file_size, free_method);
+		return result;
+	}
+
+	(*out_data)->file_data_free_method = free_method;
+
+	return cgltf_result_success;
+}
+
+void cgltf_context_free(cgltf_context* context)
+{
+	if (!context)
+	{
+		return;
+	}
+
+	if (context->tokens)
+	{
+		context->memory_free(context->memory_user_data, context->tokens);
+	}
+
+	if (context->arena_block)
+	{
+		context->memory_free(context->memory_user_data, context->arena_block);
+	}
+
+	memset(context, 0, sizeof(cgltf_context));
+}
+
+static void cgltf_trs_to_matrix(const cgltf_float* translation, const cgltf_float* rotation, const cgltf_float* scale, cgltf_float* lm)
+{
+	float tx = translation[0];
+	float ty = translation[1];
+	float tz = translation[2];
+
+	float qx = rotation[0];
+	float qy = rotation[1];
+	float qz = rotation[2];
+	float qw = rotation[3];
+
+	float sx = scale[0];
+	float sy = scale[1];
+	float sz = scale[2];
+
+	lm[0] = (1 - 2 * qy*qy - 2 * qz*qz) * sx;
+	lm[1] = (2 * qx*qy + 2 * qz*qw) * sy;
+	lm[2] = (2 * qx*qz - 2 * qy*qw) * sz;
+	lm[3] = 0.f;
+
+	lm[4] = (2 * qx*qy - 2 * qz*qw) * sx;
+	lm[5] = (1 - 2 * qx*qx - 2 * qz*qz) * sy;
+	lm[6] = (2 * qy*qz + 2 * qx*qw) * sz;
+	lm[7] = 0.f;
+
+	lm[8] = (2 * qx*qz + 2 * qy*qw) * sx;
+	lm[9] = (2 * qy*qz - 2 * qx*qw) * sy;
+	lm[10] = (1 - 2 * qx*qx - 2 * qy*qy) * sz;
+	lm[11] = 0.f;
+
+	lm[12] = tx;
+	lm[13] = ty;
+	lm[14] = tz;
+	lm[15] = 1.f;
+}
+
+void cgltf_node_transform_local(const cgltf_node* node, cgltf_float* out_matrix)
+{
+	if (node->has_matrix)
+	{
+		memcpy(out_matrix, node->matrix, sizeof(float) * 16);
+	}
+	else
+	{
+		cgltf_trs_to_matrix(node->translation, node->rotation, node->scale, out_matrix);
+	}
+}
+
+/* out = a * b for column-major 4x4 matrices. Every column of out is a combination of the columns of a, which maps
+ * directly onto four-wide vector multiplies and adds; the order of operations is the same on every path. */
+static void cgltf_matrix_multiply(const cgltf_float* a, const cgltf_float* b, cgltf_float* out)
+{
+#if defined(CGLTF_SIMD_SSE2)
+	const __m128 a0 = _mm_loadu_ps(a);
+	const __m128 a1 = _mm_loadu_ps(a + 4);
+	const __m128 a2 = _mm_loadu_ps(a + 8);
+	const __m128 a3 = _mm_loadu_ps(a + 12);
+
+	for (int i = 0; i < 4; ++i)
+	{
+		__m128 r = _mm_mul_ps(a0, _mm_set1_ps(b[i * 4 + 0]));
+		r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(b[i * 4 + 1])));
+		r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(b[i * 4 + 2])));
+		r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(b[i * 4 + 3])));
+		_mm_storeu_ps(out + i * 4, r);
+	}
+#elif defined(CGLTF_SIMD_NEON)
+	const float32x4_t a0 = vld1q_f32(a);
+	const float32x4_t a1 = vld1q_f32(a + 4);
+	const float32x4_t a2 = vld1q_f32(a + 8);
+	const float32x4_t a3 = vld1q_f32(a + 12);
+
+	for (int i = 0; i < 4; ++i)
+	{
+		float32x4_t r = vmulq_n_f32(a0, b[i * 4 + 0]);
+		r = vaddq_f32(r, vmulq_n_f32(a1, b[i * 4 + 1]));
+		r = vaddq_f32(r, vmulq_n_f32(a2, b[i * 4 + 2]));
+		r = vaddq_f32(r, vmulq_n_f32(a3, b[i * 4 + 3]));
+		vst1q_f32(out + i * 4, r);
+	}
+#else
+	for (int i = 0; i < 4; ++i)
+	{
+		for (int j = 0; j < 4; ++j)
+		{
+			out[i * 4 + j] = a[j] * b[i * 4 + 0] + a[4 + j] * b[i * 4 + 1] + a[8 + j] * b[i * 4 + 2] + a[12 + j] * b[i * 4 + 3];
+		}
+	}
+#endif
+}
+
+/* Replaces lm with pm * lm, treating both as affine transforms */
+static void cgltf_transform_multiply(const cgltf_float* pm, cgltf_float* lm)
+{
+	for (int i = 0; i < 4; ++i)
+	{
+		float l0 = lm[i * 4 + 0];
+		float l1 = lm[i * 4 + 1];
+		float l2 = lm[i * 4 + 2];
+
+		float r0 = l0 * pm[0] + l1 * pm[4] + l2 * pm[8];
+		float r1 = l0 * pm[1] + l1 * pm[5] + l2 * pm[9];
+		float r2 = l0 * pm[2] + l1 * pm[6] + l2 * pm[10];
+
+		lm[i * 4 + 0] = r0;
+		lm[i * 4 + 1] = r1;
+		lm[i * 4 + 2] = r2;
+	}
+
+	lm[12] += pm[12];
+	lm[13] += pm[13];
+	lm[14] += pm[14];
+}
+
+void cgltf_node_transform_world(const cgltf_node* node, cgltf_float* out_matrix)
+{
+	cgltf_float* lm = out_matrix;
+	cgltf_node_transform_local(node, lm);
+
+	const cgltf_node* parent = node->parent;
+
+	while (parent)
+	{
+		float pm[16];
+		cgltf_node_transform_local(parent, pm);
+
+		cgltf_transform_multiply(pm, lm);
+
+		parent = parent->parent;
+	}
+}
+
+/* The traversal below keeps the index of the next child to visit of every node on the current path in elements 3 and 7
+ * of that node's world matrix. cgltf_transform_multiply never reads them, and they are equal in the local and world
+ * matrix, so they can be restored once all children are done. This needs neither recursion nor memory. */
+static void cgltf_world_transform_set_cursor(cgltf_float* matrix, cgltf_size cursor)
+{
+	uint32_t halves[2] = { (uint32_t)cursor, (uint32_t)((uint64_t)cursor >> 32) };
+	memcpy(&matrix[3], &halves[0], sizeof(uint32_t));
+	memcpy(&matrix[7], &halves[1], sizeof(uint32_t));
+}
+
+static cgltf_size cgltf_world_transform_get_cursor(const cgltf_float* matrix)
+{
+	uint32_t halves[2];
+	memcpy(&halves[0], &matrix[3], sizeof(uint32_t));
+	memcpy(&halves[1], &matrix[7], sizeof(uint32_t));
+	return (cgltf_size)(((uint64_t)halves[1] << 32) | halves[0]);
+}
+
+static void cgltf_compute_world_transforms(const cgltf_data* data, const cgltf_node* root, cgltf_float* out_matrices)
+{
+	const cgltf_node* node = root;
+	cgltf_float* lm = out_matrices + 16 * (node - data->nodes);
+	cgltf_node_transform_local(node, lm);
+	cgltf_world_transform_set_cursor(lm, 0);
+
+	while (node)
+	{
+		lm = out_matrices + 16 * (node - data->nodes);
+		cgltf_size cursor = cgltf_world_transform_get_cursor(lm);
+
+		if (cursor < node->children_count)
+		{
+			cgltf_world_transform_set_cursor(lm, cursor + 1);
+
+			const cgltf_node* child = node->children[cursor];
+			cgltf_float* cm = out_matrices + 16 * (child - data->nodes);
+			cgltf_node_transform_local(child, cm);
+			cgltf_transform_multiply(lm, cm);
+			cgltf_world_transform_set_cursor(cm, 0);
+
+			node = child;
+		}
+		else
+		{
+			lm[3] = node->has_matrix ? node->matrix[3] : 0.f;
+			lm[7] = node->has_matrix ? node->matrix[7] : 0.f;
+
+			// Every node is the child of its parent, which the parser checks, so the path leads back up to the root
+			node = node == root ? NULL : node->parent;
+		}
+	}
+}
+
+void cgltf_scene_compute_world_transforms(const cgltf_data* data, const cgltf_scene* scene, cgltf_float* out_matrices)
+{
+	if (scene)
+	{
+		for (cgltf_size i = 0; i < scene->nodes_count; ++i)
+		{
+			cgltf_compute_world_transforms(data, scene->nodes[i], out_matrices);
+		}
+	}
+	else
+	{
+		for (cgltf_size i = 0; i < data->nodes_count; ++i)
+		{
+			if (data->nodes[i].parent == NULL)
+			{
+				cgltf_compute_world_transforms(data, &data->nodes[i], out_matrices);
+			}
+		}
+	}
+}
+
+void cgltf_skin_compute_joint_matrices(const cgltf_data* data, const cgltf_skin* skin, const cgltf_float* world_matrices, const cgltf_float* inverse_bind_matrices, cgltf_float* out_matrices)
+{
+	for (cgltf_size i = 0; i < skin->joints_count; ++i)
+	{
+		const cgltf_float* world_matrix = world_matrices + 16 * (skin->joints[i] - data->nodes);
+		if (inverse_bind_matrices)
+		{
+			cgltf_matrix_multiply(world_matrix, inverse_bind_matrices + 16 * i, out_matrices + 16 * i);
+		}
+		else
+		{
+			memcpy(out_matrices + 16 * i, world_matrix, 16 * sizeof(cgltf_float));
+		}
+	}
+}
+
+cgltf_result cgltf_node_table_create(const cgltf_options* options, const cgltf_data* data, cgltf_node_table* out_table)
+{
+	void* (*memory_alloc)(void*, cgltf_size) = options->memory_alloc ? options->memory_alloc : &cgltf_default_alloc;
+	void (*memory_free)(void*, void*) = options->memory_free ? options->memory_free : &cgltf_default_free;
+
+	memset(out_table, 0, sizeof(cgltf_node_table));
+
+	cgltf_size nodes_count = data->nodes_count;
+	cgltf_size children_count = 0;
+	cgltf_size matrices_count = 0;
+	for (cgltf_size i = 0; i < nodes_count; ++i)
+	{
+		children_count += data->nodes[i].children_count;
+		matrices_count += data->nodes[i].has_matrix;
+	}
+
+	// Offsets come first, then the floats and the indices, so that every array is aligned
+	cgltf_size offsets_size = (nodes_count + 1) * sizeof(cgltf_size);
+	cgltf_size floats_size = (nodes_count * 10 + matrices_count * 16) * sizeof(cgltf_float);
+	cgltf_size indices_size = (nodes_count * 5 + children_count) * sizeof(cgltf_int);
+	uint8_t* memory = (uint8_t*)memory_alloc(options->memory_user_data, offsets_size + floats_size + indices_size + 1);
+	if (!memory)
+	{
+		return cgltf_result_out_of_memory;
+	}
+
+	cgltf_float* floats = (cgltf_float*)(memory + offsets_size);
+	cgltf_int* indices = (cgltf_int*)(memory + offsets_size + floats_size);
+
+	out_table->data = data;
+	out_table->nodes_count = nodes_count;
+	out_table->children_offsets = (cgltf_size*)memory;
+	out_table->translations = floats;
+	out_table->rotations = floats + nodes_count * 3;
+	out_table->scales = floats + nodes_count * 7;
+	out_table->matrices = floats + nodes_count * 10;
+	out_table->parents = indices;
+	out_table->meshes = indices + nodes_count;
+	out_table->matrix_indices = indices + nodes_count * 2;
+	out_table->order = indices + nodes_count * 3;
+	out_table->children = indices + nodes_count * 4;
+	out_table->memory_free = memory_free;
+	out_table->memory_user_data = options->memory_user_data;
+
+	cgltf_size children_offset = 0;
+	for (cgltf_size i = 0; i < nodes_count; ++i)
+	{
+		const cgltf_node* node = &data->nodes[i];
+
+		out_table->parents[i] = node->parent ? (cgltf_int)(node->parent - data->nodes) : -1;
+		out_table->meshes[i] = node->mesh ? (cgltf_int)(node->mesh - data->meshes) : -1;
+		memcpy(out_table->translations + i * 3, node->translation, 3 * sizeof(cgltf_float));
+		memcpy(out_table->rotations + i * 4, node->rotation, 4 * sizeof(cgltf_float));
+		memcpy(out_table->scales + i * 3, node->scale, 3 * sizeof(cgltf_float));
+
+		out_table->matrix_indices[i] = -1;
+		if (node->has_matrix)
+		{
+			out_table->matrix_indices[i] = (cgltf_int)out_table->matrices_count;
+			memcpy(out_table->matrices + out_table->matrices_count * 16, node->matrix, 16 * sizeof(cgltf_float));
+			out_table->matrices_count++;
+		}
+
+		out_table->children_offsets[i] = children_offset;
+		for (cgltf_size j = 0; j < node->children_count; ++j)
+		{
+			out_table->children[children_offset++] = (cgltf_int)(node->children[j] - data->nodes);
+		}
+	}
+	out_table->children_offsets[nodes_count] = children_offset;
+
+	// Breadth-first from the roots; a node is only entered from its own parent, so every node appears at most once
+	for (cgltf_size i = 0; i < nodes_count; ++i)
+	{
+		if (out_table->parents[i] < 0)
+		{
+			out_table->order[out_table->order_count++] = (cgltf_int)i;
+		}
+	}
+
+	for (cgltf_size i = 0; i < out_table->order_count; ++i)
+	{
+		cgltf_int node = out_table->order[i];
+		for (cgltf_size j = out_table->children_offsets[node]; j < out_table->children_offsets[node + 1]; ++j)
+		{
+			cgltf_int child = out_table->children[j];
+			if (out_table->parents[child] == node)
+			{
+				out_table->order[out_table->order_count++] = child;
+			}
+		}
+	}
+
+	return cgltf_result_success;
+}
+
+void cgltf_node_table_compute_world_transforms(const cgltf_node_table* table, cgltf_float* out_matrices)
+{
+	for (cgltf_size i = 0; i < table->order_count; ++i)
+	{
+		cgltf_int node = table->order[i];
+		cgltf_float* lm = out_matrices + 16 * node;
+		cgltf_int matrix_index = table->matrix_indices[node];
+
+		if (matrix_index >= 0)
+		{
+			memcpy(lm, table->matrices + 16 * matrix_index, 16 * sizeof(cgltf_float));
+		}
+		else
+		{
+			cgltf_trs_to_matrix(table->translations + 3 * node, table->rotations + 4 * node, table->scales + 3 * node, lm);
+		}
+
+		// Parents precede their children in the order, so their world matrices are already complete
+		if (table->parents[node] >= 0)
+		{
+			cgltf_transform_multiply(out_matrices + 16 * table->parents[node], lm);
+		}
+	}
+}
+
+void cgltf_node_table_free(cgltf_node_table* table)
+{
+	if (table->children_offsets)
+	{
+		table->memory_free(table->memory_user_data, table->children_offsets);
+	}
+	memset(table, 0, sizeof(cgltf_node_table));
+}
+
+cgltf_result cgltf_accessor_table_create(const cgltf_options* options, const cgltf_data* data, cgltf_accessor_table* out_table)
+{
+	void* (*memory_alloc)(void*, cgltf_size) = options->memory_alloc ? options->memory_alloc : &cgltf_default_alloc;
+	void (*memory_free)(void*, void*) = options->memory_free ? options->memory_free : &cgltf_default_free;
+
+	memset(out_table, 0, sizeof(cgltf_accessor_table));
+
+	cgltf_size accessors_count = data->accessors_count;
+	cgltf_size sizes_size = accessors_count * 3 * sizeof(cgltf_size);
+	cgltf_size indices_size = accessors_count * sizeof(cgltf_int);
+	uint8_t* memory = (uint8_t*)memory_alloc(options->memory_user_data, sizes_size + indices_size + accessors_count * 3 + 1);
+	if (!memory)
+	{
+		return cgltf_result_out_of_memory;
+	}
+
+	out_table->data = data;
+	out_table->accessors_count = accessors_count;
+	out_table->counts = (cgltf_size*)memory;
+	out_table->offsets = out_table->counts + accessors_count;
+	out_table->strides = out_table->counts + accessors_count * 2;
+	out_table->buffer_views = (cgltf_int*)(memory + sizes_size);
+	out_table->component_types = memory + sizes_size + indices_size;
+	out_table->types = out_table->component_types + accessors_count;
+	out_table->flags = out_table->component_types + accessors_count * 2;
+	out_table->memory_free = memory_free;
+	out_table->memory_user_data = options->memory_user_data;
+
+	for (cgltf_size i = 0; i < accessors_count; ++i)
+	{
+		const cgltf_accessor* accessor = &data->accessors[i];
+
+		out_table->counts[i] = accessor->count;
+		out_table->offsets[i] = accessor->offset;
+		out_table->strides[i] = accessor->stride;
+		out_table->buffer_views[i] = accessor->buffer_view ? (cgltf_int)(accessor->buffer_view - data->buffer_views) : -1;
+		out_table->component_types[i] = (unsigned char)accessor->component_type;
+		out_table->types[i] = (unsigned char)accessor->type;
+		out_table->flags[i] = (unsigned char)((accessor->normalized ? cgltf_accessor_flag_normalized : 0) |
+			(accessor->is_sparse ? cgltf_accessor_flag_sparse : 0) |
+			(accessor->has_min ? cgltf_accessor_flag_min : 0) |
+			(accessor->has_max ? cgltf_accessor_flag_max : 0));
+	}
+
+	return cgltf_result_success;
+}
+
+void cgltf_accessor_table_free(cgltf_accessor_table* table)
+{
+	if (table->counts)
+	{
+		table->memory_free(table->memory_user_data, table->counts);
+	}
+	memset(table, 0, sizeof(cgltf_accessor_table));
+}
+
+cgltf_result cgltf_animation_clip_create(const cgltf_options* options, const cgltf_animation* animation, cgltf_animation_clip* out_clip)
+{
+	void* (*memory_alloc)(void*, cgltf_size) = options->memory_alloc ? options->memory_alloc : &cgltf_default_alloc;
+	void (*memory_free)(void*, void*) = options->memory_free ? options->memory_free : &cgltf_default_free;
+
+	memset(out_clip, 0, sizeof(cgltf_animation_clip));
+
+	cgltf_size floats_count = 0;
+	for (cgltf_size i = 0; i < animation->samplers_count; ++i)
+	{
+		const cgltf_animation_sampler* sampler = &animation->samplers[i];
+		if (!sampler->input || !sampler->output || sampler->input->type != cgltf_type_scalar)
+		{
+			return cgltf_result_invalid_gltf;
+		}
+		floats_count += sampler->input->count + cgltf_accessor_unpack_floats(sampler->output, NULL, 0);
+	}
+
+	// Tracks, the offset of every sampler's keyframes and the keyframes themselves share one allocation
+	cgltf_size tracks_size = animation->channels_count * sizeof(cgltf_animation_track);
+	cgltf_size offsets_size = animation->samplers_count * sizeof(cgltf_size);
+	uint8_t* memory = (uint8_t*)memory_alloc(options->memory_user_data, tracks_size + offsets_size + floats_count * sizeof(cgltf_float) + 1);
+	if (!memory)
+	{
+		return cgltf_result_out_of_memory;
+	}
+
+	cgltf_animation_track* tracks = (cgltf_animation_track*)memory;
+	cgltf_size* offsets = (cgltf_size*)(memory + tracks_size);
+	cgltf_float* floats = (cgltf_float*)(memory + tracks_size + offsets_size);
+
+	cgltf_result result = cgltf_result_success;
+	cgltf_float duration = 0;
+	cgltf_size offset = 0;
+
+	for (cgltf_size i = 0; i < animation->samplers_count && result == cgltf_result_success; ++i)
+	{
+		const cgltf_animation_sampler* sampler = &animation->samplers[i];
+		cgltf_size keyframes_count = sampler->input->count;
+		cgltf_size values_count = cgltf_accessor_unpack_floats(sampler->output, NULL, 0);
+
+		offsets[i] = offset;
+		if (cgltf_accessor_unpack_floats(sampler->input, floats + offset, keyframes_count) != keyframes_count ||
+			cgltf_accessor_unpack_floats(sampler->output, floats + offset + keyframes_count, values_count) != values_count)
+		{
+			result = cgltf_result_data_too_short;
+		}
+		else if (keyframes_count > 0 && floats[offset + keyframes_count - 1] > duration)
+		{
+			duration = floats[offset + keyframes_count - 1];
+		}
+		offset += keyframes_count + values_count;
+	}
+
+	cgltf_size output_count = 0;
+
+	for (cgltf_size i = 0; i < animation->channels_count && result == cgltf_result_success; ++i)
+	{
+		const cgltf_animation_channel* channel = &animation->channels[i];
+		cgltf_animation_track* track = &tracks[i];
+		memset(track, 0, sizeof(cgltf_animation_track));
+		track->target_node = channel->target_node;
+		track->target_path = channel->target_path;
+		track->output_offset = output_count;
+
+		if (!channel->sampler)
+		{
+			continue;
+		}
+
+		const cgltf_animation_sampler* sampler = channel->sampler;
+		cgltf_size keyframes_count = sampler->input->count;
+		cgltf_size values_count = cgltf_accessor_unpack_floats(sampler->output, NULL, 0);
+		cgltf_size elements_count = keyframes_count * (sampler->interpolation == cgltf_interpolation_type_cubic_spline ? 3 : 1);
+		cgltf_size components_count = elements_count ? values_count / elements_count : 0;
+
+		cgltf_size expected_count = components_count;
+		if (channel->target_path == cgltf_animation_path_type_translation || channel->target_path == cgltf_animation_path_type_scale)
+		{
+			expected_count = 3;
+		}
+		else if (channel->target_path == cgltf_animation_path_type_rotation)
+		{
+			expected_count = 4;
+		}
+
+		if (components_count * elements_count != values_count || components_count != expected_count)
+		{
+			result = cgltf_result_invalid_gltf;
+			break;
+		}
+
+		track->times = floats + offsets[sampler - animation->samplers];
+		track->values = track->times + keyframes_count;
+		track->keyframes_count = keyframes_count;
+		track->components_count = components_count;
+		track->interpolation = sampler->interpolation;
+		output_count += components_count;
+	}
+
+	if (result != cgltf_result_success)
+	{
+		memory_free(options->memory_user_data, memory);
+		return result;
+	}
+
+	out_clip->animation = animation;
+	out_clip->tracks = tracks;
+	out_clip->tracks_count = animation->channels_count;
+	out_clip->output_count = output_count;
+	out_clip->duration = duration;
+	out_clip->memory_free = memory_free;
+	out_clip->memory_user_data = options->memory_user_data;
+
+	return cgltf_result_success;
+}
+
+void cgltf_animation_clip_free(cgltf_animation_clip* clip)
+{
+	if (clip->tracks)
+	{
+		clip->memory_free(clip->memory_user_data, clip->tracks);
+	}
+	memset(clip, 0, sizeof(cgltf_animation_clip));
+}
+
+/* The math below avoids <math.h>, so that the library does not have to be linked with libm */
+static cgltf_float cgltf_rsqrtf(cgltf_float x)
+{
+	uint32_t bits;
+	memcpy(&bits, &x, sizeof(bits));
+	bits = 0x5f3759df - (bits >> 1);
+	cgltf_float y;
+	memcpy(&y, &bits, sizeof(y));
+
+	// Three Newton steps take the initial guess to full float precision
+	for (int i = 0; i < 3; ++i)
+	{
+		y = y * (1.5f - 0.5f * x * y * y);
+	}
+	return y;
+}
+
+/* acos for x in [0, 1], Abramowitz and Stegun 4.4.46, with an error below 2e-8 */
+static cgltf_float cgltf_acosf_unit(cgltf_float x)
+{
+	cgltf_float p = -0.0012624911f;
+	p = p * x + 0.0066700901f;
+	p = p * x - 0.0170881256f;
+	p = p * x + 0.0308918810f;
+	p = p * x - 0.0501743046f;
+	p = p * x + 0.0889789874f;
+	p = p * x - 0.2145988016f;
+	p = p * x + 1.5707963050f;
+	cgltf_float y = 1.0f - x;
+	return y > 0 ? p * y * cgltf_rsqrtf(y) : 0;
+}
+
+/* sin for x in [0, pi / 2] from its Taylor series */
+static cgltf_float cgltf_sinf_quadrant(cgltf_float x)
+{
+	cgltf_float x2 = x * x;
+	return x * (1 - x2 / 6 * (1 - x2 / 20 * (1 - x2 / 42 * (1 - x2 / 72 * (1 - x2 / 110)))));
+}
+
+static void cgltf_quat_normalize(cgltf_float* q)
+{
+	cgltf_float length_squared = q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+	if (length_squared > 0)
+	{
+		cgltf_float scale = cgltf_rsqrtf(length_squared);
+		for (int i = 0; i < 4; ++i)
+		{
+			q[i] *= scale;
+		}
+	}
+}
+
+static void cgltf_quat_slerp(const cgltf_float* a, const cgltf_float* b, cgltf_float t, cgltf_float* out)
+{
+	cgltf_float cos_angle = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+	cgltf_float sign = 1;
+	if (cos_angle < 0)
+	{
+		// Take the shorter way around
+		cos_angle = -cos_angle;
+		sign = -1;
+	}
+
+	cgltf_float weight_a = 1 - t;
+	cgltf_float weight_b = t;
+
+	// Nearly parallel quaternions are interpolated linearly, as the sine of their angle tends to zero
+	if (cos_angle < 0.9995f)
+	{
+		cgltf_float angle = cgltf_acosf_unit(cos_angle);
+		cgltf_float inv_sin_angle = 1 / cgltf_sinf_quadrant(angle);
+		weight_a = cgltf_sinf_quadrant((1 - t) * angle) * inv_sin_angle;
+		weight_b = cgltf_sinf_quadrant(t * angle) * inv_sin_angle;
+	}
+
+	for (int i = 0; i < 4; ++i)
+	{
+		out[i] = weight_a * a[i] + sign * weight_b * b[i];
+	}
+	cgltf_quat_normalize(out);
+}
+
+/* Returns the last keyframe at or before time, which must lie within the keyframes */
+static cgltf_size cgltf_animation_track_seek(cgltf_animation_track* track, cgltf_float time)
+{
+	const cgltf_float* times = track->times;
+	cgltf_size last = track->keyframes_count - 1;
+	cgltf_size cursor = track->cursor < last ? track->cursor : last;
+
+	// Playback usually stays in the same keyframe interval or moves on to the next one
+	if (times[cursor] <= time)
+	{
+		if (cursor == last || time < times[cursor + 1])
+		{
+			return cursor;
+		}
+		if (cursor + 1 == last || time < times[cursor + 2])
+		{
+			return track->cursor = cursor + 1;
+		}
+	}
+
+	cgltf_size low = 0;
+	cgltf_size high = last;
+	while (low < high)
+	{
+		cgltf_size middle = low + (high - low + 1) / 2;
+		if (times[middle] <= time)
+		{
+			low = middle;
+		}
+		else
+		{
+			high = middle - 1;
+		}
+	}
+	return track->cursor = low;
+}
+
+static void cgltf_animation_track_sample(cgltf_animation_track* track, cgltf_float time, cgltf_float* out)
+{
+	cgltf_size components_count = track->components_count;
+	cgltf_size last = track->keyframes_count - 1;
+	cgltf_bool cubic = track->interpolation == cgltf_interpolation_type_cubic_spline;
+	cgltf_size stride = cubic ? components_count * 3 : components_count;
+	const cgltf_float* values = track->values + (cubic ? components_count : 0);
+
+	cgltf_bool rotation = track->target_path == cgltf_animation_path_type_rotation;
+
+	// Times outside the keyframes, and NaN, hold the first or last value
+	if (!(time > track->times[0]) || !(time < track->times[last]))
+	{
+		track->cursor = time > track->times[0] ? last : 0;
+		memcpy(out, values + track->cursor * stride, components_count * sizeof(cgltf_float));
+		if (rotation)
+		{
+			cgltf_quat_normalize(out);
+		}
+		return;
+	}
+
+	cgltf_size key = cgltf_animation_track_seek(track, time);
+	const cgltf_float* current = values + key * stride;
+	const cgltf_float* next = current + stride;
+	cgltf_float delta = track->times[key + 1] - track->times[key];
+	cgltf_float t = (time - track->times[key]) / delta;
+
+	if (track->interpolation == cgltf_interpolation_type_step)
+	{
+		memcpy(out, current, components_count * sizeof(cgltf_float));
+		if (rotation)
+		{
+			cgltf_quat_normalize(out);
+		}
+	}
+	else if (cubic)
+	{
+		// Hermite spline through the values, scaling the out-tangent of this keyframe and the in-tangent of the next by the interval
+		cgltf_float t2 = t * t;
+		cgltf_float t3 = t2 * t;
+		cgltf_float weight_value = 2 * t3 - 3 * t2 + 1;
+		cgltf_float weight_out = (t3 - 2 * t2 + t) * delta;
+		cgltf_float weight_next = -2 * t3 + 3 * t2;
+		cgltf_float weight_in = (t3 - t2) * delta;
+		const cgltf_float* out_tangent = current + components_count;
+		const cgltf_float* in_tangent = next - components_count;
+		for (cgltf_size i = 0; i < components_count; ++i)
+		{
+			out[i] = weight_value * current[i] + weight_out * out_tangent[i] + weight_next * next[i] + weight_in * in_tangent[i];
+		}
+		if (rotation)
+		{
+			cgltf_quat_normalize(out);
+		}
+	}
+	else if (rotation)
+	{
+		cgltf_quat_slerp(current, next, t, out);
+	}
+	else
+	{
+		for (cgltf_size i = 0; i < components_count; ++i)
+		{
+			out[i] = current[i] + (next[i] - current[i]) * t;
+		}
+	}
+}
+
+void cgltf_animation_clip_sample(cgltf_animation_clip* clip, cgltf_float time, cgltf_float* out)
+{
+	for (cgltf_size i = 0; i < clip->tracks_count; ++i)
+	{
+		cgltf_animation_track* track = &clip->tracks[i];
+		if (track->keyframes_count > 0)
+		{
+			cgltf_animation_track_sample(track, time, out + track->output_offset);
+		}
+	}
+}
+
+static cgltf_size cgltf_component_read_index(const void* in, cgltf_component_type component_type)
+{
+	switch (component_type)
+	{
+		case cgltf_component_type_r_16:
+			return *((const int16_t*) in);
+		case cgltf_component_type_r_16u:
+			return *((const uint16_t*) in);
+		case cgltf_component_type_r_32u:
+			return *((const uint32_t*) in);
+		case cgltf_component_type_r_32f:
+			return (cgltf_size)*((const float*) in);
+		case cgltf_component_type_r_8:
+			return *((const int8_t*) in);
+		case cgltf_component_type_r_8u:
+		case cgltf_component_type_invalid:
+		default:
+			return *((const uint8_t*) in);
+	}
+}
+
+static cgltf_float cgltf_component_read_float(const void* in, cgltf_component_type component_type, cgltf_bool normalized)
+{
+	if (component_type == cgltf_component_type_r_32f)
+	{
+		return *((const float*) in);
+	}
+
+	if (normalized)
+	{
+		switch (component_type)
+		{
+			case cgltf_component_type_r_32u:
+				return *((const uint32_t*) in) / (float) UINT_MAX;
+			case cgltf_component_type_r_16:
+				return *((const int16_t*) in) / (float) SHRT_MAX;
+			case cgltf_component_type_r_16u:
+				return *((const uint16_t*) in) / (float) USHRT_MAX;
+			case cgltf_component_type_r_8:
+				return *((const int8_t*) in) / (float) SCHAR_MAX;
+			case cgltf_component_type_r_8u:
+			case cgltf_component_type_invalid:
+			default:
+				return *((const uint8_t*) in) / (float) UCHAR_MAX;
+		}
+	}
+
+	switch (component_type)
+	{
+		case cgltf_component_type_r_16:
+			return *((const int16_t*) in);
+		case cgltf_component_type_r_8:
+			return *((const int8_t*) in);
+		default:
+			return (cgltf_float)cgltf_component_read_index(in, component_type);
+	}
+}
+
+static cgltf_size cgltf_num_components(cgltf_type type);
+static cgltf_size cgltf_component_size(cgltf_component_type component_type);
+
+static cgltf_bool cgltf_element_read_float(const uint8_t* element, cgltf_type type, cgltf_component_type component_type, cgltf_bool normalized, cgltf_float* out, cgltf_size element_size)
+{
+	cgltf_size num_components = cgltf_num_components(type);
+
+	if (element_size < num_components) {
+		return 0;
+	}
+
+	// There are three special cases for component extraction, see #data-alignment in the 2.0 spec.
+
+	cgltf_size component_size = cgltf_component_size(component_type);
+
+	if (type == cgltf_type_mat2 && component_size == 1)
+	{
+		out[0] = cgltf_component_read_float(element, component_type, normalized);
+		out[1] = cgltf_component_read_float(element + 1, component_type, normalized);
+		out[2] = cgltf_component_read_float(element + 4, component_type, normalized);
+		out[3] = cgltf_component_read_float(element + 5, component_type, normalized);
+		return 1;
+	}
+
+	if (type == cgltf_type_mat3 && component_size == 1)
+	{
+		out[0] = cgltf_component_read_float(element, component_type, normalized);
+		out[1] = cgltf_component_read_float(element + 1, component_type, normalized);
+		out[2] = cgltf_component_read_float(element + 2, component_type, normalized);
+		out[3] = cgltf_component_read_float(element + 4, component_type, normalized);
+		out[4] = cgltf_component_read_float(element + 5, component_type, normalized);
+		out[5] = cgltf_component_read_float(element + 6, component_type, normalized);
+		out[6] = cgltf_component_read_float(element + 8, component_type, normalized);
+		out[7] = cgltf_component_read_float(element + 9, component_type, normalized);
+		out[8] = cgltf_component_read_float(element + 10, component_type, normalized);
+		return 1;
+	}
+
+	if (type == cgltf_type_mat3 && component_size == 2)
+	{
+		out[0] = cgltf_component_read_float(element, component_type, normalized);
+		out[1] = cgltf_component_read_float(element + 2, component_type, normalized);
+		out[2] = cgltf_component_read_float(element + 4, component_type, normalized);
+		out[3] = cgltf_component_read_float(element + 8, component_type, normalized);
+		out[4] = cgltf_component_read_float(element + 10, component_type, normalized);
+		out[5] = cgltf_component_read_float(element + 12, component_type, normalized);
+		out[6] = cgltf_component_read_float(element + 16, component_type, normalized);
+		out[7] = cgltf_component_read_float(element + 18, component_type, normalized);
+		out[8] = cgltf_component_read_float(element + 20, component_type, normalized);
+		return 1;
+	}
+
+	for (cgltf_size i = 0; i < num_components; ++i)
+	{
+		out[i] = cgltf_component_read_float(element + component_size * i, component_type, normalized);
+	}
+	return 1;
+}
+
+static const uint8_t* cgltf_sparse_indices_data(const cgltf_accessor_sparse* sparse)
+{
+	const uint8_t* data = (const uint8_t*) sparse->indices_buffer_view->buffer->data;
+	return data ? data + sparse->indices_buffer_view->offset + sparse->indices_byte_offset : NULL;
+}
+
+static const uint8_t* cgltf_sparse_values_data(const cgltf_accessor_sparse* sparse)
+{
+	const uint8_t* data = (const uint8_t*) sparse->values_buffer_view->buffer->data;
+	return data ? data + sparse->values_buffer_view->offset + sparse->values_byte_offset : NULL;
+}
+
+/* Returns the position of the first sparse index that is not less than index; sparse indices are strictly increasing */
+static cgltf_size cgltf_sparse_lower_bound(const uint8_t* indices, cgltf_component_type component_type, cgltf_size count, cgltf_size index)
+{
+	cgltf_size component_size = cgltf_component_size(component_type);
+	cgltf_size begin = 0;
+	cgltf_size end = count;
+
+	while (begin < end)
+	{
+		cgltf_size middle = begin + (end - begin) / 2;
+		if (cgltf_component_read_index(indices + component_size * middle, component_type) < index)
+		{
+			begin = middle + 1;
+		}
+		else
+		{
+			end = middle;
+		}
+	}
+
+	return begin;
+}
+
+cgltf_bool cgltf_accessor_read_float(const cgltf_accessor* accessor, cgltf_size index, cgltf_float* out, cgltf_size element_size)
+{
+	if (accessor->is_sparse)
+	{
+		const cgltf_accessor_sparse* sparse = &accessor->sparse;
+		const uint8_t* indices = cgltf_sparse_indices_data(sparse);
+		const uint8_t* values = cgltf_sparse_values_data(sparse);
+
+		if (!indices || !values)
+		{
+			return 0;
+		}
+
+		cgltf_size position = cgltf_sparse_lower_bound(indices, sparse->indices_component_type, sparse->count, index);
+		cgltf_size indices_component_size = cgltf_component_size(sparse->indices_component_type);
+
+		if (position < sparse->count && cgltf_component_read_index(indices + indices_component_size * position, sparse->indices_component_type) == index)
+		{
+			values += cgltf_calc_size(accessor->type, accessor->component_type) * position;
+			return cgltf_element_read_float(values, accessor->type, accessor->component_type, accessor->normalized, out, element_size);
+		}
+
+		if (accessor->buffer_view == NULL)
+		{
+			cgltf_size num_components = cgltf_num_components(accessor->type);
+
+			if (element_size < num_components)
+			{
+				return 0;
+			}
+
+			memset(out, 0, num_components * sizeof(cgltf_float));
+			return 1;
+		}
+	}
+
+	if (accessor->buffer_view == NULL)
+	{
+		return 0;
+	}
+
+	cgltf_size offset = accessor->offset + accessor->buffer_view->offset;
+	const uint8_t* element = (const uint8_t*) accessor->buffer_view->buffer->data;
+	element += offset + accessor->stride * index;
+	return cgltf_element_read_float(element, accessor->type, accessor->component_type, accessor->normalized, out, element_size);
+}
+
+cgltf_size cgltf_accessor_read_index(const cgltf_accessor* accessor, cgltf_size index)
+{
+	if (accessor->buffer_view)
+	{
+		cgltf_size offset = accessor->offset + accessor->buffer_view->offset;
+		const uint8_t* element = (const uint8_t*) accessor->buffer_view->buffer->data;
+		element += offset + accessor->stride * index;
+		return cgltf_component_read_index(element, accessor->component_type);
+	}
+
+	return 0;
+}
+
+/* Converts a prefix of n tightly packed 8/16-bit components and returns its length; the caller converts the rest.
+ * Like the scalar code this divides instead of multiplying by the reciprocal, so the results are bit-identical. */
+static cgltf_size cgltf_unpack_components_simd(const void* in, cgltf_component_type component_type, cgltf_size n, float divisor, cgltf_float* out)
+{
+	cgltf_size i = 0;
+
+#if defined(CGLTF_SIMD_AVX2)
+	const __m256 d = _mm256_set1_ps(divisor);
+
+	for (; i + 8 <= n; i += 8)
+	{
+		__m256i v;
+		switch (component_type)
+		{
+			case cgltf_component_type_r_8:
+				v = _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i*)((const int8_t*)in + i)));
+				break;
+			case cgltf_component_type_r_8u:
+				v = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)((const uint8_t*)in + i)));
+				break;
+			case cgltf_component_type_r_16:
+				v = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)((const int16_t*)in + i)));
+				break;
+			case cgltf_component_type_r_16u:
+				v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)((const uint16_t*)in + i)));
+				break;
+			default:
+				return i;
+		}
+		_mm256_storeu_ps(out + i, _mm256_div_ps(_mm256_cvtepi32_ps(v), d));
+	}
+#elif defined(CGLTF_SIMD_SSE2)
+	const __m128 d = _mm_set1_ps(divisor);
+	const __m128i zero = _mm_setzero_si128();
+
+	for (; i + 8 <= n; i += 8)
+	{
+		__m128i lo, hi;
+		switch (component_type)
+		{
+			case cgltf_component_type_r_8:
+			{
+				__m128i v = _mm_loadl_epi64((const __m128i*)((const int8_t*)in + i));
+				v = _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8);
+				lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+				hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+				break;
+			}
+			case cgltf_component_type_r_8u:
+			{
+				__m128i v = _mm_loadl_epi64((const __m128i*)((const uint8_t*)in + i));
+				v = _mm_unpacklo_epi8(v, zero);
+				lo = _mm_unpacklo_epi16(v, zero);
+				hi = _mm_unpackhi_epi16(v, zero);
+				break;
+			}
+			case cgltf_component_type_r_16:
+			{
+				__m128i v = _mm_loadu_si128((const __m128i*)((const int16_t*)in + i));
+				lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+				hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+				break;
+			}
+			case cgltf_component_type_r_16u:
+			{
+				__m128i v = _mm_loadu_si128((const __m128i*)((const uint16_t*)in + i));
+				lo = _mm_unpacklo_epi16(v, zero);
+				hi = _mm_unpackhi_epi16(v, zero);
+				break;
+			}
+			default:
+				return i;
+		}
+		_mm_storeu_ps(out + i, _mm_div_ps(_mm_cvtepi32_ps(lo), d));
+		_mm_storeu_ps(out + i + 4, _mm_div_ps(_mm_cvtepi32_ps(hi), d));
+	}
+#elif defined(CGLTF_SIMD_NEON)
+	const float32x4_t d = vdupq_n_f32(divisor);
+
+	for (; i + 8 <= n; i += 8)
+	{
+		int32x4_t lo, hi;
+		switch (component_type)
+		{
+			case cgltf_component_type_r_8:
+			{
+				int16x8_t v = vmovl_s8(vld1_s8((const int8_t*)in + i));
+				lo = vmovl_s16(vget_low_s16(v));
+				hi = vmovl_s16(vget_high_s16(v));
+				break;
+			}
+			case cgltf_component_type_r_8u:
+			{
+				uint16x8_t v = vmovl_u8(vld1_u8((const uint8_t*)in + i));
+				lo = vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(v)));
+				hi = vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(v)));
+				break;
+			}
+			case cgltf_component_type_r_16:
+			{
+				int16x8_t v = vld1q_s16((const int16_t*)in + i);
+				lo = vmovl_s16(vget_low_s16(v));
+				hi = vmovl_s16(vget_high_s16(v));
+				break;
+			}
+			case cgltf_component_type_r_16u:
+			{
+				uint16x8_t v = vld1q_u16((const uint16_t*)in + i);
+				lo = vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(v)));
+				hi = vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(v)));
+				break;
+			}
+			default:
+				return i;
+		}
+		vst1q_f32(out + i, vdivq_f32(vcvtq_f32_s32(lo), d));
+		vst1q_f32(out + i + 4, vdivq_f32(vcvtq_f32_s32(hi), d));
+	}
+#else
+	(void)in;
+	(void)component_type;
+	(void)n;
+	(void)divisor;
+	(void)out;
+#endif
+
+	return i;
+}
+
+/* Converts count elements of num_components each; the conversions match cgltf_component_read_float exactly.
+ * Tightly packed data goes through the SIMD kernels, or one flat loop that the compiler can vectorize. */
+#define CGLTF_UNPACK_COMPONENTS(type_, divisor_) \
+	if (stride == sizeof(type_) * num_components) \
+	{ \
+		const type_* components = (const type_*)in; \
+		cgltf_size i = cgltf_unpack_components_simd(in, component_type, count * num_components, (divisor_), out); \
+		for (; i < count * num_components; ++i) \
+		{ \
+			out[i] = (cgltf_float)components[i] / (divisor_); \
+		} \
+	} \
+	else \
+	{ \
+		for (cgltf_size i = 0; i < count; ++i) \
+		{ \
+			const type_* components = (const type_*)(in + stride * i); \
+			for (cgltf_size j = 0; j < num_components; ++j) \
+			{ \
+				out[i * num_components + j] = (cgltf_float)components[j] / (divisor_); \
+			} \
+		} \
+	}
+
+static void cgltf_unpack_components_float(const uint8_t* in, cgltf_size stride, cgltf_size count, cgltf_size num_components, cgltf_component_type component_type, cgltf_bool normalized, cgltf_float* out)
+{
+	switch (component_type)
+	{
+		case cgltf_component_type_r_32f:
+			if (stride == sizeof(cgltf_float) * num_components)
+			{
+				memcpy(out, in, count * num_components * sizeof(cgltf_float));
+			}
+			else
+			{
+				for (cgltf_size i = 0; i < count; ++i)
+				{
+					memcpy(out + i * num_components, in + stride * i, num_components * sizeof(cgltf_float));
+				}
+			}
+			break;
+		case cgltf_component_type_r_32u:
+			CGLTF_UNPACK_COMPONENTS(uint32_t, normalized ? (float) UINT_MAX : 1.0f)
+			break;
+		case cgltf_component_type_r_16:
+			CGLTF_UNPACK_COMPONENTS(int16_t, normalized ? (float) SHRT_MAX : 1.0f)
+			break;
+		case cgltf_component_type_r_16u:
+			CGLTF_UNPACK_COMPONENTS(uint16_t, normalized ? (float) USHRT_MAX : 1.0f)
+			break;
+		case cgltf_component_type_r_8:
+			CGLTF_UNPACK_COMPONENTS(int8_t, normalized ? (float) SCHAR_MAX : 1.0f)
+			break;
+		case cgltf_component_type_r_8u:
+		case cgltf_component_type_invalid:
+		default:
+			CGLTF_UNPACK_COMPONENTS(uint8_t, normalized ? (float) UCHAR_MAX : 1.0f)
+			break;
+	}
+}
+
+cgltf_size cgltf_accessor_unpack_floats(const cgltf_accessor* accessor, cgltf_float* out, cgltf_size float_count)
+{
+	return cgltf_accessor_unpack_floats_range(accessor, 0, accessor->count, out, float_count);
+}
+
+cgltf_size cgltf_accessor_unpack_floats_range(const cgltf_accessor* accessor, cgltf_size first, cgltf_size count, cgltf_float* out, cgltf_size float_count)
+{
+	cgltf_size num_components = cgltf_num_components(accessor->type);
+
+	first = first < accessor->count ? first : accessor->count;
+	count = count < accessor->count - first ? count : accessor->count - first;
+
+	if (out == NULL)
+	{
+		return count * num_components;
+	}
+
+	const cgltf_accessor_sparse* sparse = &accessor->sparse;
+	const uint8_t* sparse_indices = accessor->is_sparse ? cgltf_sparse_indices_data(sparse) : NULL;
+	const uint8_t* sparse_values = accessor->is_sparse ? cgltf_sparse_values_data(sparse) : NULL;
+
+	if (accessor->is_sparse && (!sparse_indices || !sparse_values))
+	{
+		return 0;
+	}
+
+	if (accessor->buffer_view ? accessor->buffer_view->buffer->data == NULL : !accessor->is_sparse)
+	{
+		return 0;
+	}
+
+	count = count < float_count / num_components ? count : float_count / num_components;
+
+	cgltf_size component_size = cgltf_component_size(accessor->component_type);
+
+	// Matrices with padded columns are rare and take the per-element path, see cgltf_element_read_float
+	cgltf_bool padded = (accessor->type == cgltf_type_mat2 && component_size == 1) || (accessor->type == cgltf_type_mat3 && component_size <= 2);
+
+	if (accessor->buffer_view == NULL)
+	{
+		memset(out, 0, count * num_components * sizeof(cgltf_float));
+	}
+	else
+	{
+		cgltf_size offset = accessor->offset + accessor->buffer_view->offset;
+		const uint8_t* element = (const uint8_t*) accessor->buffer_view->buffer->data;
+		element += offset + accessor->stride * first;
+
+		if (padded)
+		{
+			for (cgltf_size i = 0; i < count; ++i)
+			{
+				cgltf_element_read_float(element + accessor->stride * i, accessor->type, accessor->component_type, accessor->normalized, out + i * num_components, num_components);
+			}
+		}
+		else
+		{
+			cgltf_unpack_components_float(element, accessor->stride, count, num_components, accessor->component_type, accessor->normalized, out);
+		}
+	}
+
+	if (accessor->is_sparse)
+	{
+		cgltf_size indices_component_size = cgltf_component_size(sparse->indices_component_type);
+		cgltf_size element_size = cgltf_calc_size(accessor->type, accessor->component_type);
+
+		for (cgltf_size position = cgltf_sparse_lower_bound(sparse_indices, sparse->indices_component_type, sparse->count, first); position < sparse->count; ++position)
+		{
+			cgltf_size index = cgltf_component_read_index(sparse_indices + indices_component_size * position, sparse->indices_component_type);
+			if (index >= first + count)
+			{
+				break;
+			}
+
+			const uint8_t* value = sparse_values + element_size * position;
+			cgltf_float* target = out + (index - first) * num_components;
+
+			if (padded)
+			{
+				cgltf_element_read_float(value, accessor->type, accessor->component_type, accessor->normalized, target, num_components);
+			}
+			else
+			{
+				cgltf_unpack_components_float(value, element_size, 1, num_components, accessor->component_type, accessor->normalized, target);
+			}
+		}
+	}
+
+	return count * num_components;
+}
+
+#define CGLTF_UNPACK_INDICES(in_type_, out_type_) \
+	for (cgltf_size i = 0; i < count; ++i) \
+	{ \
+		((out_type_*)out)[i] = *(const in_type_*)(in + stride * i); \
+	}
+
+cgltf_size cgltf_accessor_unpack_indices(const cgltf_accessor* accessor, void* out, cgltf_size out_component_size, cgltf_size index_count)
+{
+	if (out == NULL)
+	{
+		return accessor->count;
+	}
+
+	if (accessor->is_sparse || accessor->buffer_view == NULL || accessor->buffer_view->buffer->data == NULL || accessor->type != cgltf_type_scalar)
+	{
+		return 0;
+	}
+
+	cgltf_size component_size;
+	switch (accessor->component_type)
+	{
+		case cgltf_component_type_r_8u:
+		case cgltf_component_type_r_16u:
+		case cgltf_component_type_r_32u:
+			component_size = cgltf_component_size(accessor->component_type);
+			break;
+		default:
+			return 0;
+	}
+
+	if (out_component_size < component_size || (out_component_size != 1 && out_component_size != 2 && out_component_size != 4))
+	{
+		return 0;
+	}
+
+	cgltf_size count = index_count < accessor->count ? index_count : accessor->count;
+	cgltf_size stride = accessor->stride;
+
+	const uint8_t* in = (const uint8_t*) accessor->buffer_view->buffer->data;
+	in += accessor->offset + accessor->buffer_view->offset;
+
+	if (out_component_size == component_size)
+	{
+		if (stride == component_size)
+		{
+			memcpy(out, in, count * component_size);
+			return count;
+		}
+
+		for (cgltf_size i = 0; i < count; ++i)
+		{
+			memcpy((uint8_t*)out + i * component_size, in + stride * i, component_size);
+		}
+		return count;
+	}
+
+	if (component_size == 1 && out_component_size == 2)
+	{
+		CGLTF_UNPACK_INDICES(uint8_t, uint16_t)
+	}
+	else if (component_size == 1)
+	{
+		CGLTF_UNPACK_INDICES(uint8_t, uint32_t)
+	}
+	else
+	{
+		CGLTF_UNPACK_INDICES(uint16_t, uint32_t)
+	}
+
+	return count;
+}
+
+#ifndef CGLTF_VERTEX_BLOCK_SIZE
+#define CGLTF_VERTEX_BLOCK_SIZE 64
+#endif
+
+/* Rounds to nearest after clamping to [lo, hi], which both are representable in the output type */
+static double cgltf_round_clamped(double value, double lo, double hi)
+{
+	value = value < lo ? lo : value;
+	value = value > hi ? hi : value;
+	return value < 0 ? -(double)(cgltf_size)(-value + 0.5) : (double)(cgltf_size)(value + 0.5);
+}
+
+static void cgltf_component_write_float(uint8_t* out, cgltf_component_type component_type, cgltf_bool normalized, cgltf_float value)
+{
+	/* NaN becomes zero, like missing data */
+	double v = value == value ? (double)value : 0.0;
+
+	switch (component_type)
+	{
+		case cgltf_component_type_r_32f:
+		{
+			cgltf_float f = (cgltf_float)v;
+			memcpy(out, &f, sizeof(f));
+			break;
+		}
+		case cgltf_component_type_r_32u:
+		{
+			uint32_t u = (uint32_t)cgltf_round_clamped(normalized ? v * UINT_MAX : v, 0, UINT_MAX);
+			memcpy(out, &u, sizeof(u));
+			break;
+		}
+		case cgltf_component_type_r_16:
+		{
+			int16_t s = (int16_t)cgltf_round_clamped(normalized ? v * SHRT_MAX : v, normalized ? -SHRT_MAX : SHRT_MIN, SHRT_MAX);
+			memcpy(out, &s, sizeof(s));
+			break;
+		}
+		case cgltf_component_type_r_16u:
+		{
+			uint16_t u = (uint16_t)cgltf_round_clamped(normalized ? v * USHRT_MAX : v, 0, USHRT_MAX);
+			memcpy(out, &u, sizeof(u));
+			break;
+		}
+		case cgltf_component_type_r_8:
+			*(int8_t*)out = (int8_t)cgltf_round_clamped(normalized ? v * SCHAR_MAX : v, normalized ? -SCHAR_MAX : SCHAR_MIN, SCHAR_MAX);
+			break;
+		case cgltf_component_type_r_8u:
+		case cgltf_component_type_invalid:
+		default:
+			*out = (uint8_t)cgltf_round_clamped(normalized ? v * UCHAR_MAX : v, 0, UCHAR_MAX);
+			break;
+	}
+}
+
+static const cgltf_accessor* cgltf_find_attribute_data(const cgltf_primitive* primitive, cgltf_attribute_type type, cgltf_int index)
+{
+	for (cgltf_size i = 0; i < primitive->attributes_count; ++i)
+	{
+		if (primitive->attributes[i].type == type && primitive->attributes[i].index == index)
+		{
+			return primitive->attributes[i].data;
+		}
+	}
+
+	return NULL;
+}
+
+/* Elements can be copied byte for byte when the accessor stores exactly the requested format */
+static cgltf_bool cgltf_vertex_element_is_direct(const cgltf_vertex_element* element, const cgltf_accessor* accessor)
+{
+	return accessor && !accessor->is_sparse && accessor->buffer_view &&
+		accessor->type == element->type && accessor->component_type == element->component_type &&
+		(accessor->normalized == element->normalized || element->component_type == cgltf_component_type_r_32f) &&
+		element->type != cgltf_type_mat2 && element->type != cgltf_type_mat3 && element->type != cgltf_type_mat4;
+}
+
+cgltf_size cgltf_primitive_write_vertices(const cgltf_primitive* primitive, const cgltf_vertex_layout* layout, void* out, cgltf_size vertex_count)
+{
+	cgltf_size count = primitive->attributes_count ? primitive->attributes[0].data->count : 0;
+
+	if (out == NULL)
+	{
+		return count;
+	}
+
+	count = count < vertex_count ? count : vertex_count;
+
+	const cgltf_accessor* accessors[CGLTF_VERTEX_ELEMENTS_MAX];
+	cgltf_bool all_direct = layout->elements_count > 0;
+	const cgltf_buffer_view* shared_view = NULL;
+	cgltf_size shared_base = 0;
+
+	if (layout->elements_count > CGLTF_VERTEX_ELEMENTS_MAX)
+	{
+		return 0;
+	}
+
+	for (cgltf_size e = 0; e < layout->elements_count; ++e)
+	{
+		const cgltf_vertex_element* element = &layout->elements[e];
+		cgltf_size num_components = cgltf_num_components(element->type);
+
+		if (num_components > 16 || element->offset + num_components * cgltf_component_size(element->component_type) > layout->stride)
+		{
+			return 0;
+		}
+
+		const cgltf_accessor* accessor = cgltf_find_attribute_data(primitive, element->attribute_type, element->index);
+
+		if (accessor && (accessor->count < count || (accessor->buffer_view && accessor->buffer_view->buffer->data == NULL)))
+		{
+			return 0;
+		}
+
+		accessors[e] = accessor;
+
+		/* The whole vertex range is one copy when the source is interleaved with the same stride and relative offsets */
+		if (!cgltf_vertex_element_is_direct(element, accessor) || accessor->stride != layout->stride ||
+			accessor->offset < element->offset || (shared_view && (accessor->buffer_view != shared_view || accessor->offset - element->offset != shared_base)))
+		{
+			all_direct = 0;
+		}
+		else
+		{
+			shared_view = accessor->buffer_view;
+			shared_base = accessor->offset - element->offset;
+		}
+	}
+
+	uint8_t* dest = (uint8_t*)out;
+
+	if (all_direct && count > 0 && shared_base + layout->stride * count <= shared_view->size)
+	{
+		memcpy(dest, (const uint8_t*)shared_view->buffer->data + shared_view->offset + shared_base, layout->stride * count);
+		return count;
+	}
+
+	cgltf_float floats[CGLTF_VERTEX_BLOCK_SIZE * 16];
+
+	/* Every block of vertices is completed before moving on, so the output is written while it is in cache */
+	for (cgltf_size first = 0; first < count; first += CGLTF_VERTEX_BLOCK_SIZE)
+	{
+		cgltf_size block = count - first < CGLTF_VERTEX_BLOCK_SIZE ? count - first : CGLTF_VERTEX_BLOCK_SIZE;
+		uint8_t* block_dest = dest + layout->stride * first;
+
+		for (cgltf_size e = 0; e < layout->elements_count; ++e)
+		{
+			const cgltf_vertex_element* element = &layout->elements[e];
+			const cgltf_accessor* accessor = accessors[e];
+			cgltf_size num_components = cgltf_num_components(element->type);
+			cgltf_size component_size = cgltf_component_size(element->component_type);
+			uint8_t* target = block_dest + element->offset;
+
+			if (cgltf_vertex_element_is_direct(element, accessor))
+			{
+				const uint8_t* source = (const uint8_t*)accessor->buffer_view->buffer->data + accessor->buffer_view->offset + accessor->offset + accessor->stride * first;
+
+				for (cgltf_size i = 0; i < block; ++i)
+				{
+					memcpy(target + layout->stride * i, source + accessor->stride * i, num_components * component_size);
+				}
+				continue;
+			}
+
+			cgltf_size source_components = accessor ? cgltf_num_components(accessor->type) : 0;
+
+			if (accessor && cgltf_accessor_unpack_floats_range(accessor, first, block, floats, block * source_components) != block * source_components)
+			{
+				return 0;
+			}
+
+			for (cgltf_size i = 0; i < block; ++i)
+			{
+				for (cgltf_size j = 0; j < num_components; ++j)
+				{
+					/* Missing components default to (0, 0, 0, 1) */
+					cgltf_float value = j < source_components ? floats[i * source_components + j] : (j == 3 ? 1.0f : 0.0f);
+					cgltf_component_write_float(target + layout->stride * i + component_size * j, element->component_type, element->normalized, value);
+				}
+			}
+		}
+	}
+
+	return count;
+}
+
+#define CGLTF_ERROR_JSON -1
+#define CGLTF_ERROR_NOMEM -2
+
+#define CGLTF_CHECK_TOKTYPE(tok_, type_) if ((tok_).type != (type_)) { return CGLTF_ERROR_JSON; }
+#define CGLTF_CHECK_KEY(tok_) if ((tok_).type != JSMN_STRING || (tok_).size == 0) { return CGLTF_ERROR_JSON; } /* checking size for 0 verifies that a value follows the key */
+
+#define CGLTF_PTRINDEX(type, idx) (type*)(cgltf_size)(idx + 1)
+#define CGLTF_PTRFIXUP(var, data, size) if (var) { if ((cgltf_size)var > size) { return CGLTF_ERROR_JSON; } var = &data[(cgltf_size)var-1]; }
+#define CGLTF_PTRFIXUP_SECTION(var, data, size, sections, section) if (!((sections) & (section))) { var = NULL; } else { CGLTF_PTRFIXUP(var, data, size) }
+#define CGLTF_PTRFIXUP_REQ(var, data, size) if (!var || (cgltf_size)var > size) { return CGLTF_ERROR_JSON; } var = &data[(cgltf_size)var-1];
+
+/* Compares a key token with a string literal. The length comes from sizeof and is checked inline together
+ * with the first character, so a mismatching key is rejected with a couple of integer compares and no call. */
+#define cgltf_json_strcmp(tok_, json_chunk_, str_) \
+	(((tok_)->type == JSMN_STRING && (size_t)((tok_)->end - (tok_)->start) == sizeof("" str_) - 1 && \
+		(json_chunk_)[(tok_)->start] == (uint8_t)(str_)[0]) ? \
+		memcmp((json_chunk_) + (tok_)->start, (str_), sizeof(str_) - 1) : 128)
+
+static int cgltf_json_to_int(jsmntok_t const* tok, const uint8_t* json_chunk)
+{
+	CGLTF_CHECK_TOKTYPE(*tok, JSMN_PRIMITIVE);
+	const uint8_t* p = json_chunk + tok->start;
+	const uint8_t* end = json_chunk + tok->end;
+
+	// Same result as atoi for the values that fit: parse an optional sign and digits, then stop at the first other character
+	cgltf_bool negative = p < end && *p == '-';
+	p += (p < end && (*p == '-' || *p == '+'));
+
+	unsigned int value = 0;
+	for (; p < end && *p >= '0' && *p <= '9'; ++p)
+	{
+		value = value * 10 + (unsigned int)(*p - '0');
+	}
+
+	return negative ? -(int)value : (int)value;
+}
+
+static cgltf_float cgltf_json_to_float(jsmntok_t const* tok, const uint8_t* json_chunk)
+{
+	CGLTF_CHECK_TOKTYPE(*tok, JSMN_PRIMITIVE);
+	const uint8_t* p = json_chunk + tok->start;
+	const uint8_t* end = json_chunk + tok->end;
+
+	cgltf_bool negative = p < end && *p == '-';
+	p += (p < end && (*p == '-' || *p == '+'));
+
+	uint64_t mantissa = 0;
+	int digits = 0;
+	int exponent = 0;
+
+	for (; p < end && *p >= '0' && *p <= '9'; ++p)
+	{
+		mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+		digits += (mantissa != 0);
+	}
+
+	if (p < end && *p == '.')
+	{
+		for (++p; p < end && *p >= '0' && *p <= '9'; ++p)
+		{
+			mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+			digits += (mantissa != 0);
+			--exponent;
+		}
+	}
+
+	if (p < end && (*p == 'e' || *p == 'E'))
+	{
+		++p;
+		cgltf_bool exponent_negative = p < end && *p == '-';
+		p += (p < end && (*p == '-' || *p == '+'));
+
+		int explicit_exponent = 0;
+		for (; p < end && *p >= '0' && *p <= '9' && explicit_exponent < 10000; ++p)
+		{
+			explicit_exponent = explicit_exponent * 10 + (*p - '0');
+		}
+
+		exponent += exponent_negative ? -explicit_exponent : explicit_exponent;
+	}
+
+	// When the mantissa and the power of ten are both exact doubles, a single multiplication or division
+	// rounds correctly, so this matches atof; everything else (long mantissas, large exponents) uses strtod.
+	static const double powers_of_ten[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+	};
+
+	if (p == end && digits <= 19 && mantissa <= ((uint64_t)1 << 53) && exponent >= -22 && exponent <= 22)
+	{
+		double value = (double)mantissa;
+		value = exponent < 0 ? value / powers_of_ten[-exponent] : value * powers_of_ten[exponent];
+		return (cgltf_float)(negative ? -value : value);
+	}
+
+	char tmp[128];
+	int size = (cgltf_size)(tok->end - tok->start) < sizeof(tmp) ? tok->end - tok->start : sizeof(tmp) - 1;
+	strncpy(tmp, (const char*)json_chunk + tok->start, size);
+	tmp[size] = 0;
+	return (cgltf_float)strtod(tmp, NULL);
+}
+
+static cgltf_bool cgltf_json_to_bool(jsmntok_t const* tok, const uint8_t* json_chunk)
+{
+	int size = tok->end - tok->start;
+	return size == 4 && memcmp(json_chunk + tok->start, "true", 4) == 0;
+}
+
+static int cgltf_skip_json(jsmntok_t const* tokens, int i)
+{
+	if (tokens[i].type == JSMN_ARRAY)
+	{
+		int size = tokens[i].size;
+		++i;
+		for (int j = 0; j < size; ++j)
+		{
+			i = cgltf_skip_json(tokens, i);
+			if (i < 0)
+			{
+				return i;
+			}
+		}
+	}
+	else if (tokens[i].type == JSMN_OBJECT)
+	{
+		int size = tokens[i].size;
+		++i;
+		for (int j = 0; j < size; ++j)
+		{
+			CGLTF_CHECK_KEY(tokens[i]);
+			++i;
+			i = cgltf_skip_json(tokens, i);
+			if (i < 0)
+			{
+				return i;
+			}
+		}
+	}
+	else if (tokens[i].type == JSMN_PRIMITIVE
+		 || tokens[i].type == JSMN_STRING)
+	{
+		return i + 1;
+	}
+	return i;
+}
+
+static void cgltf_fill_float_array(float* out_array, int size, float value)
+{
+	for (int j = 0; j < size; ++j)
+	{
+		out_array[j] = value;
+	}
+}
+
+static int cgltf_parse_json_float_array(jsmntok_t const* tokens, int i, const uint8_t* json_chunk, float* out_array, int size)
+{
+	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_ARRAY);
+	if (tokens[i].size != size)
+	{
+		return CGLTF_ERROR_JSON;
+	}
+	++i;
+	for (int j = 0; j < size; ++j)
+	{
+		CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_PRIMITIVE);
+		out_array[j] = cgltf_json_to_float(tokens + i, json_chunk);
+		++i;
+	}
+	return i;
+}
+
+static int cgltf_parse_json_string(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, char** out_string)
+{
+	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_STRING);
+	if (*out_string)
+	{
+		return CGLTF_ERROR_JSON;
+	}
+	int size = tokens[i].end - tokens[i].start;
+	if (options->strings_in_place)
+	{
+		// json_chunk is the writable copy made by cgltf_parse_json; this overwrites the closing quote
+		char* result = (char*)json_chunk + tokens[i].start;
+		result[size] = 0;
+		*out_string = result;
+		return i + 1;
+	}
+	char* result = (char*)options->memory_alloc(options->memory_user_data, size + 1);
+	if (!result)
+	{
+		return CGLTF_ERROR_NOMEM;
+	}
+	strncpy(result, (const char*)json_chunk + tokens[i].start, size);
+	result[size] = 0;
+	*out_string = result;
+	return i + 1;
+}
+
+static int cgltf_parse_json_array(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, size_t element_size, void** out_array, cgltf_size* out_size)
+{
+	(void)json_chunk;
+	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_ARRAY);
+	if (*out_array)
+	{
+		return CGLTF_ERROR_JSON;
+	}
+	int size = tokens[i].size;
+	void* result = cgltf_calloc(options, element_size, size);
+	if (!result)
+	{
+		return CGLTF_ERROR_NOMEM;
+	}
+	*out_array = result;
+	*out_size = size;
+	return i + 1;
+}
+
+typedef int (*cgltf_parse_json_element)(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, void* out_element);
+
+typedef struct cgltf_parse_elements_job
+{
+	cgltf_options* options;
+	jsmntok_t const* tokens;
+	const uint8_t* json_chunk;
+	cgltf_parse_json_element parse;
+	uint8_t* elements;
+	size_t element_size;
+	const int* starts;
+	cgltf_options* batch_options; /* one per batch with its own counting allocator, so that stats are not shared between threads */
+} cgltf_parse_elements_job;
+
+static int cgltf_parse_elements_task(void* user, cgltf_size index)
+{
+	cgltf_parse_elements_job* job = (cgltf_parse_elements_job*)user;
+	cgltf_options* options = job->batch_options ? &job->batch_options[index / CGLTF_PARALLEL_BATCH_SIZE] : job->options;
+	int i = job->parse(options, job->tokens, job->starts[index], job->json_chunk, job->elements + index * job->element_size);
+	return (i < 0 || i == job->starts[index + 1]) ? i : CGLTF_ERROR_JSON;
+}
+
+/* Parses the elements of an array whose tokens start at i; in parallel mode, the token ranges of the elements are
+ * found with cgltf_skip_json first, so that the elements can be parsed independently */
+static int cgltf_parse_json_elements(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_parse_json_element parse, void* elements, size_t element_size, cgltf_size count)
+{
+	if (!cgltf_parallel_enabled(options, count))
+	{
+		for (cgltf_size j = 0; j < count; ++j)
+		{
+			i = parse(options, tokens, i, json_chunk, (uint8_t*)elements + j * element_size);
+			if (i < 0)
+			{
+				return i;
+			}
+		}
+		return i;
+	}
+
+	int* starts = (int*)options->memory_alloc(options->memory_user_data, (count + 1) * sizeof(int));
+
+	cgltf_size batches = (count + CGLTF_PARALLEL_BATCH_SIZE - 1) / CGLTF_PARALLEL_BATCH_SIZE;
+	cgltf_size batch_size = batches * (sizeof(cgltf_stats) + sizeof(cgltf_stats_allocator) + sizeof(cgltf_options));
+	const cgltf_stats_allocator* counter = options->memory_alloc == &cgltf_stats_counting_alloc ? (const cgltf_stats_allocator*)options->memory_user_data : NULL;
+	cgltf_stats* batch_stats = NULL;
+
+	if (starts && counter)
+	{
+		batch_stats = (cgltf_stats*)options->memory_alloc(options->memory_user_data, batch_size);
+	}
+
+	if (!starts || (counter && !batch_stats))
+	{
+		options->memory_free(options->memory_user_data, starts);
+		cgltf_options serial_options = *options;
+		serial_options.parallel_for = NULL;
+		return cgltf_parse_json_elements(&serial_options, tokens, i, json_chunk, parse, elements, element_size, count);
+	}
+
+	cgltf_stats_allocator* batch_counters = batch_stats ? (cgltf_stats_allocator*)(batch_stats + batches) : NULL;
+	cgltf_options* batch_options = batch_stats ? (cgltf_options*)(batch_counters + batches) : NULL;
+
+	for (cgltf_size j = 0; batch_options && j < batches; ++j)
+	{
+		memset(&batch_stats[j], 0, sizeof(cgltf_stats));
+		batch_counters[j] = *counter;
+		batch_counters[j].stats = &batch_stats[j];
+		batch_options[j] = *options;
+		batch_options[j].memory_user_data = &batch_counters[j];
+		batch_options[j].stats = &batch_stats[j];
+	}
+
+	for (cgltf_size j = 0; j < count && i >= 0; ++j)
+	{
+		starts[j] = i;
+		i = cgltf_skip_json(tokens, i);
+	}
+
+	int result = i;
+	if (i >= 0)
+	{
+		starts[count] = i;
+
+		cgltf_parse_elements_job job;
+		job.options = options;
+		job.tokens = tokens;
+		job.json_chunk = json_chunk;
+		job.parse = parse;
+		job.elements = (uint8_t*)elements;
+		job.element_size = element_size;
+		job.starts = starts;
+		job.batch_options = batch_options;
+		result = cgltf_run_elements(options, count, &cgltf_parse_elements_task, &job);
+	}
+
+	for (cgltf_size j = 0; batch_stats && j < batches; ++j)
+	{
+		counter->stats->allocations_count += batch_stats[j].allocations_count;
+		counter->stats->allocations_size += batch_stats[j].allocations_size;
+	}
+
+	options->memory_free(options->memory_user_data, batch_stats);
+	options->memory_free(options->memory_user_data, starts);
+	return result < 0 ? result : i;
+}
+
+static int cgltf_parse_json_string_array(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, char*** out_array, cgltf_size* out_size)
+{
+    CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_ARRAY);
+    i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(char*), (void**)out_array, out_size);
+
+    for (cgltf_size j = 0; j < *out_size; ++j)
+    {
+        i = cgltf_parse_json_string(options, tokens, i, json_chunk, j + (*out_array));
+        if (i < 0)
+        {
+            return i;
+        }
+    }
+    return i;
+}
+
+static void cgltf_parse_attribute_type(const char* name, cgltf_attribute_type* out_type, int* out_index)
+{
+	const char* us = strchr(name, '_');
+	size_t len = us ? us - name : strlen(name);
+
+	if (len == 8 && strncmp(name, "POSITION", 8) == 0)
+	{
+		*out_type = cgltf_attribute_type_position;
+	}
+	else if (len == 6 && strncmp(name, "NORMAL", 6) == 0)
+	{
+		*out_type = cgltf_attribute_type_normal;
+	}
+	else if (len == 7 && strncmp(name, "TANGENT", 7) == 0)
+	{
+		*out_type = cgltf_attribute_type_tangent;
+	}
+	else if (len == 8 && strncmp(name, "TEXCOORD", 8) == 0)
+	{
+		*out_type = cgltf_attribute_type_texcoord;
+	}
+	else if (len == 5 && strncmp(name, "COLOR", 5) == 0)
+	{
+		*out_type = cgltf_attribute_type_color;
+	}
+	else if (len == 6 && strncmp(name, "JOINTS", 6) == 0)
+	{
+		*out_type = cgltf_attribute_type_joints;
+	}
+	else if (len == 7 && strncmp(name, "WEIGHTS", 7) == 0)
+	{
+		*out_type = cgltf_attribute_type_weights;
+	}
+	else
+	{
+		*out_type = cgltf_attribute_type_invalid;
+	}
+
+	if (us && *out_type != cgltf_attribute_type_invalid)
+	{
+		*out_index = atoi(us + 1);
+	}
+}
+
+static int cgltf_parse_json_attribute_list(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_attribute** out_attributes, cgltf_size* out_attributes_count)
+{
+	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+
+	if (*out_attributes)
+	{
+		return CGLTF_ERROR_JSON;
+	}
+
+	*out_attributes_count = tokens[i].size;
+	*out_attributes = (cgltf_attribute*)cgltf_calloc(options, sizeof(cgltf_attribute), *out_attributes_count);
+	++i;
+
+	if (!*out_attributes)
+	{
+		return CGLTF_ERROR_NOMEM;
+	}
+
+	for (cgltf_size j = 0; j < *out_attributes_count; ++j)
+	{
+		CGLTF_CHECK_KEY(tokens[i]);
+
+		i = cgltf_parse_json_string(options, tokens, i, json_chunk, &(*out_attributes)[j].name);
+		if (i < 0)
+		{
+			return CGLTF_ERROR_JSON;
+		}
+
+		cgltf_parse_attribute_type((*out_attributes)[j].name, &(*out_attributes)[j].type, &(*out_attributes)[j].index);
+
+		(*out_attributes)[j].data = CGLTF_PTRINDEX(cgltf_accessor, cgltf_json_to_int(tokens + i, json_chunk));
+		++i;
+	}
+
+	return i;
+}
+
+static int cgltf_parse_json_extras(jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_extras* out_extras)
+{
+	(void)json_chunk;
+	out_extras->start_offset = tokens[i].start;
+	out_extras->end_offset = tokens[i].end;
+	i = cgltf_skip_json(tokens, i);
+	return i;
+}
+
+static int cgltf_parse_json_primitive(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_primitive* out_prim)
+{
+	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+
+	out_prim->type = cgltf_primitive_type_triangles;
+
+	int size = tokens[i].size;
+	++i;
+
+	for (int j = 0; j < size; ++j)
+	{
+		CGLTF_CHECK_KEY(tokens[i]);
+
+		if (cgltf_json_strcmp(tokens+i, json_chunk, "mode") == 0)
+		{
+			++i;
+			out_prim->type
+					= (cgltf_primitive_type)
+					cgltf_json_to_int(tokens+i, json_chunk);
+			++i;
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "indices") == 0)
+		{
+			++i;
+			out_prim->indices = CGLTF_PTRINDEX(cgltf_accessor, cgltf_json_to_int(tokens + i, json_chunk));
+			++i;
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "material") == 0)
+		{
+			++i;
+			out_prim->material = CGLTF_PTRINDEX(cgltf_material, cgltf_json_to_int(tokens + i, json_chunk));
+			++i;
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "attributes") == 0)
+		{
+			i = cgltf_parse_json_attribute_list(options, tokens, i + 1, json_chunk, &out_prim->attributes, &out_prim->attributes_count);
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "targets") == 0)
+		{
+			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_morph_target), (void**)&out_prim->targets, &out_prim->targets_count);
+			if (i < 0)
+			{
+				return i;
+			}
+
+			for (cgltf_size k = 0; k < out_prim->targets_count; ++k)
+			{
+				i = cgltf_parse_json_attribute_list(options, tokens, i, json_chunk, &out_prim->targets[k].attributes, &out_prim->targets[k].attributes_count);
+				if (i < 0)
+				{
+					return i;
+				}
+			}
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		{
+			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_prim->extras);
+		}
+		else
+		{
+			i = cgltf_skip_json(tokens, i+1);
+		}
+
+		if (i < 0)
+		{
+			return i;
+		}
+	}
+
+	return i;
+}
+
+static int cgltf_parse_json_mesh(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_mesh* out_mesh)
+{
+	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+
+	int size = tokens[i].size;
+	++i;
+
+	for (int j = 0; j < size; ++j)
+	{
+		CGLTF_CHECK_KEY(tokens[i]);
+
+		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
+		{
+			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_mesh->name);
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "primitives") == 0)
+		{
+			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_primitive), (void**)&out_mesh->primitives, &out_mesh->primitives_count);
+			if (i < 0)
+			{
+				return i;
+			}
+
+			for (cgltf_size prim_index = 0; prim_index < out_mesh->primitives_count; ++prim_index)
+			{
+				i = cgltf_parse_json_primitive(options, tokens, i, json_chunk, &out_mesh->primitives[prim_index]);
+				if (i < 0)
+				{
+					return i;
+				}
+			}
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "weights") == 0)
+		{
+			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_float), (void**)&out_mesh->weights, &out_mesh->weights_count);
+			if (i < 0)
+			{
+				return i;
+			}
+
+			i = cgltf_parse_json_float_array(tokens, i - 1, json_chunk, out_mesh->weights, (int)out_mesh->weights_count);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		{
+			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_mesh->extras);
+		}
+		else
+		{
+			i = cgltf_skip_json(tokens, i+1);
+		}
+
+		if (i < 0)
+		{
+			return i;
+		}
+	}
+
+	return i;
+}
+
+static int cgltf_parse_json_mesh_element(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, void* out_element)
+{
+	return cgltf_parse_json_mesh(options, tokens, i, json_chunk, (cgltf_mesh*)out_element);
+}
+
+static int cgltf_parse_json_meshes(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
+{
+	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_mesh), (void**)&out_data->meshes, &out_data->meshes_count);
+	if (i < 0)
+	{
+		return i;
+	}
+
+	return cgltf_parse_json_elements(options, tokens, i, json_chunk, &cgltf_parse_json_mesh_element, out_data->meshes, sizeof(cgltf_mesh), out_data->meshes_count);
+}
+
+static cgltf_component_type cgltf_json_to_component_type(jsmntok_t const* tok, const uint8_t* json_chunk)
+{
+	int type = cgltf_json_to_int(tok, json_chunk);
+
+	switch (type)
+	{
+	case 5120:
+		return cgltf_component_type_r_8;
+	case 5121:
+		return cgltf_component_type_r_8u;
+	case 5122:
+		return cgltf_component_type_r_16;
+	case 5123:
+		return cgltf_component_type_r_16u;
+	case 5125:
+		return cgltf_component_type_r_32u;
+	case 5126:
+		return cgltf_component_type_r_32f;
+	default:
+		return cgltf_component_type_invalid;
+	}
+}
+
+static int cgltf_parse_json_accessor_sparse(jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_accessor_sparse* out_sparse)
+{
+	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+
+	int size = tokens[i].size;
+	++i;
+
+	for (int j = 0; j < size; ++j)
+	{
+		CGLTF_CHECK_KEY(tokens[i]);
+
+		if (cgltf_json_strcmp(tokens+i, json_chunk, "count") == 0)
+		{
+			++i;
+			out_sparse->count = cgltf_json_to_int(tokens + i, json_chunk);
+			++i;
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "indices") == 0)
+		{
+			++i;
+			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+
+			int indices_size = tokens[i].size;
+			++i;
+
+			for (int k = 0; k < indices_size; ++k)
+			{
+				CGLTF_CHECK_KEY(tokens[i]);
+
+				if (cgltf_json_strcmp(tokens+i, json_chunk, "bufferView") == 0)
+				{
+					++i;
+					out_sparse->indices_buffer_view = CGLTF_PTRINDEX(cgltf_buffer_view, cgltf_json_to_int(tokens + i, json_chunk));
+					++i;
+				}
+				else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteOffset") == 0)
+				{
+					++i;
+					out_sparse->indices_byte_offset = cgltf_json_to_int(tokens + i, json_chunk);
+					++i;
+				}
+				else if (cgltf_json_strcmp(tokens+i, json_chunk, "componentType") == 0)
+				{
+					++i;
+					out_sparse->indices_component_type = cgltf_json_to_component_type(tokens + i, json_chunk);
+					++i;
+				}
+				else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+				{
+					i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_sparse->indices_extras);
+				}
+				else
+				{
+					i = cgltf_skip_json(tokens, i+1);
+				}
+
+				if (i < 0)
+				{
+					return i;
+				}
+			}
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "values") == 0)
+		{
+			++i;
+			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+
+			int values_size = tokens[i].size;
+			++i;
+
+			for (int k = 0; k < values_size; ++k)
+			{
+				CGLTF_CHECK_KEY(tokens[i]);
+
+				if (cgltf_json_strcmp(tokens+i, json_chunk, "bufferView") == 0)
+				{
+					++i;
+					out_sparse->values_buffer_view = CGLTF_PTRINDEX(cgltf_buffer_view, cgltf_json_to_int(tokens + i, json_chunk));
+					++i;
+				}
+				else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteOffset") == 0)
+				{
+					++i;
+					out_sparse->values_byte_offset = cgltf_json_to_int(tokens + i, json_chunk);
+					++i;
+				}
+				else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+				{
+					i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_sparse->values_extras);
+				}
+				else
+				{
+					i = cgltf_skip_json(tokens, i+1);
+				}
+
+				if (i < 0)
+				{
+					return i;
+				}
+			}
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		{
+			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_sparse->extras);
+		}
+		else
+		{
+			i = cgltf_skip_json(tokens, i+1);
+		}
+
+		if (i < 0)
+		{
+			return i;
+		}
+	}
+
+	return i;
+}
+
+static int cgltf_parse_json_accessor(jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_accessor* out_accessor)
+{
+	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+
+	int size = tokens[i].size;
+	++i;
+
+	for (int j = 0; j < size; ++j)
+	{
+		CGLTF_CHECK_KEY(tokens[i]);
+
+		if (cgltf_json_strcmp(tokens+i, json_chunk, "bufferView") == 0)
+		{
+			++i;
+			out_accessor->buffer_view = CGLTF_PTRINDEX(cgltf_buffer_view, cgltf_json_to_int(tokens + i, json_chunk));
+			++i;
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteOffset") == 0)
+		{
+			++i;
+			out_accessor->offset =
+					cgltf_json_to_int(tokens+i, json_chunk);
+			++i;
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "componentType") == 0)
+		{
+			++i;
+			out_accessor->component_type = cgltf_json_to_component_type(tokens + i, json_chunk);
+			++i;
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "normalized") == 0)
+		{
+			++i;
+			out_accessor->normalized = cgltf_json_to_bool(tokens+i, json_chunk);
+			++i;
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "count") == 0)
+		{
+			++i;
+			out_accessor->count =
+					cgltf_json_to_int(tokens+i, json_chunk);
+			++i;
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "type") == 0)
+		{
+			++i;
+			if (cgltf_json_strcmp(tokens+i, json_chunk, "SCALAR") == 0)
+			{
+				out_accessor->type = cgltf_type_scalar;
+			}
+			else if (cgltf_json_strcmp(tokens+i, json_chunk, "VEC2") == 0)
+			{
+				out_accessor->type = cgltf_type_vec2;
+			}
+			else if (cgltf_json_strcmp(tokens+i, json_chunk, "VEC3") == 0)
+			{
+				out_accessor->type = cgltf_type_vec3;
+			}
+			else if (cgltf_json_strcmp(tokens+i, json_chunk, "VEC4") == 0)
+			{
+				out_accessor->type = cgltf_type_vec4;
+			}
+			else if (cgltf_json_strcmp(tokens+i, json_chunk, "MAT2") == 0)
+			{
+				out_accessor->type = cgltf_type_mat2;
+			}
+			else if (cgltf_json_strcmp(tokens+i, json_chunk, "MAT3") == 0)
+			{
+				out_accessor->type = cgltf_type_mat3;
+			}
+			else if (cgltf_json_strcmp(tokens+i, json_chunk, "MAT4") == 0)
+			{
+				out_accessor->type = cgltf_type_mat4;
+			}
+			++i;
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "min") == 0)
+		{
+			++i;
+			out_accessor->has_min = 1;
+			// note: we can't parse the precise number of elements since type may not have been computed yet
+			int min_size = tokens[i].size > 16 ? 16 : tokens[i].size;
+			i = cgltf_parse_json_float_array(tokens, i, json_chunk, out_accessor->min, min_size);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "max") == 0)
+		{
+			++i;
+			out_accessor->has_max = 1;
+			// note: we can't parse the precise number of elements since type may not have been computed yet
+			int max_size = tokens[i].size > 16 ? 16 : tokens[i].size;
+			i = cgltf_parse_json_float_array(tokens, i, json_chunk, out_accessor->max, max_size);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "sparse") == 0)
+		{
+			out_accessor->is_sparse = 1;
+			i = cgltf_parse_json_accessor_sparse(tokens, i + 1, json_chunk, &out_accessor->sparse);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		{
+			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_accessor->extras);
+		}
+		else
+		{
+			i = cgltf_skip_json(tokens, i+1);
+		}
+
+		if (i < 0)
+		{
+			return i;
+		}
 	}
+
+	return i;
 }
 
-static int cgltf_parse_json_attribute_list(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_attribute** out_attributes, cgltf_size* out_attributes_count)
+static int cgltf_parse_json_texture_transform(jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_texture_transform* out_texture_transform)
 {
 	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
-	if (*out_attributes)
-	{
-		return CGLTF_ERROR_JSON;
-	}
-
-	*out_attributes_count = tokens[i].size;
-	*out_attributes = (cgltf_attribute*)cgltf_calloc(options, sizeof(cgltf_attribute), *out_attributes_count);
+	int size = tokens[i].size;
 	++i;
 
-	if (!*out_attributes)
-	{
-		return CGLTF_ERROR_NOMEM;
-	}
-
-	for (cgltf_size j = 0; j < *out_attributes_count; ++j)
+	for (int j = 0; j < size; ++j)
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		i = cgltf_parse_json_string(options, tokens, i, json_chunk, &(*out_attributes)[j].name);
-		if (i < 0)
+		if (cgltf_json_strcmp(tokens + i, json_chunk, "offset") == 0)
 		{
-			return CGLTF_ERROR_JSON;
+			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_texture_transform->offset, 2);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "rotation") == 0)
+		{
+			++i;
+			out_texture_transform->rotation = cgltf_json_to_float(tokens + i, json_chunk);
+			++i;
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "scale") == 0)
+		{
+			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_texture_transform->scale, 2);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "texCoord") == 0)
+		{
+			++i;
+			out_texture_transform->texcoord = cgltf_json_to_int(tokens + i, json_chunk);
+			++i;
+		}
+		else
+		{
+			i = cgltf_skip_json(tokens, i + 1);
 		}
 
-		cgltf_parse_attribute_type((*out_attributes)[j].name, &(*out_attributes)[j].type, &(*out_attributes)[j].index);
-
-		(*out_attributes)[j].data = CGLTF_PTRINDEX(cgltf_accessor, cgltf_json_to_int(tokens + i, json_chunk));
-		++i;
+		if (i < 0)
+		{
+			return i;
+		}
 	}
 
 	return i;
 }
 
-static int cgltf_parse_json_extras(jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_extras* out_extras)
-{
-	(void)json_chunk;
-	out_extras->start_offset = tokens[i].start;
-	out_extras->end_offset = tokens[i].end;
-	i = cgltf_skip_json(tokens, i);
-	return i;
-}
-
-static int cgltf_parse_json_primitive(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_primitive* out_prim)
+static int cgltf_parse_json_texture_view(jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_texture_view* out_texture_view)
 {
 	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
-	out_prim->type = cgltf_primitive_type_triangles;
+	out_texture_view->scale = 1.0f;
+	cgltf_fill_float_array(out_texture_view->transform.scale, 2, 1.0f);
 
 	int size = tokens[i].size;
 	++i;
@@ -1880,54 +6141,59 @@ static int cgltf_parse_json_primitive(cgltf_options* options, jsmntok_t const* t
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "mode") == 0)
+		if (cgltf_json_strcmp(tokens + i, json_chunk, "index") == 0)
 		{
 			++i;
-			out_prim->type
-					= (cgltf_primitive_type)
-					cgltf_json_to_int(tokens+i, json_chunk);
+			out_texture_view->texture = CGLTF_PTRINDEX(cgltf_texture, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "indices") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "texCoord") == 0)
 		{
 			++i;
-			out_prim->indices = CGLTF_PTRINDEX(cgltf_accessor, cgltf_json_to_int(tokens + i, json_chunk));
+			out_texture_view->texcoord = cgltf_json_to_int(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "material") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "scale") == 0) 
 		{
 			++i;
-			out_prim->material = CGLTF_PTRINDEX(cgltf_material, cgltf_json_to_int(tokens + i, json_chunk));
+			out_texture_view->scale = cgltf_json_to_float(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "attributes") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "strength") == 0)
 		{
-			i = cgltf_parse_json_attribute_list(options, tokens, i + 1, json_chunk, &out_prim->attributes, &out_prim->attributes_count);
+			++i;
+			out_texture_view->scale = cgltf_json_to_float(tokens + i, json_chunk);
+			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "targets") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
 		{
-			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_morph_target), (void**)&out_prim->targets, &out_prim->targets_count);
-			if (i < 0)
-			{
-				return i;
-			}
+			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_texture_view->extras);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extensions") == 0)
+		{
+			++i;
 
-			for (cgltf_size k = 0; k < out_prim->targets_count; ++k)
+			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+
+			int extensions_size = tokens[i].size;
+			++i;
+
+			for (int k = 0; k < extensions_size; ++k)
 			{
-				i = cgltf_parse_json_attribute_list(options, tokens, i, json_chunk, &out_prim->targets[k].attributes, &out_prim->targets[k].attributes_count);
-				if (i < 0)
+				if (cgltf_json_strcmp(tokens+i, json_chunk, "KHR_texture_transform") == 0)
 				{
-					return i;
+					out_texture_view->has_transform = 1;
+					i = cgltf_parse_json_texture_transform(tokens, i + 1, json_chunk, &out_texture_view->transform);
+				}
+				else
+				{
+					i = cgltf_skip_json(tokens, i+1);
 				}
 			}
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
-		{
-			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_prim->extras);
-		}
 		else
 		{
-			i = cgltf_skip_json(tokens, i+1);
+			i = cgltf_skip_json(tokens, i + 1);
 		}
 
 		if (i < 0)
@@ -1939,7 +6205,7 @@ static int cgltf_parse_json_primitive(cgltf_options* options, jsmntok_t const* t
 	return i;
 }
 
-static int cgltf_parse_json_mesh(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_mesh* out_mesh)
+static int cgltf_parse_json_pbr_metallic_roughness(jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_pbr_metallic_roughness* out_pbr)
 {
 	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
@@ -1950,40 +6216,37 @@ static int cgltf_parse_json_mesh(cgltf_options* options, jsmntok_t const* tokens
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
+		if (cgltf_json_strcmp(tokens+i, json_chunk, "metallicFactor") == 0)
 		{
-			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_mesh->name);
+			++i;
+			out_pbr->metallic_factor = 
+				cgltf_json_to_float(tokens + i, json_chunk);
+			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "primitives") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "roughnessFactor") == 0) 
 		{
-			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_primitive), (void**)&out_mesh->primitives, &out_mesh->primitives_count);
-			if (i < 0)
-			{
-				return i;
-			}
-
-			for (cgltf_size prim_index = 0; prim_index < out_mesh->primitives_count; ++prim_index)
-			{
-				i = cgltf_parse_json_primitive(options, tokens, i, json_chunk, &out_mesh->primitives[prim_index]);
-				if (i < 0)
-				{
-					return i;
-				}
-			}
+			++i;
+			out_pbr->roughness_factor =
+				cgltf_json_to_float(tokens+i, json_chunk);
+			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "weights") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "baseColorFactor") == 0)
 		{
-			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_float), (void**)&out_mesh->weights, &out_mesh->weights_count);
-			if (i < 0)
-			{
-				return i;
-			}
-
-			i = cgltf_parse_json_float_array(tokens, i - 1, json_chunk, out_mesh->weights, (int)out_mesh->weights_count);
+			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_pbr->base_color_factor, 4);
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "baseColorTexture") == 0)
+		{
+			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk,
+				&out_pbr->base_color_texture);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "metallicRoughnessTexture") == 0)
+		{
+			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk,
+				&out_pbr->metallic_roughness_texture);
 		}
 		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
 		{
-			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_mesh->extras);
+			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_pbr->extras);
 		}
 		else
 		{
@@ -1999,156 +6262,105 @@ static int cgltf_parse_json_mesh(cgltf_options* options, jsmntok_t const* tokens
 	return i;
 }
 
-static int cgltf_parse_json_meshes(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
+static int cgltf_parse_json_pbr_specular_glossiness(jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_pbr_specular_glossiness* out_pbr)
 {
-	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_mesh), (void**)&out_data->meshes, &out_data->meshes_count);
-	if (i < 0)
-	{
-		return i;
-	}
+	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+	int size = tokens[i].size;
+	++i;
 
-	for (cgltf_size j = 0; j < out_data->meshes_count; ++j)
+	for (int j = 0; j < size; ++j)
 	{
-		i = cgltf_parse_json_mesh(options, tokens, i, json_chunk, &out_data->meshes[j]);
-		if (i < 0)
+		CGLTF_CHECK_KEY(tokens[i]);
+
+		if (cgltf_json_strcmp(tokens+i, json_chunk, "diffuseFactor") == 0)
 		{
-			return i;
+			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_pbr->diffuse_factor, 4);
+			if (i < 0)
+			{
+				return i;
+			}
 		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "specularFactor") == 0)
+		{
+			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_pbr->specular_factor, 3);
+			if (i < 0)
+			{
+				return i;
+			}
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "glossinessFactor") == 0)
+		{
+			++i;
+			out_pbr->glossiness_factor = cgltf_json_to_float(tokens + i, json_chunk);
+			++i;
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "diffuseTexture") == 0)
+		{
+			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk, &out_pbr->diffuse_texture);
+			if (i < 0)
+			{
+				return i;
+			}
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "specularGlossinessTexture") == 0)
+		{
+			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk, &out_pbr->specular_glossiness_texture);
+			if (i < 0)
+			{
+				return i;
+			}
+		}
+		else
+		{
+			i = cgltf_skip_json(tokens, i+1);
+		}
+
+		if (i < 0)
+		{
+			return i;
+		}
+
 	}
-	return i;
-}
-
-static cgltf_component_type cgltf_json_to_component_type(jsmntok_t const* tok, const uint8_t* json_chunk)
-{
-	int type = cgltf_json_to_int(tok, json_chunk);
-
-	switch (type)
-	{
-	case 5120:
-		return cgltf_component_type_r_8;
-	case 5121:
-		return cgltf_component_type_r_8u;
-	case 5122:
-		return cgltf_component_type_r_16;
-	case 5123:
-		return cgltf_component_type_r_16u;
-	case 5125:
-		return cgltf_component_type_r_32u;
-	case 5126:
-		return cgltf_component_type_r_32f;
-	default:
-		return cgltf_component_type_invalid;
-	}
+
+	return i;
 }
 
-static int cgltf_parse_json_accessor_sparse(jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_accessor_sparse* out_sparse)
+static int cgltf_parse_json_image(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_image* out_image)
 {
 	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
 	int size = tokens[i].size;
 	++i;
 
-	for (int j = 0; j < size; ++j)
+	for (int j = 0; j < size; ++j) 
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "count") == 0)
+		if (cgltf_json_strcmp(tokens + i, json_chunk, "uri") == 0) 
 		{
-			++i;
-			out_sparse->count = cgltf_json_to_int(tokens + i, json_chunk);
-			++i;
+			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_image->uri);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "indices") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "bufferView") == 0)
 		{
 			++i;
-			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
-
-			int indices_size = tokens[i].size;
+			out_image->buffer_view = CGLTF_PTRINDEX(cgltf_buffer_view, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
-
-			for (int k = 0; k < indices_size; ++k)
-			{
-				CGLTF_CHECK_KEY(tokens[i]);
-
-				if (cgltf_json_strcmp(tokens+i, json_chunk, "bufferView") == 0)
-				{
-					++i;
-					out_sparse->indices_buffer_view = CGLTF_PTRINDEX(cgltf_buffer_view, cgltf_json_to_int(tokens + i, json_chunk));
-					++i;
-				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteOffset") == 0)
-				{
-					++i;
-					out_sparse->indices_byte_offset = cgltf_json_to_int(tokens + i, json_chunk);
-					++i;
-				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "componentType") == 0)
-				{
-					++i;
-					out_sparse->indices_component_type = cgltf_json_to_component_type(tokens + i, json_chunk);
-					++i;
-				}
-				else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
-				{
-					i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_sparse->indices_extras);
-				}
-				else
-				{
-					i = cgltf_skip_json(tokens, i+1);
-				}
-
-				if (i < 0)
-				{
-					return i;
-				}
-			}
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "values") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "mimeType") == 0)
 		{
-			++i;
-			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
-
-			int values_size = tokens[i].size;
-			++i;
-
-			for (int k = 0; k < values_size; ++k)
-			{
-				CGLTF_CHECK_KEY(tokens[i]);
-
-				if (cgltf_json_strcmp(tokens+i, json_chunk, "bufferView") == 0)
-				{
-					++i;
-					out_sparse->values_buffer_view = CGLTF_PTRINDEX(cgltf_buffer_view, cgltf_json_to_int(tokens + i, json_chunk));
-					++i;
-				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteOffset") == 0)
-				{
-					++i;
-					out_sparse->values_byte_offset = cgltf_json_to_int(tokens + i, json_chunk);
-					++i;
-				}
-				else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
-				{
-					i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_sparse->values_extras);
-				}
-				else
-				{
-					i = cgltf_skip_json(tokens, i+1);
-				}
-
-				if (i < 0)
-				{
-					return i;
-				}
-			}
+			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_image->mime_type);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "name") == 0)
+		{
+			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_image->name);
 		}
 		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
 		{
-			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_sparse->extras);
+			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_image->extras);
 		}
 		else
 		{
-			i = cgltf_skip_json(tokens, i+1);
+			i = cgltf_skip_json(tokens, i + 1);
 		}
 
 		if (i < 0)
@@ -2160,10 +6372,14 @@ static int cgltf_parse_json_accessor_sparse(jsmntok_t const* tokens, int i, cons
 	return i;
 }
 
-static int cgltf_parse_json_accessor(jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_accessor* out_accessor)
+static int cgltf_parse_json_sampler(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_sampler* out_sampler)
 {
+	(void)options;
 	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
+	out_sampler->wrap_s = 10497;
+	out_sampler->wrap_t = 10497;
+
 	int size = tokens[i].size;
 	++i;
 
@@ -2171,99 +6387,41 @@ static int cgltf_parse_json_accessor(jsmntok_t const* tokens, int i, const uint8
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "bufferView") == 0)
-		{
-			++i;
-			out_accessor->buffer_view = CGLTF_PTRINDEX(cgltf_buffer_view, cgltf_json_to_int(tokens + i, json_chunk));
-			++i;
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteOffset") == 0)
-		{
-			++i;
-			out_accessor->offset =
-					cgltf_json_to_int(tokens+i, json_chunk);
-			++i;
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "componentType") == 0)
-		{
-			++i;
-			out_accessor->component_type = cgltf_json_to_component_type(tokens + i, json_chunk);
-			++i;
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "normalized") == 0)
+		if (cgltf_json_strcmp(tokens + i, json_chunk, "magFilter") == 0) 
 		{
 			++i;
-			out_accessor->normalized = cgltf_json_to_bool(tokens+i, json_chunk);
+			out_sampler->mag_filter
+				= cgltf_json_to_int(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "count") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "minFilter") == 0)
 		{
 			++i;
-			out_accessor->count =
-					cgltf_json_to_int(tokens+i, json_chunk);
+			out_sampler->min_filter
+				= cgltf_json_to_int(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "type") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "wrapS") == 0)
 		{
 			++i;
-			if (cgltf_json_strcmp(tokens+i, json_chunk, "SCALAR") == 0)
-			{
-				out_accessor->type = cgltf_type_scalar;
-			}
-			else if (cgltf_json_strcmp(tokens+i, json_chunk, "VEC2") == 0)
-			{
-				out_accessor->type = cgltf_type_vec2;
-			}
-			else if (cgltf_json_strcmp(tokens+i, json_chunk, "VEC3") == 0)
-			{
-				out_accessor->type = cgltf_type_vec3;
-			}
-			else if (cgltf_json_strcmp(tokens+i, json_chunk, "VEC4") == 0)
-			{
-				out_accessor->type = cgltf_type_vec4;
-			}
-			else if (cgltf_json_strcmp(tokens+i, json_chunk, "MAT2") == 0)
-			{
-				out_accessor->type = cgltf_type_mat2;
-			}
-			else if (cgltf_json_strcmp(tokens+i, json_chunk, "MAT3") == 0)
-			{
-				out_accessor->type = cgltf_type_mat3;
-			}
-			else if (cgltf_json_strcmp(tokens+i, json_chunk, "MAT4") == 0)
-			{
-				out_accessor->type = cgltf_type_mat4;
-			}
+			out_sampler->wrap_s
+				= cgltf_json_to_int(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "min") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "wrapT") == 0) 
 		{
 			++i;
-			out_accessor->has_min = 1;
-			// note: we can't parse the precise number of elements since type may not have been computed yet
-			int min_size = tokens[i].size > 16 ? 16 : tokens[i].size;
-			i = cgltf_parse_json_float_array(tokens, i, json_chunk, out_accessor->min, min_size);
-		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "max") == 0)
-		{
+			out_sampler->wrap_t
+				= cgltf_json_to_int(tokens + i, json_chunk);
 			++i;
-			out_accessor->has_max = 1;
-			// note: we can't parse the precise number of elements since type may not have been computed yet
-			int max_size = tokens[i].size > 16 ? 16 : tokens[i].size;
-			i = cgltf_parse_json_float_array(tokens, i, json_chunk, out_accessor->max, max_size);
-		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "sparse") == 0)
-		{
-			out_accessor->is_sparse = 1;
-			i = cgltf_parse_json_accessor_sparse(tokens, i + 1, json_chunk, &out_accessor->sparse);
 		}
 		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
 		{
-			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_accessor->extras);
+			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_sampler->extras);
 		}
 		else
 		{
-			i = cgltf_skip_json(tokens, i+1);
+			i = cgltf_skip_json(tokens, i + 1);
 		}
 
 		if (i < 0)
@@ -2275,7 +6433,8 @@ static int cgltf_parse_json_accessor(jsmntok_t const* tokens, int i, const uint8
 	return i;
 }
 
-static int cgltf_parse_json_texture_transform(jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_texture_transform* out_texture_transform)
+
+static int cgltf_parse_json_texture(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_texture* out_texture)
 {
 	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
@@ -2286,26 +6445,26 @@ static int cgltf_parse_json_texture_transform(jsmntok_t const* tokens, int i, co
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens + i, json_chunk, "offset") == 0)
+		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
 		{
-			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_texture_transform->offset, 2);
+			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_texture->name);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "rotation") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "sampler") == 0)
 		{
 			++i;
-			out_texture_transform->rotation = cgltf_json_to_float(tokens + i, json_chunk);
+			out_texture->sampler = CGLTF_PTRINDEX(cgltf_sampler, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "scale") == 0)
-		{
-			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_texture_transform->scale, 2);
-		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "texCoord") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "source") == 0) 
 		{
 			++i;
-			out_texture_transform->texcoord = cgltf_json_to_int(tokens + i, json_chunk);
+			out_texture->image = CGLTF_PTRINDEX(cgltf_image, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		{
+			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_texture->extras);
+		}
 		else
 		{
 			i = cgltf_skip_json(tokens, i + 1);
@@ -2320,12 +6479,19 @@ static int cgltf_parse_json_texture_transform(jsmntok_t const* tokens, int i, co
 	return i;
 }
 
-static int cgltf_parse_json_texture_view(jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_texture_view* out_texture_view)
+static int cgltf_parse_json_material(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_material* out_material)
 {
 	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
-	out_texture_view->scale = 1.0f;
-	cgltf_fill_float_array(out_texture_view->transform.scale, 2, 1.0f);
+	cgltf_fill_float_array(out_material->pbr_metallic_roughness.base_color_factor, 4, 1.0f);
+	out_material->pbr_metallic_roughness.metallic_factor = 1.0f;
+	out_material->pbr_metallic_roughness.roughness_factor = 1.0f;
+
+	cgltf_fill_float_array(out_material->pbr_specular_glossiness.diffuse_factor, 4, 1.0f);
+	cgltf_fill_float_array(out_material->pbr_specular_glossiness.specular_factor, 3, 1.0f);
+	out_material->pbr_specular_glossiness.glossiness_factor = 1.0f;
+
+	out_material->alpha_cutoff = 0.5f;
 
 	int size = tokens[i].size;
 	++i;
@@ -2334,33 +6500,67 @@ static int cgltf_parse_json_texture_view(jsmntok_t const* tokens, int i, const u
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens + i, json_chunk, "index") == 0)
+		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
+		{
+			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_material->name);
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "pbrMetallicRoughness") == 0)
+		{
+			out_material->has_pbr_metallic_roughness = 1;
+			i = cgltf_parse_json_pbr_metallic_roughness(tokens, i + 1, json_chunk, &out_material->pbr_metallic_roughness);
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "emissiveFactor") == 0)
+		{
+			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_material->emissive_factor, 3);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "normalTexture") == 0)
 		{
-			++i;
-			out_texture_view->texture = CGLTF_PTRINDEX(cgltf_texture, cgltf_json_to_int(tokens + i, json_chunk));
-			++i;
+			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk,
+				&out_material->normal_texture);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "texCoord") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "occlusionTexture") == 0)
+		{
+			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk,
+				&out_material->occlusion_texture);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "emissiveTexture") == 0)
+		{
+			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk,
+				&out_material->emissive_texture);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "alphaMode") == 0)
 		{
 			++i;
-			out_texture_view->texcoord = cgltf_json_to_int(tokens + i, json_chunk);
+			if (cgltf_json_strcmp(tokens + i, json_chunk, "OPAQUE") == 0)
+			{
+				out_material->alpha_mode = cgltf_alpha_mode_opaque;
+			}
+			else if (cgltf_json_strcmp(tokens + i, json_chunk, "MASK") == 0)
+			{
+				out_material->alpha_mode = cgltf_alpha_mode_mask;
+			}
+			else if (cgltf_json_strcmp(tokens + i, json_chunk, "BLEND") == 0)
+			{
+				out_material->alpha_mode = cgltf_alpha_mode_blend;
+			}
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "scale") == 0) 
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "alphaCutoff") == 0)
 		{
 			++i;
-			out_texture_view->scale = cgltf_json_to_float(tokens + i, json_chunk);
+			out_material->alpha_cutoff = cgltf_json_to_float(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "strength") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "doubleSided") == 0)
 		{
 			++i;
-			out_texture_view->scale = cgltf_json_to_float(tokens + i, json_chunk);
+			out_material->double_sided =
+				cgltf_json_to_bool(tokens + i, json_chunk);
 			++i;
 		}
 		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
 		{
-			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_texture_view->extras);
+			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_material->extras);
 		}
 		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extensions") == 0)
 		{
@@ -2373,20 +6573,32 @@ static int cgltf_parse_json_texture_view(jsmntok_t const* tokens, int i, const u
 
 			for (int k = 0; k < extensions_size; ++k)
 			{
-				if (cgltf_json_strcmp(tokens+i, json_chunk, "KHR_texture_transform") == 0)
+				CGLTF_CHECK_KEY(tokens[i]);
+
+				if (cgltf_json_strcmp(tokens+i, json_chunk, "KHR_materials_pbrSpecularGlossiness") == 0)
 				{
-					out_texture_view->has_transform = 1;
-					i = cgltf_parse_json_texture_transform(tokens, i + 1, json_chunk, &out_texture_view->transform);
+					out_material->has_pbr_specular_glossiness = 1;
+					i = cgltf_parse_json_pbr_specular_glossiness(tokens, i + 1, json_chunk, &out_material->pbr_specular_glossiness);
+				}
+				else if (cgltf_json_strcmp(tokens+i, json_chunk, "KHR_materials_unlit") == 0)
+				{
+					out_material->unlit = 1;
+					i = cgltf_skip_json(tokens, i+1);
 				}
 				else
 				{
 					i = cgltf_skip_json(tokens, i+1);
 				}
+
+				if (i < 0)
+				{
+					return i;
+				}
 			}
 		}
 		else
 		{
-			i = cgltf_skip_json(tokens, i + 1);
+			i = cgltf_skip_json(tokens, i+1);
 		}
 
 		if (i < 0)
@@ -2398,162 +6610,160 @@ static int cgltf_parse_json_texture_view(jsmntok_t const* tokens, int i, const u
 	return i;
 }
 
-static int cgltf_parse_json_pbr_metallic_roughness(jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_pbr_metallic_roughness* out_pbr)
+static int cgltf_parse_json_accessor_element(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, void* out_element)
 {
-	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+	(void)options;
+	return cgltf_parse_json_accessor(tokens, i, json_chunk, (cgltf_accessor*)out_element);
+}
 
-	int size = tokens[i].size;
-	++i;
+static int cgltf_parse_json_accessors(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
+{
+	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_accessor), (void**)&out_data->accessors, &out_data->accessors_count);
+	if (i < 0)
+	{
+		return i;
+	}
 
-	for (int j = 0; j < size; ++j)
+	return cgltf_parse_json_elements(options, tokens, i, json_chunk, &cgltf_parse_json_accessor_element, out_data->accessors, sizeof(cgltf_accessor), out_data->accessors_count);
+}
+
+static int cgltf_parse_json_material_element(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, void* out_element)
+{
+	return cgltf_parse_json_material(options, tokens, i, json_chunk, (cgltf_material*)out_element);
+}
+
+static int cgltf_parse_json_materials(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
+{
+	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_material), (void**)&out_data->materials, &out_data->materials_count);
+	if (i < 0)
 	{
-		CGLTF_CHECK_KEY(tokens[i]);
+		return i;
+	}
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "metallicFactor") == 0)
-		{
-			++i;
-			out_pbr->metallic_factor = 
-				cgltf_json_to_float(tokens + i, json_chunk);
-			++i;
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "roughnessFactor") == 0) 
-		{
-			++i;
-			out_pbr->roughness_factor =
-				cgltf_json_to_float(tokens+i, json_chunk);
-			++i;
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "baseColorFactor") == 0)
-		{
-			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_pbr->base_color_factor, 4);
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "baseColorTexture") == 0)
-		{
-			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk,
-				&out_pbr->base_color_texture);
-		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "metallicRoughnessTexture") == 0)
-		{
-			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk,
-				&out_pbr->metallic_roughness_texture);
-		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
-		{
-			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_pbr->extras);
-		}
-		else
-		{
-			i = cgltf_skip_json(tokens, i+1);
-		}
+	return cgltf_parse_json_elements(options, tokens, i, json_chunk, &cgltf_parse_json_material_element, out_data->materials, sizeof(cgltf_material), out_data->materials_count);
+}
+
+static int cgltf_parse_json_images(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
+{
+	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_image), (void**)&out_data->images, &out_data->images_count);
+	if (i < 0)
+	{
+		return i;
+	}
 
+	for (cgltf_size j = 0; j < out_data->images_count; ++j)
+	{
+		i = cgltf_parse_json_image(options, tokens, i, json_chunk, &out_data->images[j]);
 		if (i < 0)
 		{
 			return i;
 		}
 	}
-
 	return i;
 }
 
-static int cgltf_parse_json_pbr_specular_glossiness(jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_pbr_specular_glossiness* out_pbr)
+static int cgltf_parse_json_textures(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
 {
-	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
-	int size = tokens[i].size;
-	++i;
-
-	for (int j = 0; j < size; ++j)
+	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_texture), (void**)&out_data->textures, &out_data->textures_count);
+	if (i < 0)
 	{
-		CGLTF_CHECK_KEY(tokens[i]);
+		return i;
+	}
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "diffuseFactor") == 0)
-		{
-			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_pbr->diffuse_factor, 4);
-			if (i < 0)
-			{
-				return i;
-			}
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "specularFactor") == 0)
-		{
-			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_pbr->specular_factor, 3);
-			if (i < 0)
-			{
-				return i;
-			}
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "glossinessFactor") == 0)
-		{
-			++i;
-			out_pbr->glossiness_factor = cgltf_json_to_float(tokens + i, json_chunk);
-			++i;
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "diffuseTexture") == 0)
-		{
-			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk, &out_pbr->diffuse_texture);
-			if (i < 0)
-			{
-				return i;
-			}
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "specularGlossinessTexture") == 0)
-		{
-			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk, &out_pbr->specular_glossiness_texture);
-			if (i < 0)
-			{
-				return i;
-			}
-		}
-		else
+	for (cgltf_size j = 0; j < out_data->textures_count; ++j)
+	{
+		i = cgltf_parse_json_texture(options, tokens, i, json_chunk, &out_data->textures[j]);
+		if (i < 0)
 		{
-			i = cgltf_skip_json(tokens, i+1);
+			return i;
 		}
+	}
+	return i;
+}
+
+static int cgltf_parse_json_samplers(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
+{
+	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_sampler), (void**)&out_data->samplers, &out_data->samplers_count);
+	if (i < 0)
+	{
+		return i;
+	}
 
+	for (cgltf_size j = 0; j < out_data->samplers_count; ++j)
+	{
+		i = cgltf_parse_json_sampler(options, tokens, i, json_chunk, &out_data->samplers[j]);
 		if (i < 0)
 		{
 			return i;
 		}
-
 	}
-
 	return i;
 }
 
-static int cgltf_parse_json_image(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_image* out_image)
+static int cgltf_parse_json_buffer_view(jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_buffer_view* out_buffer_view)
 {
 	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
 	int size = tokens[i].size;
 	++i;
 
-	for (int j = 0; j < size; ++j) 
+	for (int j = 0; j < size; ++j)
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens + i, json_chunk, "uri") == 0) 
+		if (cgltf_json_strcmp(tokens+i, json_chunk, "buffer") == 0)
 		{
-			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_image->uri);
+			++i;
+			out_buffer_view->buffer = CGLTF_PTRINDEX(cgltf_buffer, cgltf_json_to_int(tokens + i, json_chunk));
+			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "bufferView") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteOffset") == 0)
 		{
 			++i;
-			out_image->buffer_view = CGLTF_PTRINDEX(cgltf_buffer_view, cgltf_json_to_int(tokens + i, json_chunk));
+			out_buffer_view->offset =
+					cgltf_json_to_int(tokens+i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "mimeType") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteLength") == 0)
 		{
-			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_image->mime_type);
+			++i;
+			out_buffer_view->size =
+					cgltf_json_to_int(tokens+i, json_chunk);
+			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "name") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteStride") == 0)
 		{
-			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_image->name);
+			++i;
+			out_buffer_view->stride =
+					cgltf_json_to_int(tokens+i, json_chunk);
+			++i;
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "target") == 0)
+		{
+			++i;
+			int type = cgltf_json_to_int(tokens+i, json_chunk);
+			switch (type)
+			{
+			case 34962:
+				type = cgltf_buffer_view_type_vertices;
+				break;
+			case 34963:
+				type = cgltf_buffer_view_type_indices;
+				break;
+			default:
+				type = cgltf_buffer_view_type_invalid;
+				break;
+			}
+			out_buffer_view->type = (cgltf_buffer_view_type)type;
+			++i;
 		}
 		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
 		{
-			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_image->extras);
+			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_buffer_view->extras);
 		}
 		else
 		{
-			i = cgltf_skip_json(tokens, i + 1);
+			i = cgltf_skip_json(tokens, i+1);
 		}
 
 		if (i < 0)
@@ -2565,13 +6775,26 @@ static int cgltf_parse_json_image(cgltf_options* options, jsmntok_t const* token
 	return i;
 }
 
-static int cgltf_parse_json_sampler(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_sampler* out_sampler)
+static int cgltf_parse_json_buffer_view_element(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, void* out_element)
 {
 	(void)options;
-	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+	return cgltf_parse_json_buffer_view(tokens, i, json_chunk, (cgltf_buffer_view*)out_element);
+}
 
-	out_sampler->wrap_s = 10497;
-	out_sampler->wrap_t = 10497;
+static int cgltf_parse_json_buffer_views(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
+{
+	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_buffer_view), (void**)&out_data->buffer_views, &out_data->buffer_views_count);
+	if (i < 0)
+	{
+		return i;
+	}
+
+	return cgltf_parse_json_elements(options, tokens, i, json_chunk, &cgltf_parse_json_buffer_view_element, out_data->buffer_views, sizeof(cgltf_buffer_view), out_data->buffer_views_count);
+}
+
+static int cgltf_parse_json_buffer(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_buffer* out_buffer)
+{
+	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
 	int size = tokens[i].size;
 	++i;
@@ -2580,41 +6803,24 @@ static int cgltf_parse_json_sampler(cgltf_options* options, jsmntok_t const* tok
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens + i, json_chunk, "magFilter") == 0) 
-		{
-			++i;
-			out_sampler->mag_filter
-				= cgltf_json_to_int(tokens + i, json_chunk);
-			++i;
-		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "minFilter") == 0)
-		{
-			++i;
-			out_sampler->min_filter
-				= cgltf_json_to_int(tokens + i, json_chunk);
-			++i;
-		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "wrapS") == 0)
+		if (cgltf_json_strcmp(tokens+i, json_chunk, "byteLength") == 0)
 		{
 			++i;
-			out_sampler->wrap_s
-				= cgltf_json_to_int(tokens + i, json_chunk);
+			out_buffer->size =
+					cgltf_json_to_int(tokens+i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "wrapT") == 0) 
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "uri") == 0)
 		{
-			++i;
-			out_sampler->wrap_t
-				= cgltf_json_to_int(tokens + i, json_chunk);
-			++i;
+			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_buffer->uri);
 		}
 		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
 		{
-			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_sampler->extras);
+			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_buffer->extras);
 		}
 		else
 		{
-			i = cgltf_skip_json(tokens, i + 1);
+			i = cgltf_skip_json(tokens, i+1);
 		}
 
 		if (i < 0)
@@ -2626,8 +6832,26 @@ static int cgltf_parse_json_sampler(cgltf_options* options, jsmntok_t const* tok
 	return i;
 }
 
+static int cgltf_parse_json_buffers(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
+{
+	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_buffer), (void**)&out_data->buffers, &out_data->buffers_count);
+	if (i < 0)
+	{
+		return i;
+	}
 
-static int cgltf_parse_json_texture(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_texture* out_texture)
+	for (cgltf_size j = 0; j < out_data->buffers_count; ++j)
+	{
+		i = cgltf_parse_json_buffer(options, tokens, i, json_chunk, &out_data->buffers[j]);
+		if (i < 0)
+		{
+			return i;
+		}
+	}
+	return i;
+}
+
+static int cgltf_parse_json_skin(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_skin* out_skin)
 {
 	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
@@ -2640,27 +6864,43 @@ static int cgltf_parse_json_texture(cgltf_options* options, jsmntok_t const* tok
 
 		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
 		{
-			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_texture->name);
+			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_skin->name);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "sampler") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "joints") == 0)
+		{
+			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_node*), (void**)&out_skin->joints, &out_skin->joints_count);
+			if (i < 0)
+			{
+				return i;
+			}
+
+			for (cgltf_size k = 0; k < out_skin->joints_count; ++k)
+			{
+				out_skin->joints[k] = CGLTF_PTRINDEX(cgltf_node, cgltf_json_to_int(tokens + i, json_chunk));
+				++i;
+			}
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "skeleton") == 0)
 		{
 			++i;
-			out_texture->sampler = CGLTF_PTRINDEX(cgltf_sampler, cgltf_json_to_int(tokens + i, json_chunk));
+			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_PRIMITIVE);
+			out_skin->skeleton = CGLTF_PTRINDEX(cgltf_node, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "source") == 0) 
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "inverseBindMatrices") == 0)
 		{
 			++i;
-			out_texture->image = CGLTF_PTRINDEX(cgltf_image, cgltf_json_to_int(tokens + i, json_chunk));
+			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_PRIMITIVE);
+			out_skin->inverse_bind_matrices = CGLTF_PTRINDEX(cgltf_accessor, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
 		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
 		{
-			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_texture->extras);
+			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_skin->extras);
 		}
 		else
 		{
-			i = cgltf_skip_json(tokens, i + 1);
+			i = cgltf_skip_json(tokens, i+1);
 		}
 
 		if (i < 0)
@@ -2672,19 +6912,28 @@ static int cgltf_parse_json_texture(cgltf_options* options, jsmntok_t const* tok
 	return i;
 }
 
-static int cgltf_parse_json_material(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_material* out_material)
+static int cgltf_parse_json_skins(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
 {
-	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
-
-	cgltf_fill_float_array(out_material->pbr_metallic_roughness.base_color_factor, 4, 1.0f);
-	out_material->pbr_metallic_roughness.metallic_factor = 1.0f;
-	out_material->pbr_metallic_roughness.roughness_factor = 1.0f;
+	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_skin), (void**)&out_data->skins, &out_data->skins_count);
+	if (i < 0)
+	{
+		return i;
+	}
 
-	cgltf_fill_float_array(out_material->pbr_specular_glossiness.diffuse_factor, 4, 1.0f);
-	cgltf_fill_float_array(out_material->pbr_specular_glossiness.specular_factor, 3, 1.0f);
-	out_material->pbr_specular_glossiness.glossiness_factor = 1.0f;
+	for (cgltf_size j = 0; j < out_data->skins_count; ++j)
+	{
+		i = cgltf_parse_json_skin(options, tokens, i, json_chunk, &out_data->skins[j]);
+		if (i < 0)
+		{
+			return i;
+		}
+	}
+	return i;
+}
 
-	out_material->alpha_cutoff = 0.5f;
+static int cgltf_parse_json_camera(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_camera* out_camera)
+{
+	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
 	int size = tokens[i].size;
 	++i;
@@ -2695,88 +6944,117 @@ static int cgltf_parse_json_material(cgltf_options* options, jsmntok_t const* to
 
 		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
 		{
-			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_material->name);
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "pbrMetallicRoughness") == 0)
-		{
-			out_material->has_pbr_metallic_roughness = 1;
-			i = cgltf_parse_json_pbr_metallic_roughness(tokens, i + 1, json_chunk, &out_material->pbr_metallic_roughness);
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "emissiveFactor") == 0)
-		{
-			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_material->emissive_factor, 3);
-		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "normalTexture") == 0)
-		{
-			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk,
-				&out_material->normal_texture);
-		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "occlusionTexture") == 0)
-		{
-			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk,
-				&out_material->occlusion_texture);
-		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "emissiveTexture") == 0)
-		{
-			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk,
-				&out_material->emissive_texture);
+			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_camera->name);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "alphaMode") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "type") == 0)
 		{
 			++i;
-			if (cgltf_json_strcmp(tokens + i, json_chunk, "OPAQUE") == 0)
-			{
-				out_material->alpha_mode = cgltf_alpha_mode_opaque;
-			}
-			else if (cgltf_json_strcmp(tokens + i, json_chunk, "MASK") == 0)
+			if (cgltf_json_strcmp(tokens + i, json_chunk, "perspective") == 0)
 			{
-				out_material->alpha_mode = cgltf_alpha_mode_mask;
+				out_camera->type = cgltf_camera_type_perspective;
 			}
-			else if (cgltf_json_strcmp(tokens + i, json_chunk, "BLEND") == 0)
+			else if (cgltf_json_strcmp(tokens + i, json_chunk, "orthographic") == 0)
 			{
-				out_material->alpha_mode = cgltf_alpha_mode_blend;
+				out_camera->type = cgltf_camera_type_orthographic;
 			}
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "alphaCutoff") == 0)
-		{
-			++i;
-			out_material->alpha_cutoff = cgltf_json_to_float(tokens + i, json_chunk);
-			++i;
-		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "doubleSided") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "perspective") == 0)
 		{
 			++i;
-			out_material->double_sided =
-				cgltf_json_to_bool(tokens + i, json_chunk);
+
+			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+
+			int data_size = tokens[i].size;
 			++i;
+
+			out_camera->type = cgltf_camera_type_perspective;
+
+			for (int k = 0; k < data_size; ++k)
+			{
+				CGLTF_CHECK_KEY(tokens[i]);
+
+				if (cgltf_json_strcmp(tokens+i, json_chunk, "aspectRatio") == 0)
+				{
+					++i;
+					out_camera->perspective.aspect_ratio = cgltf_json_to_float(tokens + i, json_chunk);
+					++i;
+				}
+				else if (cgltf_json_strcmp(tokens+i, json_chunk, "yfov") == 0)
+				{
+					++i;
+					out_camera->perspective.yfov = cgltf_json_to_float(tokens + i, json_chunk);
+					++i;
+				}
+				else if (cgltf_json_strcmp(tokens+i, json_chunk, "zfar") == 0)
+				{
+					++i;
+					out_camera->perspective.zfar = cgltf_json_to_float(tokens + i, json_chunk);
+					++i;
+				}
+				else if (cgltf_json_strcmp(tokens+i, json_chunk, "znear") == 0)
+				{
+					++i;
+					out_camera->perspective.znear = cgltf_json_to_float(tokens + i, json_chunk);
+					++i;
+				}
+				else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+				{
+					i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_camera->perspective.extras);
+				}
+				else
+				{
+					i = cgltf_skip_json(tokens, i+1);
+				}
+
+				if (i < 0)
+				{
+					return i;
+				}
+			}
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
-		{
-			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_material->extras);
-		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extensions") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "orthographic") == 0)
 		{
 			++i;
 
 			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
-			int extensions_size = tokens[i].size;
+			int data_size = tokens[i].size;
 			++i;
 
-			for (int k = 0; k < extensions_size; ++k)
+			out_camera->type = cgltf_camera_type_orthographic;
+
+			for (int k = 0; k < data_size; ++k)
 			{
 				CGLTF_CHECK_KEY(tokens[i]);
 
-				if (cgltf_json_strcmp(tokens+i, json_chunk, "KHR_materials_pbrSpecularGlossiness") == 0)
+				if (cgltf_json_strcmp(tokens+i, json_chunk, "xmag") == 0)
+				{
+					++i;
+					out_camera->orthographic.xmag = cgltf_json_to_float(tokens + i, json_chunk);
+					++i;
+				}
+				else if (cgltf_json_strcmp(tokens+i, json_chunk, "ymag") == 0)
+				{
+					++i;
+					out_camera->orthographic.ymag = cgltf_json_to_float(tokens + i, json_chunk);
+					++i;
+				}
+				else if (cgltf_json_strcmp(tokens+i, json_chunk, "zfar") == 0)
 				{
-					out_material->has_pbr_specular_glossiness = 1;
-					i = cgltf_parse_json_pbr_specular_glossiness(tokens, i + 1, json_chunk, &out_material->pbr_specular_glossiness);
+					++i;
+					out_camera->orthographic.zfar = cgltf_json_to_float(tokens + i, json_chunk);
+					++i;
 				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "KHR_materials_unlit") == 0)
+				else if (cgltf_json_strcmp(tokens+i, json_chunk, "znear") == 0)
 				{
-					out_material->unlit = 1;
-					i = cgltf_skip_json(tokens, i+1);
+					++i;
+					out_camera->orthographic.znear = cgltf_json_to_float(tokens + i, json_chunk);
+					++i;
+				}
+				else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+				{
+					i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_camera->orthographic.extras);
 				}
 				else
 				{
@@ -2789,6 +7067,10 @@ static int cgltf_parse_json_material(cgltf_options* options, jsmntok_t const* to
 				}
 			}
 		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		{
+			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_camera->extras);
+		}
 		else
 		{
 			i = cgltf_skip_json(tokens, i+1);
@@ -2803,17 +7085,17 @@ static int cgltf_parse_json_material(cgltf_options* options, jsmntok_t const* to
 	return i;
 }
 
-static int cgltf_parse_json_accessors(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
+static int cgltf_parse_json_cameras(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
 {
-	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_accessor), (void**)&out_data->accessors, &out_data->accessors_count);
+	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_camera), (void**)&out_data->cameras, &out_data->cameras_count);
 	if (i < 0)
 	{
 		return i;
 	}
 
-	for (cgltf_size j = 0; j < out_data->accessors_count; ++j)
+	for (cgltf_size j = 0; j < out_data->cameras_count; ++j)
 	{
-		i = cgltf_parse_json_accessor(tokens, i, json_chunk, &out_data->accessors[j]);
+		i = cgltf_parse_json_camera(options, tokens, i, json_chunk, &out_data->cameras[j]);
 		if (i < 0)
 		{
 			return i;
@@ -2822,74 +7104,115 @@ static int cgltf_parse_json_accessors(cgltf_options* options, jsmntok_t const* t
 	return i;
 }
 
-static int cgltf_parse_json_materials(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
+static int cgltf_parse_json_light(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_light* out_light)
 {
-	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_material), (void**)&out_data->materials, &out_data->materials_count);
-	if (i < 0)
-	{
-		return i;
-	}
+	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
-	for (cgltf_size j = 0; j < out_data->materials_count; ++j)
+	int size = tokens[i].size;
+	++i;
+
+	for (int j = 0; j < size; ++j)
 	{
-		i = cgltf_parse_json_material(options, tokens, i, json_chunk, &out_data->materials[j]);
-		if (i < 0)
+		CGLTF_CHECK_KEY(tokens[i]);
+
+		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
 		{
-			return i;
+			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_light->name);
 		}
-	}
-	return i;
-}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "color") == 0)
+		{
+			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_light->color, 3);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "intensity") == 0)
+		{
+			++i;
+			out_light->intensity = cgltf_json_to_float(tokens + i, json_chunk);
+			++i;
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "type") == 0)
+		{
+			++i;
+			if (cgltf_json_strcmp(tokens + i, json_chunk, "directional") == 0)
+			{
+				out_light->type = cgltf_light_type_directional;
+			}
+			else if (cgltf_json_strcmp(tokens + i, json_chunk, "point") == 0)
+			{
+				out_light->type = cgltf_light_type_point;
+			}
+			else if (cgltf_json_strcmp(tokens + i, json_chunk, "spot") == 0)
+			{
+				out_light->type = cgltf_light_type_spot;
+			}
+			++i;
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "range") == 0)
+		{
+			++i;
+			out_light->range = cgltf_json_to_float(tokens + i, json_chunk);
+			++i;
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "spot") == 0)
+		{
+			++i;
 
-static int cgltf_parse_json_images(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
-{
-	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_image), (void**)&out_data->images, &out_data->images_count);
-	if (i < 0)
-	{
-		return i;
-	}
+			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
-	for (cgltf_size j = 0; j < out_data->images_count; ++j)
-	{
-		i = cgltf_parse_json_image(options, tokens, i, json_chunk, &out_data->images[j]);
-		if (i < 0)
+			int data_size = tokens[i].size;
+			++i;
+
+			for (int k = 0; k < data_size; ++k)
+			{
+				CGLTF_CHECK_KEY(tokens[i]);
+
+				if (cgltf_json_strcmp(tokens+i, json_chunk, "innerConeAngle") == 0)
+				{
+					++i;
+					out_light->spot_inner_cone_angle = cgltf_json_to_float(tokens + i, json_chunk);
+					++i;
+				}
+				else if (cgltf_json_strcmp(tokens+i, json_chunk, "outerConeAngle") == 0)
+				{
+					++i;
+					out_light->spot_outer_cone_angle = cgltf_json_to_float(tokens + i, json_chunk);
+					++i;
+				}
+				else
+				{
+					i = cgltf_skip_json(tokens, i+1);
+				}
+
+				if (i < 0)
+				{
+					return i;
+				}
+			}
+		}
+		else
 		{
-			return i;
+			i = cgltf_skip_json(tokens, i+1);
 		}
-	}
-	return i;
-}
-
-static int cgltf_parse_json_textures(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
-{
-	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_texture), (void**)&out_data->textures, &out_data->textures_count);
-	if (i < 0)
-	{
-		return i;
-	}
 
-	for (cgltf_size j = 0; j < out_data->textures_count; ++j)
-	{
-		i = cgltf_parse_json_texture(options, tokens, i, json_chunk, &out_data->textures[j]);
 		if (i < 0)
 		{
 			return i;
 		}
 	}
+
 	return i;
 }
 
-static int cgltf_parse_json_samplers(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
+static int cgltf_parse_json_lights(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
 {
-	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_sampler), (void**)&out_data->samplers, &out_data->samplers_count);
+	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_light), (void**)&out_data->lights, &out_data->lights_count);
 	if (i < 0)
 	{
 		return i;
 	}
 
-	for (cgltf_size j = 0; j < out_data->samplers_count; ++j)
+	for (cgltf_size j = 0; j < out_data->lights_count; ++j)
 	{
-		i = cgltf_parse_json_sampler(options, tokens, i, json_chunk, &out_data->samplers[j]);
+		i = cgltf_parse_json_light(options, tokens, i, json_chunk, &out_data->lights[j]);
 		if (i < 0)
 		{
 			return i;
@@ -2898,10 +7221,19 @@ static int cgltf_parse_json_samplers(cgltf_options* options, jsmntok_t const* to
 	return i;
 }
 
-static int cgltf_parse_json_buffer_view(jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_buffer_view* out_buffer_view)
+static int cgltf_parse_json_node(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_node* out_node)
 {
 	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
+	out_node->rotation[3] = 1.0f;
+	out_node->scale[0] = 1.0f;
+	out_node->scale[1] = 1.0f;
+	out_node->scale[2] = 1.0f;
+	out_node->matrix[0] = 1.0f;
+	out_node->matrix[5] = 1.0f;
+	out_node->matrix[10] = 1.0f;
+	out_node->matrix[15] = 1.0f;
+
 	int size = tokens[i].size;
 	++i;
 
@@ -2909,55 +7241,133 @@ static int cgltf_parse_json_buffer_view(jsmntok_t const* tokens, int i, const ui
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "buffer") == 0)
+		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
 		{
-			++i;
-			out_buffer_view->buffer = CGLTF_PTRINDEX(cgltf_buffer, cgltf_json_to_int(tokens + i, json_chunk));
-			++i;
+			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_node->name);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteOffset") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "children") == 0)
+		{
+			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_node*), (void**)&out_node->children, &out_node->children_count);
+			if (i < 0)
+			{
+				return i;
+			}
+
+			for (cgltf_size k = 0; k < out_node->children_count; ++k)
+			{
+				out_node->children[k] = CGLTF_PTRINDEX(cgltf_node, cgltf_json_to_int(tokens + i, json_chunk));
+				++i;
+			}
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "mesh") == 0)
 		{
 			++i;
-			out_buffer_view->offset =
-					cgltf_json_to_int(tokens+i, json_chunk);
+			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_PRIMITIVE);
+			out_node->mesh = CGLTF_PTRINDEX(cgltf_mesh, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteLength") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "skin") == 0)
 		{
 			++i;
-			out_buffer_view->size =
-					cgltf_json_to_int(tokens+i, json_chunk);
+			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_PRIMITIVE);
+			out_node->skin = CGLTF_PTRINDEX(cgltf_skin, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteStride") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "camera") == 0)
 		{
 			++i;
-			out_buffer_view->stride =
-					cgltf_json_to_int(tokens+i, json_chunk);
+			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_PRIMITIVE);
+			out_node->camera = CGLTF_PTRINDEX(cgltf_camera, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "target") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "translation") == 0)
+		{
+			out_node->has_translation = 1;
+			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_node->translation, 3);
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "rotation") == 0)
+		{
+			out_node->has_rotation = 1;
+			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_node->rotation, 4);
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "scale") == 0)
+		{
+			out_node->has_scale = 1;
+			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_node->scale, 3);
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "matrix") == 0)
+		{
+			out_node->has_matrix = 1;
+			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_node->matrix, 16);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "weights") == 0)
+		{
+			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_float), (void**)&out_node->weights, &out_node->weights_count);
+			if (i < 0)
+			{
+				return i;
+			}
+
+			i = cgltf_parse_json_float_array(tokens, i - 1, json_chunk, out_node->weights, (int)out_node->weights_count);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		{
+			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_node->extras);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extensions") == 0)
 		{
 			++i;
-			int type = cgltf_json_to_int(tokens+i, json_chunk);
-			switch (type)
+
+			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+
+			int extensions_size = tokens[i].size;
+			++i;
+
+			for (int k = 0; k < extensions_size; ++k)
 			{
-			case 34962:
-				type = cgltf_buffer_view_type_vertices;
-				break;
-			case 34963:
-				type = cgltf_buffer_view_type_indices;
-				break;
-			default:
-				type = cgltf_buffer_view_type_invalid;
-				break;
+				CGLTF_CHECK_KEY(tokens[i]);
+
+				if (cgltf_json_strcmp(tokens+i, json_chunk, "KHR_lights_punctual") == 0)
+				{
+					++i;
+
+					CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+
+					int data_size = tokens[i].size;
+					++i;
+
+					for (int m = 0; m < data_size; ++m)
+					{
+						CGLTF_CHECK_KEY(tokens[i]);
+
+						if (cgltf_json_strcmp(tokens + i, json_chunk, "light") == 0)
+						{
+							++i;
+							CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_PRIMITIVE);
+							out_node->light = CGLTF_PTRINDEX(cgltf_light, cgltf_json_to_int(tokens + i, json_chunk));
+							++i;
+						}
+						else
+						{
+							i = cgltf_skip_json(tokens, i + 1);
+						}
+
+						if (i < 0)
+						{
+							return i;
+						}
+					}
+				}
+				else
+				{
+					i = cgltf_skip_json(tokens, i+1);
+				}
+
+				if (i < 0)
+				{
+					return i;
+				}
 			}
-			out_buffer_view->type = (cgltf_buffer_view_type)type;
-			++i;
-		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
-		{
-			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_buffer_view->extras);
 		}
 		else
 		{
@@ -2973,26 +7383,23 @@ static int cgltf_parse_json_buffer_view(jsmntok_t const* tokens, int i, const ui
 	return i;
 }
 
-static int cgltf_parse_json_buffer_views(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
+static int cgltf_parse_json_node_element(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, void* out_element)
 {
-	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_buffer_view), (void**)&out_data->buffer_views, &out_data->buffer_views_count);
+	return cgltf_parse_json_node(options, tokens, i, json_chunk, (cgltf_node*)out_element);
+}
+
+static int cgltf_parse_json_nodes(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
+{
+	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_node), (void**)&out_data->nodes, &out_data->nodes_count);
 	if (i < 0)
 	{
 		return i;
 	}
 
-	for (cgltf_size j = 0; j < out_data->buffer_views_count; ++j)
-	{
-		i = cgltf_parse_json_buffer_view(tokens, i, json_chunk, &out_data->buffer_views[j]);
-		if (i < 0)
-		{
-			return i;
-		}
-	}
-	return i;
+	return cgltf_parse_json_elements(options, tokens, i, json_chunk, &cgltf_parse_json_node_element, out_data->nodes, sizeof(cgltf_node), out_data->nodes_count);
 }
 
-static int cgltf_parse_json_buffer(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_buffer* out_buffer)
+static int cgltf_parse_json_scene(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_scene* out_scene)
 {
 	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
@@ -3003,20 +7410,27 @@ static int cgltf_parse_json_buffer(cgltf_options* options, jsmntok_t const* toke
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "byteLength") == 0)
+		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
 		{
-			++i;
-			out_buffer->size =
-					cgltf_json_to_int(tokens+i, json_chunk);
-			++i;
+			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_scene->name);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "uri") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "nodes") == 0)
 		{
-			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_buffer->uri);
+			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_node*), (void**)&out_scene->nodes, &out_scene->nodes_count);
+			if (i < 0)
+			{
+				return i;
+			}
+
+			for (cgltf_size k = 0; k < out_scene->nodes_count; ++k)
+			{
+				out_scene->nodes[k] = CGLTF_PTRINDEX(cgltf_node, cgltf_json_to_int(tokens + i, json_chunk));
+				++i;
+			}
 		}
 		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
 		{
-			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_buffer->extras);
+			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_scene->extras);
 		}
 		else
 		{
@@ -3032,17 +7446,17 @@ static int cgltf_parse_json_buffer(cgltf_options* options, jsmntok_t const* toke
 	return i;
 }
 
-static int cgltf_parse_json_buffers(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
+static int cgltf_parse_json_scenes(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
 {
-	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_buffer), (void**)&out_data->buffers, &out_data->buffers_count);
+	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_scene), (void**)&out_data->scenes, &out_data->scenes_count);
 	if (i < 0)
 	{
 		return i;
 	}
 
-	for (cgltf_size j = 0; j < out_data->buffers_count; ++j)
+	for (cgltf_size j = 0; j < out_data->scenes_count; ++j)
 	{
-		i = cgltf_parse_json_buffer(options, tokens, i, json_chunk, &out_data->buffers[j]);
+		i = cgltf_parse_json_scene(options, tokens, i, json_chunk, &out_data->scenes[j]);
 		if (i < 0)
 		{
 			return i;
@@ -3051,8 +7465,9 @@ static int cgltf_parse_json_buffers(cgltf_options* options, jsmntok_t const* tok
 	return i;
 }
 
-static int cgltf_parse_json_skin(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_skin* out_skin)
+static int cgltf_parse_json_animation_sampler(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_animation_sampler* out_sampler)
 {
+	(void)options;
 	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
 	int size = tokens[i].size;
@@ -3062,41 +7477,38 @@ static int cgltf_parse_json_skin(cgltf_options* options, jsmntok_t const* tokens
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
-		{
-			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_skin->name);
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "joints") == 0)
+		if (cgltf_json_strcmp(tokens+i, json_chunk, "input") == 0)
 		{
-			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_node*), (void**)&out_skin->joints, &out_skin->joints_count);
-			if (i < 0)
-			{
-				return i;
-			}
-
-			for (cgltf_size k = 0; k < out_skin->joints_count; ++k)
-			{
-				out_skin->joints[k] = CGLTF_PTRINDEX(cgltf_node, cgltf_json_to_int(tokens + i, json_chunk));
-				++i;
-			}
+			++i;
+			out_sampler->input = CGLTF_PTRINDEX(cgltf_accessor, cgltf_json_to_int(tokens + i, json_chunk));
+			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "skeleton") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "output") == 0)
 		{
 			++i;
-			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_PRIMITIVE);
-			out_skin->skeleton = CGLTF_PTRINDEX(cgltf_node, cgltf_json_to_int(tokens + i, json_chunk));
+			out_sampler->output = CGLTF_PTRINDEX(cgltf_accessor, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "inverseBindMatrices") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "interpolation") == 0)
 		{
 			++i;
-			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_PRIMITIVE);
-			out_skin->inverse_bind_matrices = CGLTF_PTRINDEX(cgltf_accessor, cgltf_json_to_int(tokens + i, json_chunk));
+			if (cgltf_json_strcmp(tokens + i, json_chunk, "LINEAR") == 0)
+			{
+				out_sampler->interpolation = cgltf_interpolation_type_linear;
+			}
+			else if (cgltf_json_strcmp(tokens + i, json_chunk, "STEP") == 0)
+			{
+				out_sampler->interpolation = cgltf_interpolation_type_step;
+			}
+			else if (cgltf_json_strcmp(tokens + i, json_chunk, "CUBICSPLINE") == 0)
+			{
+				out_sampler->interpolation = cgltf_interpolation_type_cubic_spline;
+			}
 			++i;
 		}
 		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
 		{
-			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_skin->extras);
+			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_sampler->extras);
 		}
 		else
 		{
@@ -3112,27 +7524,9 @@ static int cgltf_parse_json_skin(cgltf_options* options, jsmntok_t const* tokens
 	return i;
 }
 
-static int cgltf_parse_json_skins(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
-{
-	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_skin), (void**)&out_data->skins, &out_data->skins_count);
-	if (i < 0)
-	{
-		return i;
-	}
-
-	for (cgltf_size j = 0; j < out_data->skins_count; ++j)
-	{
-		i = cgltf_parse_json_skin(options, tokens, i, json_chunk, &out_data->skins[j]);
-		if (i < 0)
-		{
-			return i;
-		}
-	}
-	return i;
-}
-
-static int cgltf_parse_json_camera(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_camera* out_camera)
+static int cgltf_parse_json_animation_channel(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_animation_channel* out_channel)
 {
+	(void)options;
 	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
 	int size = tokens[i].size;
@@ -3142,119 +7536,55 @@ static int cgltf_parse_json_camera(cgltf_options* options, jsmntok_t const* toke
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
-		{
-			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_camera->name);
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "type") == 0)
-		{
-			++i;
-			if (cgltf_json_strcmp(tokens + i, json_chunk, "perspective") == 0)
-			{
-				out_camera->type = cgltf_camera_type_perspective;
-			}
-			else if (cgltf_json_strcmp(tokens + i, json_chunk, "orthographic") == 0)
-			{
-				out_camera->type = cgltf_camera_type_orthographic;
-			}
-			++i;
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "perspective") == 0)
+		if (cgltf_json_strcmp(tokens+i, json_chunk, "sampler") == 0)
 		{
 			++i;
-
-			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
-
-			int data_size = tokens[i].size;
+			out_channel->sampler = CGLTF_PTRINDEX(cgltf_animation_sampler, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
-
-			out_camera->type = cgltf_camera_type_perspective;
-
-			for (int k = 0; k < data_size; ++k)
-			{
-				CGLTF_CHECK_KEY(tokens[i]);
-
-				if (cgltf_json_strcmp(tokens+i, json_chunk, "aspectRatio") == 0)
-				{
-					++i;
-					out_camera->perspective.aspect_ratio = cgltf_json_to_float(tokens + i, json_chunk);
-					++i;
-				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "yfov") == 0)
-				{
-					++i;
-					out_camera->perspective.yfov = cgltf_json_to_float(tokens + i, json_chunk);
-					++i;
-				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "zfar") == 0)
-				{
-					++i;
-					out_camera->perspective.zfar = cgltf_json_to_float(tokens + i, json_chunk);
-					++i;
-				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "znear") == 0)
-				{
-					++i;
-					out_camera->perspective.znear = cgltf_json_to_float(tokens + i, json_chunk);
-					++i;
-				}
-				else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
-				{
-					i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_camera->perspective.extras);
-				}
-				else
-				{
-					i = cgltf_skip_json(tokens, i+1);
-				}
-
-				if (i < 0)
-				{
-					return i;
-				}
-			}
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "orthographic") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "target") == 0)
 		{
 			++i;
 
 			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
-			int data_size = tokens[i].size;
+			int target_size = tokens[i].size;
 			++i;
 
-			out_camera->type = cgltf_camera_type_orthographic;
-
-			for (int k = 0; k < data_size; ++k)
+			for (int k = 0; k < target_size; ++k)
 			{
 				CGLTF_CHECK_KEY(tokens[i]);
 
-				if (cgltf_json_strcmp(tokens+i, json_chunk, "xmag") == 0)
-				{
-					++i;
-					out_camera->orthographic.xmag = cgltf_json_to_float(tokens + i, json_chunk);
-					++i;
-				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "ymag") == 0)
-				{
-					++i;
-					out_camera->orthographic.ymag = cgltf_json_to_float(tokens + i, json_chunk);
-					++i;
-				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "zfar") == 0)
+				if (cgltf_json_strcmp(tokens+i, json_chunk, "node") == 0)
 				{
 					++i;
-					out_camera->orthographic.zfar = cgltf_json_to_float(tokens + i, json_chunk);
+					out_channel->target_node = CGLTF_PTRINDEX(cgltf_node, cgltf_json_to_int(tokens + i, json_chunk));
 					++i;
 				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "znear") == 0)
+				else if (cgltf_json_strcmp(tokens+i, json_chunk, "path") == 0)
 				{
 					++i;
-					out_camera->orthographic.znear = cgltf_json_to_float(tokens + i, json_chunk);
+					if (cgltf_json_strcmp(tokens+i, json_chunk, "translation") == 0)
+					{
+						out_channel->target_path = cgltf_animation_path_type_translation;
+					}
+					else if (cgltf_json_strcmp(tokens+i, json_chunk, "rotation") == 0)
+					{
+						out_channel->target_path = cgltf_animation_path_type_rotation;
+					}
+					else if (cgltf_json_strcmp(tokens+i, json_chunk, "scale") == 0)
+					{
+						out_channel->target_path = cgltf_animation_path_type_scale;
+					}
+					else if (cgltf_json_strcmp(tokens+i, json_chunk, "weights") == 0)
+					{
+						out_channel->target_path = cgltf_animation_path_type_weights;
+					}
 					++i;
 				}
 				else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
 				{
-					i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_camera->orthographic.extras);
+					i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_channel->extras);
 				}
 				else
 				{
@@ -3267,9 +7597,72 @@ static int cgltf_parse_json_camera(cgltf_options* options, jsmntok_t const* toke
 				}
 			}
 		}
+		else
+		{
+			i = cgltf_skip_json(tokens, i+1);
+		}
+
+		if (i < 0)
+		{
+			return i;
+		}
+	}
+
+	return i;
+}
+
+static int cgltf_parse_json_animation(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_animation* out_animation)
+{
+	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+
+	int size = tokens[i].size;
+	++i;
+
+	for (int j = 0; j < size; ++j)
+	{
+		CGLTF_CHECK_KEY(tokens[i]);
+
+		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
+		{
+			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_animation->name);
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "samplers") == 0)
+		{
+			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_animation_sampler), (void**)&out_animation->samplers, &out_animation->samplers_count);
+			if (i < 0)
+			{
+				return i;
+			}
+
+			for (cgltf_size k = 0; k < out_animation->samplers_count; ++k)
+			{
+				i = cgltf_parse_json_animation_sampler(options, tokens, i, json_chunk, &out_animation->samplers[k]);
+				if (i < 0)
+				{
+					return i;
+				}
+			}
+		}
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "channels") == 0)
+		{
+			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_animation_channel), (void**)&out_animation->channels, &out_animation->channels_count);
+			if (i < 0)
+			{
+				return i;
+			}
+
+			for (cgltf_size k = 0; k < out_animation->channels_count; ++k)
+			{
+				i = cgltf_parse_json_animation_channel(options, tokens, i, json_chunk, &out_animation->channels[k]);
+				if (i < 0)
+				{
+					return i;
+				}
+			}
+		}
 		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
 		{
-			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_camera->extras);
+			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_animation->extras);
 		}
 		else
 		{
@@ -3285,17 +7678,17 @@ static int cgltf_parse_json_camera(cgltf_options* options, jsmntok_t const* toke
 	return i;
 }
 
-static int cgltf_parse_json_cameras(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
+static int cgltf_parse_json_animations(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
 {
-	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_camera), (void**)&out_data->cameras, &out_data->cameras_count);
+	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_animation), (void**)&out_data->animations, &out_data->animations_count);
 	if (i < 0)
 	{
 		return i;
 	}
 
-	for (cgltf_size j = 0; j < out_data->cameras_count; ++j)
+	for (cgltf_size j = 0; j < out_data->animations_count; ++j)
 	{
-		i = cgltf_parse_json_camera(options, tokens, i, json_chunk, &out_data->cameras[j]);
+		i = cgltf_parse_json_animation(options, tokens, i, json_chunk, &out_data->animations[j]);
 		if (i < 0)
 		{
 			return i;
@@ -3304,7 +7697,7 @@ static int cgltf_parse_json_cameras(cgltf_options* options, jsmntok_t const* tok
 	return i;
 }
 
-static int cgltf_parse_json_light(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_light* out_light)
+static int cgltf_parse_json_asset(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_asset* out_asset)
 {
 	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
@@ -3315,78 +7708,25 @@ static int cgltf_parse_json_light(cgltf_options* options, jsmntok_t const* token
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
-		{
-			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_light->name);
-		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "color") == 0)
+		if (cgltf_json_strcmp(tokens+i, json_chunk, "copyright") == 0)
 		{
-			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_light->color, 3);
+			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_asset->copyright);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "intensity") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "generator") == 0)
 		{
-			++i;
-			out_light->intensity = cgltf_json_to_float(tokens + i, json_chunk);
-			++i;
+			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_asset->generator);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "type") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "version") == 0)
 		{
-			++i;
-			if (cgltf_json_strcmp(tokens + i, json_chunk, "directional") == 0)
-			{
-				out_light->type = cgltf_light_type_directional;
-			}
-			else if (cgltf_json_strcmp(tokens + i, json_chunk, "point") == 0)
-			{
-				out_light->type = cgltf_light_type_point;
-			}
-			else if (cgltf_json_strcmp(tokens + i, json_chunk, "spot") == 0)
-			{
-				out_light->type = cgltf_light_type_spot;
-			}
-			++i;
+			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_asset->version);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "range") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "minVersion") == 0)
 		{
-			++i;
-			out_light->range = cgltf_json_to_float(tokens + i, json_chunk);
-			++i;
+			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_asset->min_version);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "spot") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
 		{
-			++i;
-
-			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
-
-			int data_size = tokens[i].size;
-			++i;
-
-			for (int k = 0; k < data_size; ++k)
-			{
-				CGLTF_CHECK_KEY(tokens[i]);
-
-				if (cgltf_json_strcmp(tokens+i, json_chunk, "innerConeAngle") == 0)
-				{
-					++i;
-					out_light->spot_inner_cone_angle = cgltf_json_to_float(tokens + i, json_chunk);
-					++i;
-				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "outerConeAngle") == 0)
-				{
-					++i;
-					out_light->spot_outer_cone_angle = cgltf_json_to_float(tokens + i, json_chunk);
-					++i;
-				}
-				else
-				{
-					i = cgltf_skip_json(tokens, i+1);
-				}
-
-				if (i < 0)
-				{
-					return i;
-				}
-			}
+			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_asset->extras);
 		}
 		else
 		{
@@ -3402,117 +7742,139 @@ static int cgltf_parse_json_light(cgltf_options* options, jsmntok_t const* token
 	return i;
 }
 
-static int cgltf_parse_json_lights(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
-{
-	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_light), (void**)&out_data->lights, &out_data->lights_count);
-	if (i < 0)
+static cgltf_size cgltf_num_components(cgltf_type type) {
+	switch (type)
 	{
-		return i;
+	case cgltf_type_vec2:
+		return 2;
+	case cgltf_type_vec3:
+		return 3;
+	case cgltf_type_vec4:
+		return 4;
+	case cgltf_type_mat2:
+		return 4;
+	case cgltf_type_mat3:
+		return 9;
+	case cgltf_type_mat4:
+		return 16;
+	case cgltf_type_invalid:
+	case cgltf_type_scalar:
+	default:
+		return 1;
 	}
+}
 
-	for (cgltf_size j = 0; j < out_data->lights_count; ++j)
+static cgltf_size cgltf_component_size(cgltf_component_type component_type) {
+	switch (component_type)
 	{
-		i = cgltf_parse_json_light(options, tokens, i, json_chunk, &out_data->lights[j]);
-		if (i < 0)
-		{
-			return i;
-		}
+	case cgltf_component_type_r_8:
+	case cgltf_component_type_r_8u:
+		return 1;
+	case cgltf_component_type_r_16:
+	case cgltf_component_type_r_16u:
+		return 2;
+	case cgltf_component_type_r_32u:
+	case cgltf_component_type_r_32f:
+		return 4;
+	case cgltf_component_type_invalid:
+	default:
+		return 0;
 	}
-	return i;
 }
 
-static int cgltf_parse_json_node(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_node* out_node)
+static cgltf_size cgltf_calc_size(cgltf_type type, cgltf_component_type component_type)
 {
-	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+	cgltf_size component_size = cgltf_component_size(component_type);
+	if (type == cgltf_type_mat2 && component_size == 1)
+	{
+		return 8 * component_size;
+	}
+	else if (type == cgltf_type_mat3 && (component_size == 1 || component_size == 2))
+	{
+		return 12 * component_size;
+	}
+	return component_size * cgltf_num_components(type);
+}
 
-	out_node->rotation[3] = 1.0f;
-	out_node->scale[0] = 1.0f;
-	out_node->scale[1] = 1.0f;
-	out_node->scale[2] = 1.0f;
-	out_node->matrix[0] = 1.0f;
-	out_node->matrix[5] = 1.0f;
-	out_node->matrix[10] = 1.0f;
-	out_node->matrix[15] = 1.0f;
+static int cgltf_fixup_pointers(const cgltf_options* options, cgltf_data* out_data);
+
+static int cgltf_parse_json_root(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
+{
+	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
 
 	int size = tokens[i].size;
+	int sections = options->sections;
 	++i;
 
 	for (int j = 0; j < size; ++j)
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
+		if (cgltf_json_strcmp(tokens + i, json_chunk, "asset") == 0)
+		{
+			i = cgltf_parse_json_asset(options, tokens, i + 1, json_chunk, &out_data->asset);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "meshes") == 0)
+		{
+			i = (sections & cgltf_section_meshes) ? cgltf_parse_json_meshes(options, tokens, i + 1, json_chunk, out_data) : cgltf_skip_json(tokens, i + 1);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "accessors") == 0)
+		{
+			i = (sections & cgltf_section_accessors) ? cgltf_parse_json_accessors(options, tokens, i + 1, json_chunk, out_data) : cgltf_skip_json(tokens, i + 1);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "bufferViews") == 0)
+		{
+			i = (sections & cgltf_section_buffer_views) ? cgltf_parse_json_buffer_views(options, tokens, i + 1, json_chunk, out_data) : cgltf_skip_json(tokens, i + 1);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "buffers") == 0)
+		{
+			i = (sections & cgltf_section_buffers) ? cgltf_parse_json_buffers(options, tokens, i + 1, json_chunk, out_data) : cgltf_skip_json(tokens, i + 1);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "materials") == 0)
 		{
-			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_node->name);
+			i = (sections & cgltf_section_materials) ? cgltf_parse_json_materials(options, tokens, i + 1, json_chunk, out_data) : cgltf_skip_json(tokens, i + 1);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "children") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "images") == 0)
 		{
-			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_node*), (void**)&out_node->children, &out_node->children_count);
-			if (i < 0)
-			{
-				return i;
-			}
-
-			for (cgltf_size k = 0; k < out_node->children_count; ++k)
-			{
-				out_node->children[k] = CGLTF_PTRINDEX(cgltf_node, cgltf_json_to_int(tokens + i, json_chunk));
-				++i;
-			}
+			i = (sections & cgltf_section_images) ? cgltf_parse_json_images(options, tokens, i + 1, json_chunk, out_data) : cgltf_skip_json(tokens, i + 1);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "mesh") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "textures") == 0)
 		{
-			++i;
-			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_PRIMITIVE);
-			out_node->mesh = CGLTF_PTRINDEX(cgltf_mesh, cgltf_json_to_int(tokens + i, json_chunk));
-			++i;
+			i = (sections & cgltf_section_textures) ? cgltf_parse_json_textures(options, tokens, i + 1, json_chunk, out_data) : cgltf_skip_json(tokens, i + 1);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "skin") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "samplers") == 0)
 		{
-			++i;
-			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_PRIMITIVE);
-			out_node->skin = CGLTF_PTRINDEX(cgltf_skin, cgltf_json_to_int(tokens + i, json_chunk));
-			++i;
+			i = (sections & cgltf_section_samplers) ? cgltf_parse_json_samplers(options, tokens, i + 1, json_chunk, out_data) : cgltf_skip_json(tokens, i + 1);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "camera") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "skins") == 0)
 		{
-			++i;
-			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_PRIMITIVE);
-			out_node->camera = CGLTF_PTRINDEX(cgltf_camera, cgltf_json_to_int(tokens + i, json_chunk));
-			++i;
+			i = (sections & cgltf_section_skins) ? cgltf_parse_json_skins(options, tokens, i + 1, json_chunk, out_data) : cgltf_skip_json(tokens, i + 1);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "translation") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "cameras") == 0)
 		{
-			out_node->has_translation = 1;
-			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_node->translation, 3);
+			i = (sections & cgltf_section_cameras) ? cgltf_parse_json_cameras(options, tokens, i + 1, json_chunk, out_data) : cgltf_skip_json(tokens, i + 1);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "rotation") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "nodes") == 0)
 		{
-			out_node->has_rotation = 1;
-			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_node->rotation, 4);
+			i = (sections & cgltf_section_nodes) ? cgltf_parse_json_nodes(options, tokens, i + 1, json_chunk, out_data) : cgltf_skip_json(tokens, i + 1);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "scale") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "scenes") == 0)
 		{
-			out_node->has_scale = 1;
-			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_node->scale, 3);
+			i = (sections & cgltf_section_scenes) ? cgltf_parse_json_scenes(options, tokens, i + 1, json_chunk, out_data) : cgltf_skip_json(tokens, i + 1);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "matrix") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "scene") == 0)
 		{
-			out_node->has_matrix = 1;
-			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_node->matrix, 16);
+			++i;
+			out_data->scene = CGLTF_PTRINDEX(cgltf_scene, cgltf_json_to_int(tokens + i, json_chunk));
+			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "weights") == 0)
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "animations") == 0)
 		{
-			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_float), (void**)&out_node->weights, &out_node->weights_count);
-			if (i < 0)
-			{
-				return i;
-			}
-
-			i = cgltf_parse_json_float_array(tokens, i - 1, json_chunk, out_node->weights, (int)out_node->weights_count);
+			i = (sections & cgltf_section_animations) ? cgltf_parse_json_animations(options, tokens, i + 1, json_chunk, out_data) : cgltf_skip_json(tokens, i + 1);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (cgltf_json_strcmp(tokens+i, json_chunk, "extras") == 0)
 		{
-			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_node->extras);
+			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_data->extras);
 		}
 		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extensions") == 0)
 		{
@@ -3540,12 +7902,9 @@ static int cgltf_parse_json_node(cgltf_options* options, jsmntok_t const* tokens
 					{
 						CGLTF_CHECK_KEY(tokens[i]);
 
-						if (cgltf_json_strcmp(tokens + i, json_chunk, "light") == 0)
+						if (cgltf_json_strcmp(tokens + i, json_chunk, "lights") == 0)
 						{
-							++i;
-							CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_PRIMITIVE);
-							out_node->light = CGLTF_PTRINDEX(cgltf_light, cgltf_json_to_int(tokens + i, json_chunk));
-							++i;
+							i = (sections & cgltf_section_lights) ? cgltf_parse_json_lights(options, tokens, i + 1, json_chunk, out_data) : cgltf_skip_json(tokens, i + 1);
 						}
 						else
 						{
@@ -3560,7 +7919,7 @@ static int cgltf_parse_json_node(cgltf_options* options, jsmntok_t const* tokens
 				}
 				else
 				{
-					i = cgltf_skip_json(tokens, i+1);
+					i = cgltf_skip_json(tokens, i + 1);
 				}
 
 				if (i < 0)
@@ -3569,9 +7928,17 @@ static int cgltf_parse_json_node(cgltf_options* options, jsmntok_t const* tokens
 				}
 			}
 		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extensionsUsed") == 0)
+		{
+			i = cgltf_parse_json_string_array(options, tokens, i + 1, json_chunk, &out_data->extensions_used, &out_data->extensions_used_count);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extensionsRequired") == 0)
+		{
+			i = cgltf_parse_json_string_array(options, tokens, i + 1, json_chunk, &out_data->extensions_required, &out_data->extensions_required_count);
+		}
 		else
 		{
-			i = cgltf_skip_json(tokens, i+1);
+			i = cgltf_skip_json(tokens, i + 1);
 		}
 
 		if (i < 0)
@@ -3583,693 +7950,793 @@ static int cgltf_parse_json_node(cgltf_options* options, jsmntok_t const* tokens
 	return i;
 }
 
-static int cgltf_parse_json_nodes(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
+static void cgltf_context_keep_tokens(const cgltf_options* options, jsmntok_t* tokens, cgltf_size token_count)
 {
-	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_node), (void**)&out_data->nodes, &out_data->nodes_count);
-	if (i < 0)
+	cgltf_context* context = options->context;
+
+	if (context->tokens)
 	{
-		return i;
+		context->memory_free(context->memory_user_data, context->tokens);
 	}
 
-	for (cgltf_size j = 0; j < out_data->nodes_count; ++j)
+	cgltf_options caller_options = cgltf_caller_options(options);
+	context->tokens = tokens;
+	context->tokens_capacity = token_count;
+	context->memory_free = caller_options.memory_free;
+	context->memory_user_data = caller_options.memory_user_data;
+}
+
+static void cgltf_free_tokens(const cgltf_options* options, jsmntok_t* tokens)
+{
+	// Tokens allocated for a context stay with it for the next call
+	if (!options->context)
 	{
-		i = cgltf_parse_json_node(options, tokens, i, json_chunk, &out_data->nodes[j]);
-		if (i < 0)
-		{
-			return i;
-		}
+		options->memory_free(options->memory_user_data, tokens);
 	}
-	return i;
 }
 
-static int cgltf_parse_json_scene(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_scene* out_scene)
+static cgltf_result cgltf_tokenize_json(cgltf_options* options, const uint8_t* json_chunk, cgltf_size size, jsmntok_t** out_tokens)
 {
-	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+	jsmn_parser parser;
+	jsmn_init(&parser);
 
-	int size = tokens[i].size;
-	++i;
+	// Without a token count, start with an estimate and grow the token array whenever jsmn runs out of tokens.
+	// jsmn resumes where it stopped, so the chunk is only tokenized once.
+	cgltf_size token_count = options->json_token_count ? options->json_token_count : size / 16 + 64;
+	cgltf_context* context = options->context;
+	jsmntok_t* tokens = NULL;
 
-	for (int j = 0; j < size; ++j)
+	if (context && context->tokens_capacity >= token_count)
 	{
-		CGLTF_CHECK_KEY(tokens[i]);
+		tokens = (jsmntok_t*)context->tokens;
+		token_count = options->json_token_count ? token_count : context->tokens_capacity;
+	}
+	else
+	{
+		tokens = (jsmntok_t*)options->memory_alloc(options->memory_user_data, sizeof(jsmntok_t) * token_count);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
+		if (!tokens)
 		{
-			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_scene->name);
+			return cgltf_result_out_of_memory;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "nodes") == 0)
+
+		if (context)
 		{
-			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_node*), (void**)&out_scene->nodes, &out_scene->nodes_count);
-			if (i < 0)
-			{
-				return i;
-			}
+			cgltf_context_keep_tokens(options, tokens, token_count);
+		}
+	}
 
-			for (cgltf_size k = 0; k < out_scene->nodes_count; ++k)
-			{
-				out_scene->nodes[k] = CGLTF_PTRINDEX(cgltf_node, cgltf_json_to_int(tokens + i, json_chunk));
-				++i;
-			}
+	int result = jsmn_parse(&parser, (const char*)json_chunk, size, tokens, token_count);
+
+	while (result == JSMN_ERROR_NOMEM && options->json_token_count == 0)
+	{
+		jsmntok_t* new_tokens = (jsmntok_t*)options->memory_alloc(options->memory_user_data, sizeof(jsmntok_t) * token_count * 2);
+
+		if (!new_tokens)
+		{
+			cgltf_free_tokens(options, tokens);
+			return cgltf_result_out_of_memory;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+
+		memcpy(new_tokens, tokens, sizeof(jsmntok_t) * parser.toknext);
+
+		if (context)
 		{
-			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_scene->extras);
+			cgltf_context_keep_tokens(options, new_tokens, token_count * 2);
 		}
 		else
 		{
-			i = cgltf_skip_json(tokens, i+1);
+			options->memory_free(options->memory_user_data, tokens);
 		}
 
-		if (i < 0)
-		{
-			return i;
-		}
+		tokens = new_tokens;
+		token_count *= 2;
+
+		result = jsmn_parse(&parser, (const char*)json_chunk, size, tokens, token_count);
 	}
 
-	return i;
+	if (result <= 0)
+	{
+		cgltf_free_tokens(options, tokens);
+		return cgltf_result_invalid_json;
+	}
+
+	if (options->stats)
+	{
+		options->stats->tokens_count += (cgltf_size)result;
+		options->stats->json_size += size;
+	}
+
+	*out_tokens = tokens;
+
+	return cgltf_result_success;
 }
 
-static int cgltf_parse_json_scenes(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
+static int cgltf_section_dependencies(int sections)
 {
-	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_scene), (void**)&out_data->scenes, &out_data->scenes_count);
-	if (i < 0)
+	if (sections == 0)
 	{
-		return i;
+		return cgltf_section_all;
 	}
 
-	for (cgltf_size j = 0; j < out_data->scenes_count; ++j)
+	// Follow the required references, in an order that also resolves transitive ones
+	if (sections & (cgltf_section_meshes | cgltf_section_skins | cgltf_section_animations))
 	{
-		i = cgltf_parse_json_scene(options, tokens, i, json_chunk, &out_data->scenes[j]);
-		if (i < 0)
-		{
-			return i;
-		}
+		sections |= cgltf_section_accessors;
 	}
-	return i;
+
+	if (sections & (cgltf_section_skins | cgltf_section_animations | cgltf_section_scenes))
+	{
+		sections |= cgltf_section_nodes;
+	}
+
+	if (sections & (cgltf_section_accessors | cgltf_section_images))
+	{
+		sections |= cgltf_section_buffer_views;
+	}
+
+	if (sections & cgltf_section_buffer_views)
+	{
+		sections |= cgltf_section_buffers;
+	}
+
+	return sections;
 }
 
-static int cgltf_parse_json_animation_sampler(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_animation_sampler* out_sampler)
+cgltf_result cgltf_parse_json(cgltf_options* options, const uint8_t* json_chunk, cgltf_size size, cgltf_data** out_data)
 {
-	(void)options;
-	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+	jsmntok_t* tokens = NULL;
+	cgltf_stats* stats = options->stats;
+	double start = cgltf_stats_clock(stats);
 
-	int size = tokens[i].size;
-	++i;
+	cgltf_result token_result = cgltf_tokenize_json(options, json_chunk, size, &tokens);
 
-	for (int j = 0; j < size; ++j)
+	if (stats)
 	{
-		CGLTF_CHECK_KEY(tokens[i]);
+		double now = cgltf_stats_clock(stats);
+		stats->tokenize_time += now - start;
+		start = now;
+	}
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "input") == 0)
-		{
-			++i;
-			out_sampler->input = CGLTF_PTRINDEX(cgltf_accessor, cgltf_json_to_int(tokens + i, json_chunk));
-			++i;
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "output") == 0)
-		{
-			++i;
-			out_sampler->output = CGLTF_PTRINDEX(cgltf_accessor, cgltf_json_to_int(tokens + i, json_chunk));
-			++i;
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "interpolation") == 0)
-		{
-			++i;
-			if (cgltf_json_strcmp(tokens + i, json_chunk, "LINEAR") == 0)
-			{
-				out_sampler->interpolation = cgltf_interpolation_type_linear;
-			}
-			else if (cgltf_json_strcmp(tokens + i, json_chunk, "STEP") == 0)
-			{
-				out_sampler->interpolation = cgltf_interpolation_type_step;
-			}
-			else if (cgltf_json_strcmp(tokens + i, json_chunk, "CUBICSPLINE") == 0)
-			{
-				out_sampler->interpolation = cgltf_interpolation_type_cubic_spline;
-			}
-			++i;
-		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+	if (token_result != cgltf_result_success)
+	{
+		return token_result;
+	}
+
+	cgltf_data* data = (cgltf_data*)options->memory_alloc(options->memory_user_data, sizeof(cgltf_data));
+
+	if (!data)
+	{
+		cgltf_free_tokens(options, tokens);
+		return cgltf_result_out_of_memory;
+	}
+
+	cgltf_options caller_options = cgltf_caller_options(options);
+	memset(data, 0, sizeof(cgltf_data));
+	data->memory_free = caller_options.memory_free;
+	data->memory_user_data = caller_options.memory_user_data;
+	data->file_release = options->file_release;
+	data->file_user_data = options->file_user_data;
+	data->json = (const char*)json_chunk;
+	data->json_size = size;
+
+	cgltf_options parse_options = *options;
+	parse_options.sections = cgltf_section_dependencies(options->sections);
+	const uint8_t* parse_chunk = json_chunk;
+
+	if (options->arena_allocation)
+	{
+		// The parsed objects tend to take about as much memory as the JSON they are parsed from
+		cgltf_size arena_size = (options->strings_in_place ? size * 2 : size) + 4096;
+		data->arena = cgltf_arena_create(options, arena_size);
+
+		if (!data->arena)
 		{
-			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_sampler->extras);
+			cgltf_free_tokens(options, tokens);
+			options->memory_free(options->memory_user_data, data);
+			return cgltf_result_out_of_memory;
 		}
-		else
+
+		parse_options.memory_alloc = &cgltf_arena_alloc;
+		parse_options.memory_free = &cgltf_arena_free;
+		parse_options.memory_user_data = data->arena;
+		// Only the blocks of the arena count as allocations
+		parse_options.stats = NULL;
+	}
+
+	if (options->strings_in_place)
+	{
+		data->json_copy = (char*)parse_options.memory_alloc(parse_options.memory_user_data, size);
+
+		if (!data->json_copy)
 		{
-			i = cgltf_skip_json(tokens, i+1);
+			cgltf_free_tokens(options, tokens);
+			cgltf_free(data);
+			return cgltf_result_out_of_memory;
 		}
 
-		if (i < 0)
-		{
-			return i;
-		}
+		memcpy(data->json_copy, json_chunk, size);
+		parse_chunk = (const uint8_t*)data->json_copy;
+	}
+
+	int i = cgltf_parse_json_root(&parse_options, tokens, 0, parse_chunk, data);
+
+	cgltf_free_tokens(options, tokens);
+
+	if (stats)
+	{
+		double now = cgltf_stats_clock(stats);
+		stats->parse_time += now - start;
+		start = now;
+	}
+
+	if (i < 0)
+	{
+		cgltf_free(data);
+		return (i == CGLTF_ERROR_NOMEM) ? cgltf_result_out_of_memory : cgltf_result_invalid_gltf;
+	}
+
+	i = cgltf_fixup_pointers(&parse_options, data);
+
+	if (stats)
+	{
+		stats->fixup_time += cgltf_stats_clock(stats) - start;
+	}
+
+	if (i < 0)
+	{
+		cgltf_free(data);
+		return (i == CGLTF_ERROR_NOMEM) ? cgltf_result_out_of_memory : cgltf_result_invalid_gltf;
+	}
+
+	*out_data = data;
+
+	return cgltf_result_success;
+}
+
+static cgltf_size cgltf_scan_json_whitespace(const char* json, cgltf_size size, cgltf_size i)
+{
+	while (i < size && (json[i] == ' ' || json[i] == '\t' || json[i] == '\n' || json[i] == '\r'))
+	{
+		++i;
 	}
 
 	return i;
 }
 
-static int cgltf_parse_json_animation_channel(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_animation_channel* out_channel)
+static int cgltf_scan_json_string(const char* json, cgltf_size size, cgltf_size* pos, cgltf_json_span* out_string)
 {
-	(void)options;
-	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
-
-	int size = tokens[i].size;
-	++i;
+	cgltf_size i = *pos;
 
-	for (int j = 0; j < size; ++j)
+	if (i >= size || json[i] != '"')
 	{
-		CGLTF_CHECK_KEY(tokens[i]);
+		return CGLTF_ERROR_JSON;
+	}
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "sampler") == 0)
+	for (++i; i < size; ++i)
+	{
+		if (json[i] == '\\')
 		{
 			++i;
-			out_channel->sampler = CGLTF_PTRINDEX(cgltf_animation_sampler, cgltf_json_to_int(tokens + i, json_chunk));
-			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "target") == 0)
+		else if (json[i] == '"')
 		{
-			++i;
-
-			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
-
-			int target_size = tokens[i].size;
-			++i;
-
-			for (int k = 0; k < target_size; ++k)
+			if (out_string)
 			{
-				CGLTF_CHECK_KEY(tokens[i]);
-
-				if (cgltf_json_strcmp(tokens+i, json_chunk, "node") == 0)
-				{
-					++i;
-					out_channel->target_node = CGLTF_PTRINDEX(cgltf_node, cgltf_json_to_int(tokens + i, json_chunk));
-					++i;
-				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "path") == 0)
-				{
-					++i;
-					if (cgltf_json_strcmp(tokens+i, json_chunk, "translation") == 0)
-					{
-						out_channel->target_path = cgltf_animation_path_type_translation;
-					}
-					else if (cgltf_json_strcmp(tokens+i, json_chunk, "rotation") == 0)
-					{
-						out_channel->target_path = cgltf_animation_path_type_rotation;
-					}
-					else if (cgltf_json_strcmp(tokens+i, json_chunk, "scale") == 0)
-					{
-						out_channel->target_path = cgltf_animation_path_type_scale;
-					}
-					else if (cgltf_json_strcmp(tokens+i, json_chunk, "weights") == 0)
-					{
-						out_channel->target_path = cgltf_animation_path_type_weights;
-					}
-					++i;
-				}
-				else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
-				{
-					i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_channel->extras);
-				}
-				else
-				{
-					i = cgltf_skip_json(tokens, i+1);
-				}
-
-				if (i < 0)
-				{
-					return i;
-				}
+				out_string->data = json + *pos + 1;
+				out_string->size = i - *pos - 1;
 			}
-		}
-		else
-		{
-			i = cgltf_skip_json(tokens, i+1);
-		}
 
-		if (i < 0)
-		{
-			return i;
+			*pos = i + 1;
+			return 0;
 		}
 	}
 
-	return i;
+	return CGLTF_ERROR_JSON;
 }
 
-static int cgltf_parse_json_animation(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_animation* out_animation)
+static int cgltf_scan_json_value(const char* json, cgltf_size size, cgltf_size* pos)
 {
-	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+	cgltf_size i = *pos;
 
-	int size = tokens[i].size;
-	++i;
+	if (i < size && json[i] == '"')
+	{
+		return cgltf_scan_json_string(json, size, pos, NULL);
+	}
 
-	for (int j = 0; j < size; ++j)
+	if (i < size && (json[i] == '{' || json[i] == '['))
 	{
-		CGLTF_CHECK_KEY(tokens[i]);
+		// Skip nested values by matching brackets, without validating what is inside them
+		int depth = 0;
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
+		while (i < size)
 		{
-			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_animation->name);
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "samplers") == 0)
-		{
-			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_animation_sampler), (void**)&out_animation->samplers, &out_animation->samplers_count);
-			if (i < 0)
-			{
-				return i;
-			}
+			char c = json[i];
 
-			for (cgltf_size k = 0; k < out_animation->samplers_count; ++k)
+			if (c == '"')
 			{
-				i = cgltf_parse_json_animation_sampler(options, tokens, i, json_chunk, &out_animation->samplers[k]);
-				if (i < 0)
+				if (cgltf_scan_json_string(json, size, &i, NULL) < 0)
 				{
-					return i;
+					return CGLTF_ERROR_JSON;
 				}
+
+				continue;
 			}
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "channels") == 0)
-		{
-			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_animation_channel), (void**)&out_animation->channels, &out_animation->channels_count);
-			if (i < 0)
+
+			++i;
+
+			if (c == '{' || c == '[')
 			{
-				return i;
+				++depth;
 			}
-
-			for (cgltf_size k = 0; k < out_animation->channels_count; ++k)
+			else if ((c == '}' || c == ']') && --depth == 0)
 			{
-				i = cgltf_parse_json_animation_channel(options, tokens, i, json_chunk, &out_animation->channels[k]);
-				if (i < 0)
-				{
-					return i;
-				}
+				*pos = i;
+				return 0;
 			}
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
-		{
-			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_animation->extras);
-		}
-		else
-		{
-			i = cgltf_skip_json(tokens, i+1);
-		}
 
-		if (i < 0)
-		{
-			return i;
-		}
+		return CGLTF_ERROR_JSON;
 	}
 
-	return i;
-}
-
-static int cgltf_parse_json_animations(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
-{
-	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_animation), (void**)&out_data->animations, &out_data->animations_count);
-	if (i < 0)
+	while (i < size && json[i] != ',' && json[i] != '}' && json[i] != ']' && json[i] != ':' &&
+		json[i] != ' ' && json[i] != '\t' && json[i] != '\n' && json[i] != '\r')
 	{
-		return i;
+		++i;
 	}
 
-	for (cgltf_size j = 0; j < out_data->animations_count; ++j)
+	if (i == *pos)
 	{
-		i = cgltf_parse_json_animation(options, tokens, i, json_chunk, &out_data->animations[j]);
-		if (i < 0)
-		{
-			return i;
-		}
+		return CGLTF_ERROR_JSON;
 	}
-	return i;
+
+	*pos = i;
+	return 0;
 }
 
-static int cgltf_parse_json_asset(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_asset* out_asset)
+static int cgltf_scan_json_key(const char* json, cgltf_size size, cgltf_size* pos, cgltf_json_span* out_key)
 {
-	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+	// Steps from the opening brace or the end of the previous value to the value of the next key.
+	// Returns 1 if there is another key and 0 at the end of the object.
+	cgltf_size i = cgltf_scan_json_whitespace(json, size, *pos);
 
-	int size = tokens[i].size;
-	++i;
+	if (i >= size)
+	{
+		return CGLTF_ERROR_JSON;
+	}
 
-	for (int j = 0; j < size; ++j)
+	char c = json[i];
+	i = cgltf_scan_json_whitespace(json, size, i + 1);
+
+	if (c == '}' || (c == '{' && i < size && json[i] == '}'))
 	{
-		CGLTF_CHECK_KEY(tokens[i]);
+		*pos = c == '}' ? i : i + 1;
+		return 0;
+	}
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "copyright") == 0)
-		{
-			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_asset->copyright);
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "generator") == 0)
-		{
-			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_asset->generator);
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "version") == 0)
-		{
-			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_asset->version);
-		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "minVersion") == 0)
-		{
-			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_asset->min_version);
-		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
-		{
-			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_asset->extras);
-		}
-		else
-		{
-			i = cgltf_skip_json(tokens, i+1);
-		}
+	if ((c != '{' && c != ',') || cgltf_scan_json_string(json, size, &i, out_key) < 0)
+	{
+		return CGLTF_ERROR_JSON;
+	}
 
-		if (i < 0)
-		{
-			return i;
-		}
+	i = cgltf_scan_json_whitespace(json, size, i);
+
+	if (i >= size || json[i] != ':')
+	{
+		return CGLTF_ERROR_JSON;
 	}
 
-	return i;
+	*pos = cgltf_scan_json_whitespace(json, size, i + 1);
+	return 1;
 }
 
-static cgltf_size cgltf_num_components(cgltf_type type) {
-	switch (type)
+static int cgltf_scan_json_array(const char* json, cgltf_size size, cgltf_size* pos, cgltf_json_span* out_array, cgltf_size* out_count)
+{
+	cgltf_size i = *pos;
+
+	if (i >= size || json[i] != '[')
 	{
-	case cgltf_type_vec2:
-		return 2;
-	case cgltf_type_vec3:
-		return 3;
-	case cgltf_type_vec4:
-		return 4;
-	case cgltf_type_mat2:
-		return 4;
-	case cgltf_type_mat3:
-		return 9;
-	case cgltf_type_mat4:
-		return 16;
-	case cgltf_type_invalid:
-	case cgltf_type_scalar:
-	default:
-		return 1;
+		return CGLTF_ERROR_JSON;
 	}
-}
 
-static cgltf_size cgltf_component_size(cgltf_component_type component_type) {
-	switch (component_type)
+	cgltf_size count = 0;
+	i = cgltf_scan_json_whitespace(json, size, i + 1);
+
+	while (i < size && json[i] != ']')
 	{
-	case cgltf_component_type_r_8:
-	case cgltf_component_type_r_8u:
-		return 1;
-	case cgltf_component_type_r_16:
-	case cgltf_component_type_r_16u:
-		return 2;
-	case cgltf_component_type_r_32u:
-	case cgltf_component_type_r_32f:
-		return 4;
-	case cgltf_component_type_invalid:
-	default:
-		return 0;
+		if (count > 0)
+		{
+			if (json[i] != ',')
+			{
+				return CGLTF_ERROR_JSON;
+			}
+
+			i = cgltf_scan_json_whitespace(json, size, i + 1);
+		}
+
+		if (cgltf_scan_json_value(json, size, &i) < 0)
+		{
+			return CGLTF_ERROR_JSON;
+		}
+
+		++count;
+		i = cgltf_scan_json_whitespace(json, size, i);
+	}
+
+	if (i >= size)
+	{
+		return CGLTF_ERROR_JSON;
+	}
+
+	if (out_array)
+	{
+		out_array->data = json + *pos;
+		out_array->size = i + 1 - *pos;
 	}
+
+	*out_count = count;
+	*pos = i + 1;
+	return 0;
 }
 
-static cgltf_size cgltf_calc_size(cgltf_type type, cgltf_component_type component_type)
+#define cgltf_scan_json_key_is(key_, str_) ((key_).size == sizeof(str_) - 1 && memcmp((key_).data, (str_), sizeof(str_) - 1) == 0)
+
+static int cgltf_scan_json_asset(const char* json, cgltf_size size, cgltf_size* pos, cgltf_asset_info* out_info)
 {
-	cgltf_size component_size = cgltf_component_size(component_type);
-	if (type == cgltf_type_mat2 && component_size == 1)
+	cgltf_json_span key;
+	int result;
+
+	if (*pos >= size || json[*pos] != '{')
 	{
-		return 8 * component_size;
+		return CGLTF_ERROR_JSON;
 	}
-	else if (type == cgltf_type_mat3 && (component_size == 1 || component_size == 2))
+
+	while ((result = cgltf_scan_json_key(json, size, pos, &key)) > 0)
 	{
-		return 12 * component_size;
+		if (cgltf_scan_json_key_is(key, "copyright"))
+		{
+			result = cgltf_scan_json_string(json, size, pos, &out_info->copyright);
+		}
+		else if (cgltf_scan_json_key_is(key, "generator"))
+		{
+			result = cgltf_scan_json_string(json, size, pos, &out_info->generator);
+		}
+		else if (cgltf_scan_json_key_is(key, "version"))
+		{
+			result = cgltf_scan_json_string(json, size, pos, &out_info->version);
+		}
+		else if (cgltf_scan_json_key_is(key, "minVersion"))
+		{
+			result = cgltf_scan_json_string(json, size, pos, &out_info->min_version);
+		}
+		else
+		{
+			result = cgltf_scan_json_value(json, size, pos);
+		}
+
+		if (result < 0)
+		{
+			return result;
+		}
 	}
-	return component_size * cgltf_num_components(type);
-}
 
-static int cgltf_fixup_pointers(cgltf_data* out_data);
+	return result;
+}
 
-static int cgltf_parse_json_root(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
+static int cgltf_scan_json_extensions(const char* json, cgltf_size size, cgltf_size* pos, cgltf_asset_info* out_info)
 {
-	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
+	cgltf_json_span key;
+	int result;
 
-	int size = tokens[i].size;
-	++i;
+	if (*pos >= size || json[*pos] != '{')
+	{
+		return CGLTF_ERROR_JSON;
+	}
 
-	for (int j = 0; j < size; ++j)
+	while ((result = cgltf_scan_json_key(json, size, pos, &key)) > 0)
 	{
-		CGLTF_CHECK_KEY(tokens[i]);
+		if (cgltf_scan_json_key_is(key, "KHR_lights_punctual") && *pos < size && json[*pos] == '{')
+		{
+			cgltf_json_span light_key;
 
-		if (cgltf_json_strcmp(tokens + i, json_chunk, "asset") == 0)
+			while ((result = cgltf_scan_json_key(json, size, pos, &light_key)) > 0)
+			{
+				if (cgltf_scan_json_key_is(light_key, "lights"))
+				{
+					result = cgltf_scan_json_array(json, size, pos, NULL, &out_info->lights_count);
+				}
+				else
+				{
+					result = cgltf_scan_json_value(json, size, pos);
+				}
+
+				if (result < 0)
+				{
+					return result;
+				}
+			}
+		}
+		else
 		{
-			i = cgltf_parse_json_asset(options, tokens, i + 1, json_chunk, &out_data->asset);
+			result = cgltf_scan_json_value(json, size, pos);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "meshes") == 0)
+
+		if (result < 0)
 		{
-			i = cgltf_parse_json_meshes(options, tokens, i + 1, json_chunk, out_data);
+			return result;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "accessors") == 0)
+	}
+
+	return result;
+}
+
+static int cgltf_scan_json_root(const char* json, cgltf_size size, cgltf_asset_info* out_info)
+{
+	cgltf_size i = cgltf_scan_json_whitespace(json, size, 0);
+	cgltf_json_span key;
+	int result;
+
+	if (i >= size || json[i] != '{')
+	{
+		return CGLTF_ERROR_JSON;
+	}
+
+	while ((result = cgltf_scan_json_key(json, size, &i, &key)) > 0)
+	{
+		cgltf_size* count = NULL;
+
+		if (cgltf_scan_json_key_is(key, "asset"))
 		{
-			i = cgltf_parse_json_accessors(options, tokens, i + 1, json_chunk, out_data);
+			result = cgltf_scan_json_asset(json, size, &i, out_info);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "bufferViews") == 0)
+		else if (cgltf_scan_json_key_is(key, "extensionsUsed"))
 		{
-			i = cgltf_parse_json_buffer_views(options, tokens, i + 1, json_chunk, out_data);
+			result = cgltf_scan_json_array(json, size, &i, &out_info->extensions_used, &out_info->extensions_used_count);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "buffers") == 0)
+		else if (cgltf_scan_json_key_is(key, "extensionsRequired"))
 		{
-			i = cgltf_parse_json_buffers(options, tokens, i + 1, json_chunk, out_data);
+			result = cgltf_scan_json_array(json, size, &i, &out_info->extensions_required, &out_info->extensions_required_count);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "materials") == 0)
+		else if (cgltf_scan_json_key_is(key, "extensions"))
 		{
-			i = cgltf_parse_json_materials(options, tokens, i + 1, json_chunk, out_data);
+			result = cgltf_scan_json_extensions(json, size, &i, out_info);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "images") == 0)
+		else if (cgltf_scan_json_key_is(key, "meshes"))
 		{
-			i = cgltf_parse_json_images(options, tokens, i + 1, json_chunk, out_data);
+			count = &out_info->meshes_count;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "textures") == 0)
+		else if (cgltf_scan_json_key_is(key, "materials"))
 		{
-			i = cgltf_parse_json_textures(options, tokens, i + 1, json_chunk, out_data);
+			count = &out_info->materials_count;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "samplers") == 0)
+		else if (cgltf_scan_json_key_is(key, "accessors"))
 		{
-			i = cgltf_parse_json_samplers(options, tokens, i + 1, json_chunk, out_data);
+			count = &out_info->accessors_count;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "skins") == 0)
+		else if (cgltf_scan_json_key_is(key, "bufferViews"))
 		{
-			i = cgltf_parse_json_skins(options, tokens, i + 1, json_chunk, out_data);
+			count = &out_info->buffer_views_count;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "cameras") == 0)
+		else if (cgltf_scan_json_key_is(key, "buffers"))
 		{
-			i = cgltf_parse_json_cameras(options, tokens, i + 1, json_chunk, out_data);
+			count = &out_info->buffers_count;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "nodes") == 0)
+		else if (cgltf_scan_json_key_is(key, "images"))
 		{
-			i = cgltf_parse_json_nodes(options, tokens, i + 1, json_chunk, out_data);
+			count = &out_info->images_count;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "scenes") == 0)
+		else if (cgltf_scan_json_key_is(key, "textures"))
 		{
-			i = cgltf_parse_json_scenes(options, tokens, i + 1, json_chunk, out_data);
+			count = &out_info->textures_count;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "scene") == 0)
+		else if (cgltf_scan_json_key_is(key, "samplers"))
 		{
-			++i;
-			out_data->scene = CGLTF_PTRINDEX(cgltf_scene, cgltf_json_to_int(tokens + i, json_chunk));
-			++i;
+			count = &out_info->samplers_count;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "animations") == 0)
+		else if (cgltf_scan_json_key_is(key, "skins"))
 		{
-			i = cgltf_parse_json_animations(options, tokens, i + 1, json_chunk, out_data);
+			count = &out_info->skins_count;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "extras") == 0)
+		else if (cgltf_scan_json_key_is(key, "cameras"))
 		{
-			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_data->extras);
+			count = &out_info->cameras_count;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extensions") == 0)
+		else if (cgltf_scan_json_key_is(key, "nodes"))
 		{
-			++i;
-
-			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
-
-			int extensions_size = tokens[i].size;
-			++i;
-
-			for (int k = 0; k < extensions_size; ++k)
-			{
-				CGLTF_CHECK_KEY(tokens[i]);
-
-				if (cgltf_json_strcmp(tokens+i, json_chunk, "KHR_lights_punctual") == 0)
-				{
-					++i;
-
-					CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
-
-					int data_size = tokens[i].size;
-					++i;
-
-					for (int m = 0; m < data_size; ++m)
-					{
-						CGLTF_CHECK_KEY(tokens[i]);
-
-						if (cgltf_json_strcmp(tokens + i, json_chunk, "lights") == 0)
-						{
-							i = cgltf_parse_json_lights(options, tokens, i + 1, json_chunk, out_data);
-						}
-						else
-						{
-							i = cgltf_skip_json(tokens, i + 1);
-						}
-
-						if (i < 0)
-						{
-							return i;
-						}
-					}
-				}
-				else
-				{
-					i = cgltf_skip_json(tokens, i + 1);
-				}
-
-				if (i < 0)
-				{
-					return i;
-				}
-			}
+			count = &out_info->nodes_count;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extensionsUsed") == 0)
+		else if (cgltf_scan_json_key_is(key, "scenes"))
 		{
-			i = cgltf_parse_json_string_array(options, tokens, i + 1, json_chunk, &out_data->extensions_used, &out_data->extensions_used_count);
+			count = &out_info->scenes_count;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extensionsRequired") == 0)
+		else if (cgltf_scan_json_key_is(key, "animations"))
 		{
-			i = cgltf_parse_json_string_array(options, tokens, i + 1, json_chunk, &out_data->extensions_required, &out_data->extensions_required_count);
+			count = &out_info->animations_count;
 		}
 		else
 		{
-			i = cgltf_skip_json(tokens, i + 1);
+			result = cgltf_scan_json_value(json, size, &i);
 		}
 
-		if (i < 0)
+		if (count)
 		{
-			return i;
+			result = cgltf_scan_json_array(json, size, &i, NULL, count);
+		}
+
+		if (result < 0)
+		{
+			return result;
 		}
 	}
 
-	return i;
+	return result;
 }
 
-cgltf_result cgltf_parse_json(cgltf_options* options, const uint8_t* json_chunk, cgltf_size size, cgltf_data** out_data)
+cgltf_result cgltf_parse_asset_info(const cgltf_options* options, const void* data, cgltf_size size, cgltf_asset_info* out_info)
 {
-	jsmn_parser parser = { 0, 0, 0 };
+	if (size < GlbHeaderSize)
+	{
+		return cgltf_result_data_too_short;
+	}
 
-	if (options->json_token_count == 0)
+	if (options == NULL)
 	{
-		int token_count = jsmn_parse(&parser, (const char*)json_chunk, size, NULL, 0);
+		return cgltf_result_invalid_options;
+	}
+
+	memset(out_info, 0, sizeof(cgltf_asset_info));
+
+	const uint8_t* json_chunk = (const uint8_t*)data;
+	cgltf_size json_size = size;
+	cgltf_file_type type = options->type;
 
-		if (token_count <= 0)
+	uint32_t tmp;
+	// Magic
+	memcpy(&tmp, data, 4);
+	if (tmp != GlbMagic)
+	{
+		if (type == cgltf_file_type_invalid)
 		{
-			return cgltf_result_invalid_json;
+			type = cgltf_file_type_gltf;
+		}
+		else if (type == cgltf_file_type_glb)
+		{
+			return cgltf_result_unknown_format;
 		}
-
-		options->json_token_count = token_count;
 	}
 
-	jsmntok_t* tokens = (jsmntok_t*)options->memory_alloc(options->memory_user_data, sizeof(jsmntok_t) * options->json_token_count);
-
-	if (!tokens)
+	if (type != cgltf_file_type_gltf)
 	{
-		return cgltf_result_out_of_memory;
-	}
+		const void* bin = NULL;
+		cgltf_size bin_size = 0;
 
-	jsmn_init(&parser);
+		cgltf_result glb_result = cgltf_parse_glb_chunks(data, size, &json_chunk, &json_size, &bin, &bin_size);
+		if (glb_result != cgltf_result_success)
+		{
+			return glb_result;
+		}
 
-	int token_count = jsmn_parse(&parser, (const char*)json_chunk, size, tokens, options->json_token_count);
+		type = cgltf_file_type_glb;
+		out_info->bin_size = bin_size;
+	}
 
-	if (token_count <= 0)
+	if (cgltf_scan_json_root((const char*)json_chunk, json_size, out_info) < 0)
 	{
-		options->memory_free(options->memory_user_data, tokens);
 		return cgltf_result_invalid_json;
 	}
 
-	cgltf_data* data = (cgltf_data*)options->memory_alloc(options->memory_user_data, sizeof(cgltf_data));
+	out_info->file_type = type;
 
-	if (!data)
+	return cgltf_result_success;
+}
+
+typedef struct cgltf_fixup_job
+{
+	cgltf_data* data;
+	int sections;
+} cgltf_fixup_job;
+
+static int cgltf_fixup_mesh(void* user, cgltf_size i)
+{
+	cgltf_fixup_job* job = (cgltf_fixup_job*)user;
+	cgltf_data* data = job->data;
+	int sections = job->sections;
+
+	for (cgltf_size j = 0; j < data->meshes[i].primitives_count; ++j)
 	{
-		options->memory_free(options->memory_user_data, tokens);
-		return cgltf_result_out_of_memory;
+		CGLTF_PTRFIXUP(data->meshes[i].primitives[j].indices, data->accessors, data->accessors_count);
+		CGLTF_PTRFIXUP_SECTION(data->meshes[i].primitives[j].material, data->materials, data->materials_count, sections, cgltf_section_materials);
+
+		for (cgltf_size k = 0; k < data->meshes[i].primitives[j].attributes_count; ++k)
+		{
+			CGLTF_PTRFIXUP_REQ(data->meshes[i].primitives[j].attributes[k].data, data->accessors, data->accessors_count);
+		}
+
+		for (cgltf_size k = 0; k < data->meshes[i].primitives[j].targets_count; ++k)
+		{
+			for (cgltf_size m = 0; m < data->meshes[i].primitives[j].targets[k].attributes_count; ++m)
+			{
+				CGLTF_PTRFIXUP_REQ(data->meshes[i].primitives[j].targets[k].attributes[m].data, data->accessors, data->accessors_count);
+			}
+		}
 	}
+	return 0;
+}
 
-	memset(data, 0, sizeof(cgltf_data));
-	data->memory_free = options->memory_free;
-	data->memory_user_data = options->memory_user_data;
+static int cgltf_fixup_accessor(void* user, cgltf_size i)
+{
+	cgltf_fixup_job* job = (cgltf_fixup_job*)user;
+	cgltf_data* data = job->data;
 
-	int i = cgltf_parse_json_root(options, tokens, 0, json_chunk, data);
+	CGLTF_PTRFIXUP(data->accessors[i].buffer_view, data->buffer_views, data->buffer_views_count);
 
-	options->memory_free(options->memory_user_data, tokens);
+	if (data->accessors[i].is_sparse)
+	{
+		CGLTF_PTRFIXUP_REQ(data->accessors[i].sparse.indices_buffer_view, data->buffer_views, data->buffer_views_count);
+		CGLTF_PTRFIXUP_REQ(data->accessors[i].sparse.values_buffer_view, data->buffer_views, data->buffer_views_count);
+	}
 
-	if (i < 0)
+	if (data->accessors[i].buffer_view)
 	{
-		cgltf_free(data);
-		return (i == CGLTF_ERROR_NOMEM) ? cgltf_result_out_of_memory : cgltf_result_invalid_gltf;
+		data->accessors[i].stride = data->accessors[i].buffer_view->stride;
 	}
 
-	if (cgltf_fixup_pointers(data) < 0)
+	if (data->accessors[i].stride == 0)
 	{
-		cgltf_free(data);
-		return cgltf_result_invalid_gltf;
+		data->accessors[i].stride = cgltf_calc_size(data->accessors[i].type, data->accessors[i].component_type);
 	}
+	return 0;
+}
 
-	data->json = (const char*)json_chunk;
-	data->json_size = size;
+static int cgltf_fixup_material(void* user, cgltf_size i)
+{
+	cgltf_fixup_job* job = (cgltf_fixup_job*)user;
+	cgltf_data* data = job->data;
+	int sections = job->sections;
 
-	*out_data = data;
+	CGLTF_PTRFIXUP_SECTION(data->materials[i].normal_texture.texture, data->textures, data->textures_count, sections, cgltf_section_textures);
+	CGLTF_PTRFIXUP_SECTION(data->materials[i].emissive_texture.texture, data->textures, data->textures_count, sections, cgltf_section_textures);
+	CGLTF_PTRFIXUP_SECTION(data->materials[i].occlusion_texture.texture, data->textures, data->textures_count, sections, cgltf_section_textures);
 
-	return cgltf_result_success;
+	CGLTF_PTRFIXUP_SECTION(data->materials[i].pbr_metallic_roughness.base_color_texture.texture, data->textures, data->textures_count, sections, cgltf_section_textures);
+	CGLTF_PTRFIXUP_SECTION(data->materials[i].pbr_metallic_roughness.metallic_roughness_texture.texture, data->textures, data->textures_count, sections, cgltf_section_textures);
+
+	CGLTF_PTRFIXUP_SECTION(data->materials[i].pbr_specular_glossiness.diffuse_texture.texture, data->textures, data->textures_count, sections, cgltf_section_textures);
+	CGLTF_PTRFIXUP_SECTION(data->materials[i].pbr_specular_glossiness.specular_glossiness_texture.texture, data->textures, data->textures_count, sections, cgltf_section_textures);
+	return 0;
 }
 
-static int cgltf_fixup_pointers(cgltf_data* data)
+static int cgltf_fixup_pointers(const cgltf_options* options, cgltf_data* data)
 {
-	for (cgltf_size i = 0; i < data->meshes_count; ++i)
-	{
-		for (cgltf_size j = 0; j < data->meshes[i].primitives_count; ++j)
-		{
-			CGLTF_PTRFIXUP(data->meshes[i].primitives[j].indices, data->accessors, data->accessors_count);
-			CGLTF_PTRFIXUP(data->meshes[i].primitives[j].material, data->materials, data->materials_count);
+	int sections = options->sections;
 
-			for (cgltf_size k = 0; k < data->meshes[i].primitives[j].attributes_count; ++k)
-			{
-				CGLTF_PTRFIXUP_REQ(data->meshes[i].primitives[j].attributes[k].data, data->accessors, data->accessors_count);
-			}
+	// Meshes, accessors and materials only write to themselves, so their pointers can be fixed up concurrently
+	cgltf_fixup_job job;
+	job.data = data;
+	job.sections = sections;
 
-			for (cgltf_size k = 0; k < data->meshes[i].primitives[j].targets_count; ++k)
-			{
-				for (cgltf_size m = 0; m < data->meshes[i].primitives[j].targets[k].attributes_count; ++m)
-				{
-					CGLTF_PTRFIXUP_REQ(data->meshes[i].primitives[j].targets[k].attributes[m].data, data->accessors, data->accessors_count);
-				}
-			}
-		}
+	int result = cgltf_run_elements(options, data->meshes_count, &cgltf_fixup_mesh, &job);
+	if (result < 0)
+	{
+		return result;
 	}
 
-	for (cgltf_size i = 0; i < data->accessors_count; ++i)
+	result = cgltf_run_elements(options, data->accessors_count, &cgltf_fixup_accessor, &job);
+	if (result < 0)
 	{
-		CGLTF_PTRFIXUP(data->accessors[i].buffer_view, data->buffer_views, data->buffer_views_count);
-
-		if (data->accessors[i].is_sparse)
-		{
-			CGLTF_PTRFIXUP_REQ(data->accessors[i].sparse.indices_buffer_view, data->buffer_views, data->buffer_views_count);
-			CGLTF_PTRFIXUP_REQ(data->accessors[i].sparse.values_buffer_view, data->buffer_views, data->buffer_views_count);
-		}
-
-		if (data->accessors[i].buffer_view)
-		{
-			data->accessors[i].stride = data->accessors[i].buffer_view->stride;
-		}
+		return result;
+	}
 
-		if (data->accessors[i].stride == 0)
-		{
-			data->accessors[i].stride = cgltf_calc_size(data->accessors[i].type, data->accessors[i].component_type);
-		}
+	result = cgltf_run_elements(options, data->materials_count, &cgltf_fixup_material, &job);
+	if (result < 0)
+	{
+		return result;
 	}
 
 	for (cgltf_size i = 0; i < data->textures_count; ++i)
 	{
-		CGLTF_PTRFIXUP(data->textures[i].image, data->images, data->images_count);
-		CGLTF_PTRFIXUP(data->textures[i].sampler, data->samplers, data->samplers_count);
+		CGLTF_PTRFIXUP_SECTION(data->textures[i].image, data->images, data->images_count, sections, cgltf_section_images);
+		CGLTF_PTRFIXUP_SECTION(data->textures[i].sampler, data->samplers, data->samplers_count, sections, cgltf_section_samplers);
 	}
 
 	for (cgltf_size i = 0; i < data->images_count; ++i)
@@ -4277,19 +8744,6 @@ static int cgltf_fixup_pointers(cgltf_data* data)
 		CGLTF_PTRFIXUP(data->images[i].buffer_view, data->buffer_views, data->buffer_views_count);
 	}
 
-	for (cgltf_size i = 0; i < data->materials_count; ++i)
-	{
-		CGLTF_PTRFIXUP(data->materials[i].normal_texture.texture, data->textures, data->textures_count);
-		CGLTF_PTRFIXUP(data->materials[i].emissive_texture.texture, data->textures, data->textures_count);
-		CGLTF_PTRFIXUP(data->materials[i].occlusion_texture.texture, data->textures, data->textures_count);
-
-		CGLTF_PTRFIXUP(data->materials[i].pbr_metallic_roughness.base_color_texture.texture, data->textures, data->textures_count);
-		CGLTF_PTRFIXUP(data->materials[i].pbr_metallic_roughness.metallic_roughness_texture.texture, data->textures, data->textures_count);
-
-		CGLTF_PTRFIXUP(data->materials[i].pbr_specular_glossiness.diffuse_texture.texture, data->textures, data->textures_count);
-		CGLTF_PTRFIXUP(data->materials[i].pbr_specular_glossiness.specular_glossiness_texture.texture, data->textures, data->textures_count);
-	}
-
 	for (cgltf_size i = 0; i < data->buffer_views_count; ++i)
 	{
 		CGLTF_PTRFIXUP_REQ(data->buffer_views[i].buffer, data->buffers, data->buffers_count);
@@ -4320,10 +8774,10 @@ static int cgltf_fixup_pointers(cgltf_data* data)
 			data->nodes[i].children[j]->parent = &data->nodes[i];
 		}
 
-		CGLTF_PTRFIXUP(data->nodes[i].mesh, data->meshes, data->meshes_count);
-		CGLTF_PTRFIXUP(data->nodes[i].skin, data->skins, data->skins_count);
-		CGLTF_PTRFIXUP(data->nodes[i].camera, data->cameras, data->cameras_count);
-		CGLTF_PTRFIXUP(data->nodes[i].light, data->lights, data->lights_count);
+		CGLTF_PTRFIXUP_SECTION(data->nodes[i].mesh, data->meshes, data->meshes_count, sections, cgltf_section_meshes);
+		CGLTF_PTRFIXUP_SECTION(data->nodes[i].skin, data->skins, data->skins_count, sections, cgltf_section_skins);
+		CGLTF_PTRFIXUP_SECTION(data->nodes[i].camera, data->cameras, data->cameras_count, sections, cgltf_section_cameras);
+		CGLTF_PTRFIXUP_SECTION(data->nodes[i].light, data->lights, data->lights_count, sections, cgltf_section_lights);
 	}
 
 	for (cgltf_size i = 0; i < data->scenes_count; ++i)
@@ -4339,7 +8793,7 @@ static int cgltf_fixup_pointers(cgltf_data* data)
 		}
 	}
 
-	CGLTF_PTRFIXUP(data->scene, data->scenes, data->scenes_count);
+	CGLTF_PTRFIXUP_SECTION(data->scene, data->scenes, data->scenes_count, sections, cgltf_section_scenes);
 
 	for (cgltf_size i = 0; i < data->animations_count; ++i)
 	{
@@ -17,12 +17,36 @@
  * `cgltf_result cgltf_write_file(const cgltf_options* options, const char*
  * path, const cgltf_data* data)` writes JSON to the given file path. Buffer
  * files and external images are not written out. `data` is not deallocated.
+ * The file is written in a single pass through `cgltf_write_stream()`.
  *
  * `cgltf_size cgltf_write(const cgltf_options* options, char* buffer,
  * cgltf_size size, const cgltf_data* data)` writes JSON into the given memory
  * buffer. Returns the number of bytes written to `buffer`, including a null
  * terminator. If buffer is null, returns the number of bytes that would have
  * been written. `data` is not deallocated.
+ *
+ * `cgltf_result cgltf_write_stream(const cgltf_options* options, cgltf_bool
+ * (*write)(void* user, const char* data, cgltf_size size), void* user, const
+ * cgltf_data* data)` formats JSON into a fixed-size staging buffer and passes
+ * it to `write` whenever it fills up, so that documents of any size are
+ * written in one pass with bounded memory. No null terminator is written.
+ * `write` returns false to report an error, after which it is not called
+ * again and `cgltf_result_io_error` is returned.
+ *
+ * `cgltf_result cgltf_write_glb_file(const cgltf_options* options, const char*
+ * path, const cgltf_data* data)` writes a binary glTF to the given file path.
+ * If the first buffer is loaded, `cgltf_buffer::data` is stored in the BIN
+ * chunk and its uri is left out; other buffers keep their uri and are not
+ * written. The JSON is streamed, so the file must be seekable for the header.
+ *
+ * `cgltf_size cgltf_write_glb(const cgltf_options* options, void* buffer,
+ * cgltf_size size, const cgltf_data* data)` writes a binary glTF into the given
+ * memory buffer, the same way as `cgltf_write_glb_file()`. Returns the size of
+ * the GLB, which is only written if `buffer` is not null and the size is at
+ * most `size`. Returns 0 if the data does not fit into the 4GB limit of GLB.
+ *
+ * When `cgltf_options::compact_json` is set, all of the writers leave out line
+ * breaks and indentation.
  */
 #ifndef CGLTF_WRITE_H_INCLUDED__
 #define CGLTF_WRITE_H_INCLUDED__
@@ -37,6 +61,9 @@ extern "C" {
 
 cgltf_result cgltf_write_file(const cgltf_options* options, const char* path, const cgltf_data* data);
 cgltf_size cgltf_write(const cgltf_options* options, char* buffer, cgltf_size size, const cgltf_data* data);
+cgltf_result cgltf_write_stream(const cgltf_options* options, cgltf_bool (*write)(void* user, const char* data, cgltf_size size), void* user, const cgltf_data* data);
+cgltf_result cgltf_write_glb_file(const cgltf_options* options, const char* path, const cgltf_data* data);
+cgltf_size cgltf_write_glb(const cgltf_options* options, void* buffer, cgltf_size size, const cgltf_data* data);
 
 #ifdef __cplusplus
 }
@@ -73,37 +100,42 @@ typedef struct {
 	size_t buffer_size;
 	size_t remaining;
 	char* cursor;
-	size_t tmp;
 	size_t chars_written;
 	const cgltf_data* data;
 	int depth;
 	const char* indent;
 	int needs_comma;
+	int compact;
+	const cgltf_buffer* bin_buffer;
 	uint32_t extension_flags;
+	cgltf_bool (*write)(void* user, const char* data, cgltf_size size);
+	void* write_user_data;
+	int write_error;
 } cgltf_write_context;
 
-#define CGLTF_SPRINTF(fmt, ...) { \
-		context->tmp = snprintf ( context->cursor, context->remaining, fmt, ## __VA_ARGS__ ); \
-		context->chars_written += context->tmp; \
-		if (context->cursor) { \
-			context->cursor += context->tmp; \
-			context->remaining -= context->tmp; \
-		} }
+/* Size of the buffer that cgltf_write_stream collects output in before passing it on */
+#define CGLTF_WRITE_STAGING_SIZE 16384
+
+#define CGLTF_WRITE_LITERAL(str) cgltf_write_chars(context, str, sizeof(str) - 1)
 
 #define CGLTF_WRITE_IDXPROP(label, val, start) if (val) { \
 		cgltf_write_indent(context); \
-		CGLTF_SPRINTF("\"%s\": %d", label, (int) (val - start)); \
+		cgltf_write_label(context, label); \
+		cgltf_write_int(context, (int) (val - start)); \
 		context->needs_comma = 1; }
 
 #define CGLTF_WRITE_IDXARRPROP(label, dim, vals, start) if (vals) { \
 		cgltf_write_indent(context); \
-		CGLTF_SPRINTF("\"%s\": [", label); \
+		cgltf_write_label(context, label); \
+		CGLTF_WRITE_LITERAL("["); \
 		for (int i = 0; i < dim; ++i) { \
 			int idx = (int) (vals[i] - start); \
-			if (i != 0) CGLTF_SPRINTF(","); \
-			CGLTF_SPRINTF(" %d", idx); \
+			if (i != 0) CGLTF_WRITE_LITERAL(","); \
+			if (!context->compact) CGLTF_WRITE_LITERAL(" "); \
+			cgltf_write_int(context, idx); \
 		} \
-		CGLTF_SPRINTF(" ]"); \
+		if (!context->compact) CGLTF_WRITE_LITERAL(" "); \
+		CGLTF_WRITE_LITERAL("]"); \
 		context->needs_comma = 1; }
 
 #define CGLTF_WRITE_TEXTURE_INFO(label, info) if (info.texture) { \
@@ -117,20 +149,279 @@ typedef struct {
 		} \
 		cgltf_write_line(context, "}"); }
 
+static void cgltf_write_flush(cgltf_write_context* context)
+{
+	size_t size = context->cursor - context->buffer;
+	if (size && !context->write_error && !context->write(context->write_user_data, context->buffer, size))
+	{
+		context->write_error = 1;
+	}
+	context->cursor = context->buffer;
+	context->remaining = context->buffer_size;
+}
+
+static void cgltf_write_chars(cgltf_write_context* context, const char* chars, size_t length)
+{
+	context->chars_written += length;
+
+	if (length >= context->remaining && context->write)
+	{
+		// Pass the staging buffer on; text that does not even fit into the empty staging
+		// buffer, like a long data URI, is passed on directly
+		cgltf_write_flush(context);
+		if (length >= context->remaining)
+		{
+			if (!context->write_error && !context->write(context->write_user_data, chars, length))
+			{
+				context->write_error = 1;
+			}
+			length = 0;
+		}
+	}
+	else if (length >= context->remaining)
+	{
+		// Truncate the output at the end of a buffer that is too small, but keep counting
+		length = context->remaining ? context->remaining - 1 : 0;
+	}
+
+	if (context->cursor && context->remaining)
+	{
+		memcpy(context->cursor, chars, length);
+		context->cursor += length;
+		context->remaining -= length;
+		*context->cursor = 0;
+	}
+}
+
+static size_t cgltf_format_uint(char* out, uint64_t value)
+{
+	char digits[20];
+	size_t length = 0;
+	do
+	{
+		digits[length++] = (char)('0' + value % 10);
+		value /= 10;
+	} while (value);
+
+	for (size_t i = 0; i < length; ++i)
+	{
+		out[i] = digits[length - 1 - i];
+	}
+	return length;
+}
+
+static void cgltf_write_int(cgltf_write_context* context, int value)
+{
+	char text[16];
+	size_t length = 0;
+	if (value < 0)
+	{
+		text[length++] = '-';
+	}
+	length += cgltf_format_uint(text + length, value < 0 ? 0 - (uint64_t)(int64_t)value : (uint64_t)value);
+	cgltf_write_chars(context, text, length);
+}
+
+static const double cgltf_write_powers_of_ten[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/* Writes significant digits with the decimal exponent of the first one, laid out like %g does */
+static size_t cgltf_format_decimal(char* out, const char* digits, int count, int exponent)
+{
+	size_t length = 0;
+
+	if (exponent < -4 || exponent >= (count > 6 ? count : 6))
+	{
+		out[length++] = digits[0];
+		if (count > 1)
+		{
+			out[length++] = '.';
+			memcpy(out + length, digits + 1, count - 1);
+			length += count - 1;
+		}
+		out[length++] = 'e';
+		out[length++] = exponent < 0 ? '-' : '+';
+		int magnitude = exponent < 0 ? -exponent : exponent;
+		if (magnitude < 10)
+		{
+			out[length++] = '0';
+		}
+		length += cgltf_format_uint(out + length, (uint64_t)magnitude);
+	}
+	else if (exponent < 0)
+	{
+		out[length++] = '0';
+		out[length++] = '.';
+		for (int i = -1; i > exponent; --i)
+		{
+			out[length++] = '0';
+		}
+		memcpy(out + length, digits, count);
+		length += count;
+	}
+	else
+	{
+		for (int i = 0; i <= exponent; ++i)
+		{
+			out[length++] = i < count ? digits[i] : '0';
+		}
+		if (count > exponent + 1)
+		{
+			out[length++] = '.';
+			memcpy(out + length, digits + exponent + 1, count - exponent - 1);
+			length += count - exponent - 1;
+		}
+	}
+
+	return length;
+}
+
+/* Formats the shortest decimal that reads back as the same float, both with strtof and with strtod followed by a
+ * conversion to float. A candidate with n digits, m / 10^k, is exact in double as long as k stays within the powers
+ * of ten that double represents exactly, so its correctly rounded value is known; it is accepted if that value lies
+ * strictly between the midpoints to the neighbouring floats. Other values fall back to snprintf. */
+static size_t cgltf_format_float(char* out, float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	size_t length = 0;
+	int binary_exponent = (int)((bits >> 23) & 0xff) - 127;
+
+	if (binary_exponent == 128)
+	{
+		return (size_t)snprintf(out, 32, "%g", value);
+	}
+
+	if (bits >> 31)
+	{
+		out[length++] = '-';
+	}
+
+	if ((bits & 0x7fffffff) == 0)
+	{
+		out[length++] = '0';
+		return length;
+	}
+
+	float magnitude_float = value < 0 ? -value : value;
+	double magnitude = magnitude_float;
+	uint32_t magnitude_bits = bits & 0x7fffffff;
+	float below, above;
+	uint32_t below_bits = magnitude_bits - 1;
+	uint32_t above_bits = magnitude_bits + 1;
+	memcpy(&below, &below_bits, sizeof(below));
+	memcpy(&above, &above_bits, sizeof(above));
+	double lower = (magnitude + below) / 2;
+	double upper = (magnitude + above) / 2;
+
+	/* floor(binary_exponent * log10(2)), which is the decimal exponent of the first digit or one less */
+	int exponent = (binary_exponent * 78913) >> 18;
+	if (exponent + 1 >= 0 && exponent + 1 <= 22 && magnitude >= cgltf_write_powers_of_ten[exponent + 1])
+	{
+		++exponent;
+	}
+
+	for (int count = 1; count <= 9; ++count)
+	{
+		int k = count - 1 - exponent;
+		if (k > 22 || k < -22)
+		{
+			break;
+		}
+
+		double scaled = k >= 0 ? magnitude * cgltf_write_powers_of_ten[k] : magnitude / cgltf_write_powers_of_ten[-k];
+		uint64_t mantissa = (uint64_t)(scaled + 0.5);
+		double candidate = k >= 0 ? (double)mantissa / cgltf_write_powers_of_ten[k] : (double)mantissa * cgltf_write_powers_of_ten[-k];
+
+		int inside = candidate > lower && candidate < upper;
+
+		/* Integers below 2^53 are exact, so one that is exactly halfway reads back as the float with the even mantissa */
+		if (!inside && k <= 0 && candidate < 9007199254740992.0 && (magnitude_bits & 1) == 0)
+		{
+			inside = candidate == lower || candidate == upper;
+		}
+
+		if (mantissa != 0 && inside)
+		{
+			char digits[20];
+			int digit_count = (int)cgltf_format_uint(digits, mantissa);
+			int first_exponent = digit_count - 1 - k;
+			while (digit_count > 1 && digits[digit_count - 1] == '0')
+			{
+				--digit_count;
+			}
+			return length + cgltf_format_decimal(out + length, digits, digit_count, first_exponent);
+		}
+	}
+
+	/* Very small and very large values are rare enough to search for the shortest digits with snprintf */
+	for (int precision = 1; precision <= 9; ++precision)
+	{
+		length = (size_t)snprintf(out, 32, "%.*g", precision, value);
+		if (strtof(out, NULL) == value && (float)strtod(out, NULL) == value)
+		{
+			break;
+		}
+	}
+
+	/* Undo the decimal comma of locales that use one */
+	char* decimal_comma = strchr(out, ',');
+	if (decimal_comma)
+	{
+		*decimal_comma = '.';
+	}
+
+	return length;
+}
+
+static void cgltf_write_float(cgltf_write_context* context, float value)
+{
+	char text[32];
+	cgltf_write_chars(context, text, cgltf_format_float(text, value));
+}
+
+/* Writes "label": */
+static void cgltf_write_label(cgltf_write_context* context, const char* label)
+{
+	CGLTF_WRITE_LITERAL("\"");
+	cgltf_write_chars(context, label, strlen(label));
+	if (context->compact)
+	{
+		CGLTF_WRITE_LITERAL("\":");
+	}
+	else
+	{
+		CGLTF_WRITE_LITERAL("\": ");
+	}
+}
+
 static void cgltf_write_indent(cgltf_write_context* context)
 {
+	if (context->compact)
+	{
+		if (context->needs_comma)
+		{
+			CGLTF_WRITE_LITERAL(",");
+			context->needs_comma = 0;
+		}
+		return;
+	}
 	if (context->needs_comma)
 	{
-		CGLTF_SPRINTF(",\n");
+		CGLTF_WRITE_LITERAL(",\n");
 		context->needs_comma = 0;
 	}
 	else
 	{
-		CGLTF_SPRINTF("\n");
+		CGLTF_WRITE_LITERAL("\n");
 	}
+	size_t indent_length = strlen(context->indent);
 	for (int i = 0; i < context->depth; ++i)
 	{
-		CGLTF_SPRINTF("%s", context->indent);
+		cgltf_write_chars(context, context->indent, indent_length);
 	}
 }
 
@@ -142,8 +433,18 @@ static void cgltf_write_line(cgltf_write_context* context, const char* line)
 		context->needs_comma = 0;
 	}
 	cgltf_write_indent(context);
-	CGLTF_SPRINTF("%s", line);
 	int last = strlen(line) - 1;
+	const char* separator = context->compact ? strstr(line, "\": ") : NULL;
+	if (separator)
+	{
+		/* Lines are a label followed by a bracket, so dropping the space is all that compact output needs */
+		cgltf_write_chars(context, line, separator + 2 - line);
+		cgltf_write_chars(context, separator + 3, line + last + 1 - (separator + 3));
+	}
+	else
+	{
+		cgltf_write_chars(context, line, last + 1);
+	}
 	if (line[0] == ']' || line[0] == '}')
 	{
 		context->needs_comma = 1;
@@ -160,7 +461,10 @@ static void cgltf_write_strprop(cgltf_write_context* context, const char* label,
 	if (val)
 	{
 		cgltf_write_indent(context);
-		CGLTF_SPRINTF("\"%s\": \"%s\"", label, val);
+		cgltf_write_label(context, label);
+		CGLTF_WRITE_LITERAL("\"");
+		cgltf_write_chars(context, val, strlen(val));
+		CGLTF_WRITE_LITERAL("\"");
 		context->needs_comma = 1;
 	}
 }
@@ -168,7 +472,9 @@ static void cgltf_write_strprop(cgltf_write_context* context, const char* label,
 static void cgltf_write_stritem(cgltf_write_context* context, const char* item)
 {
 	cgltf_write_indent(context);
-	CGLTF_SPRINTF("\"%s\"", item);
+	CGLTF_WRITE_LITERAL("\"");
+	cgltf_write_chars(context, item, strlen(item));
+	CGLTF_WRITE_LITERAL("\"");
 	context->needs_comma = 1;
 }
 
@@ -177,7 +483,8 @@ static void cgltf_write_intprop(cgltf_write_context* context, const char* label,
 	if (val != def)
 	{
 		cgltf_write_indent(context);
-		CGLTF_SPRINTF("\"%s\": %d", label, val);
+		cgltf_write_label(context, label);
+		cgltf_write_int(context, val);
 		context->needs_comma = 1;
 	}
 }
@@ -187,18 +494,9 @@ static void cgltf_write_floatprop(cgltf_write_context* context, const char* labe
 	if (val != def)
 	{
 		cgltf_write_indent(context);
-		CGLTF_SPRINTF("\"%s\": ", label);
-		CGLTF_SPRINTF("%g", val);
+		cgltf_write_label(context, label);
+		cgltf_write_float(context, val);
 		context->needs_comma = 1;
-
-		if (context->cursor)
-		{
-			char *decimal_comma = strchr(context->cursor - context->tmp, ',');
-			if (decimal_comma)
-			{
-				*decimal_comma = '.';
-			}
-		}
 	}
 }
 
@@ -207,7 +505,15 @@ static void cgltf_write_boolprop_optional(cgltf_write_context* context, const ch
 	if (val != def)
 	{
 		cgltf_write_indent(context);
-		CGLTF_SPRINTF("\"%s\": %s", label, val ? "true" : "false");
+		cgltf_write_label(context, label);
+		if (val)
+		{
+			CGLTF_WRITE_LITERAL("true");
+		}
+		else
+		{
+			CGLTF_WRITE_LITERAL("false");
+		}
 		context->needs_comma = 1;
 	}
 }
@@ -215,19 +521,17 @@ static void cgltf_write_boolprop_optional(cgltf_write_context* context, const ch
 static void cgltf_write_floatarrayprop(cgltf_write_context* context, const char* label, const cgltf_float* vals, int dim)
 {
 	cgltf_write_indent(context);
-	CGLTF_SPRINTF("\"%s\": [", label);
+	cgltf_write_label(context, label);
+	CGLTF_WRITE_LITERAL("[");
 	for (int i = 0; i < dim; ++i)
 	{
 		if (i != 0)
 		{
-			CGLTF_SPRINTF(", %g", vals[i]);
-		}
-		else
-		{
-			CGLTF_SPRINTF("%g", vals[i]);
+			cgltf_write_chars(context, ", ", context->compact ? 1 : 2);
 		}
+		cgltf_write_float(context, vals[i]);
 	}
-	CGLTF_SPRINTF("]");
+	CGLTF_WRITE_LITERAL("]");
 	context->needs_comma = 1;
 }
 
@@ -412,7 +716,11 @@ static void cgltf_write_buffer_view(cgltf_write_context* context, const cgltf_bu
 static void cgltf_write_buffer(cgltf_write_context* context, const cgltf_buffer* buffer)
 {
 	cgltf_write_line(context, "{");
-	cgltf_write_strprop(context, "uri", buffer->uri);
+	if (buffer != context->bin_buffer)
+	{
+		/* The buffer that is stored in the GLB's BIN chunk must not have a uri */
+		cgltf_write_strprop(context, "uri", buffer->uri);
+	}
 	cgltf_write_intprop(context, "byteLength", buffer->size, -1);
 	cgltf_write_line(context, "}");
 }
@@ -764,43 +1072,11 @@ static void cgltf_write_light(cgltf_write_context* context, const cgltf_light* l
 	cgltf_write_line(context, "}");
 }
 
-cgltf_result cgltf_write_file(const cgltf_options* options, const char* path, const cgltf_data* data)
-{
-	size_t expected = cgltf_write(options, NULL, 0, data);
-	char* buffer = (char*) malloc(expected);
-	size_t actual = cgltf_write(options, buffer, expected, data);
-	if (expected != actual) {
-		fprintf(stderr, "Error: expected %zu bytes but wrote %zu bytes.\n", expected, actual);
-	}
-	FILE* file = fopen(path, "wt");
-	if (!file)
-	{
-		return cgltf_result_file_not_found;
-	}
-	// Note that cgltf_write() includes a null terminator, which we omit from the file content.
-	fwrite(buffer, actual - 1, 1, file);
-	fclose(file);
-	free(buffer);
-	return cgltf_result_success;
-}
-
-cgltf_size cgltf_write(const cgltf_options* options, char* buffer, cgltf_size size, const cgltf_data* data)
+static void cgltf_write_json(cgltf_write_context* context)
 {
-	cgltf_write_context ctx;
-	ctx.buffer = buffer;
-	ctx.buffer_size = size;
-	ctx.remaining = size;
-	ctx.cursor = buffer;
-	ctx.chars_written = 0;
-	ctx.data = data;
-	ctx.depth = 1;
-	ctx.indent = "  ";
-	ctx.needs_comma = 0;
-	ctx.extension_flags = 0;
-
-	cgltf_write_context* context = &ctx;
+	const cgltf_data* data = context->data;
 
-	CGLTF_SPRINTF("{");
+	CGLTF_WRITE_LITERAL("{");
 
 	if (data->accessors_count > 0)
 	{
@@ -972,13 +1248,257 @@ cgltf_size cgltf_write(const cgltf_options* options, char* buffer, cgltf_size si
 		cgltf_write_line(context, "]");
 	}
 
-	CGLTF_SPRINTF("\n}\n");
+	if (context->compact)
+	{
+		CGLTF_WRITE_LITERAL("}");
+	}
+	else
+	{
+		CGLTF_WRITE_LITERAL("\n}\n");
+	}
+}
+
+static void cgltf_write_init(cgltf_write_context* context, const cgltf_options* options, char* buffer, cgltf_size size, const cgltf_data* data)
+{
+	context->buffer = buffer;
+	context->buffer_size = size;
+	context->remaining = size;
+	context->cursor = buffer;
+	context->chars_written = 0;
+	context->data = data;
+	context->depth = 1;
+	context->indent = "  ";
+	context->needs_comma = 0;
+	context->compact = options && options->compact_json;
+	context->bin_buffer = NULL;
+	context->extension_flags = 0;
+	context->write = NULL;
+	context->write_user_data = NULL;
+	context->write_error = 0;
+}
+
+static cgltf_bool cgltf_write_to_file(void* user, const char* data, cgltf_size size)
+{
+	return fwrite(data, 1, size, (FILE*)user) == size;
+}
+
+cgltf_result cgltf_write_file(const cgltf_options* options, const char* path, const cgltf_data* data)
+{
+	FILE* file = fopen(path, "wt");
+	if (!file)
+	{
+		return cgltf_result_file_not_found;
+	}
+	cgltf_result result = cgltf_write_stream(options, &cgltf_write_to_file, file, data);
+	if (fclose(file) != 0 && result == cgltf_result_success)
+	{
+		result = cgltf_result_io_error;
+	}
+	return result;
+}
+
+static cgltf_result cgltf_write_json_stream(const cgltf_options* options, cgltf_bool (*write)(void* user, const char* data, cgltf_size size), void* user, const cgltf_data* data, const cgltf_buffer* bin_buffer, cgltf_size* out_size)
+{
+	char staging[CGLTF_WRITE_STAGING_SIZE];
+	cgltf_write_context ctx;
+	cgltf_write_init(&ctx, options, staging, sizeof(staging), data);
+	ctx.write = write;
+	ctx.write_user_data = user;
+	ctx.bin_buffer = bin_buffer;
+
+	cgltf_write_json(&ctx);
+	cgltf_write_flush(&ctx);
+
+	if (out_size)
+	{
+		*out_size = ctx.chars_written;
+	}
+	return ctx.write_error ? cgltf_result_io_error : cgltf_result_success;
+}
+
+cgltf_result cgltf_write_stream(const cgltf_options* options, cgltf_bool (*write)(void* user, const char* data, cgltf_size size), void* user, const cgltf_data* data)
+{
+	return cgltf_write_json_stream(options, write, user, data, NULL, NULL);
+}
+
+cgltf_size cgltf_write(const cgltf_options* options, char* buffer, cgltf_size size, const cgltf_data* data)
+{
+	cgltf_write_context ctx;
+	cgltf_write_init(&ctx, options, buffer, size, data);
+
+	cgltf_write_json(&ctx);
 
 	// snprintf does not include the null terminator in its return value, so be sure to include it
 	// in the returned byte count.
 	return 1 + ctx.chars_written;
 }
 
+#define CGLTF_GLB_MAGIC 0x46546C67
+#define CGLTF_GLB_VERSION 2
+#define CGLTF_GLB_CHUNK_JSON 0x4E4F534A
+#define CGLTF_GLB_CHUNK_BIN 0x004E4942
+/* The 12-byte file header followed by the header of the JSON chunk */
+#define CGLTF_GLB_PREFIX_SIZE 20
+#define CGLTF_GLB_CHUNK_HEADER_SIZE 8
+
+/* The first buffer is stored in the BIN chunk when its contents are loaded */
+static const cgltf_buffer* cgltf_write_glb_bin_buffer(const cgltf_data* data)
+{
+	return data->buffers_count > 0 && data->buffers[0].data ? data->buffers : NULL;
+}
+
+static cgltf_size cgltf_write_glb_padded(cgltf_size size)
+{
+	return (size + 3) & ~(cgltf_size)3;
+}
+
+static void cgltf_write_u32(uint8_t* out, uint32_t value)
+{
+	out[0] = (uint8_t)value;
+	out[1] = (uint8_t)(value >> 8);
+	out[2] = (uint8_t)(value >> 16);
+	out[3] = (uint8_t)(value >> 24);
+}
+
+static void cgltf_write_glb_prefix(uint8_t* out, cgltf_size total_size, cgltf_size json_size)
+{
+	cgltf_write_u32(out, CGLTF_GLB_MAGIC);
+	cgltf_write_u32(out + 4, CGLTF_GLB_VERSION);
+	cgltf_write_u32(out + 8, (uint32_t)total_size);
+	cgltf_write_u32(out + 12, (uint32_t)json_size);
+	cgltf_write_u32(out + 16, CGLTF_GLB_CHUNK_JSON);
+}
+
+static cgltf_size cgltf_write_glb_size(cgltf_size json_size, const cgltf_buffer* bin_buffer)
+{
+	cgltf_size size = CGLTF_GLB_PREFIX_SIZE + cgltf_write_glb_padded(json_size);
+	if (bin_buffer)
+	{
+		size += CGLTF_GLB_CHUNK_HEADER_SIZE + cgltf_write_glb_padded(bin_buffer->size);
+	}
+	return size;
+}
+
+typedef struct {
+	char* data;
+	cgltf_size capacity;
+	cgltf_size size;
+} cgltf_write_memory;
+
+static cgltf_bool cgltf_write_to_memory(void* user, const char* data, cgltf_size size)
+{
+	cgltf_write_memory* memory = (cgltf_write_memory*)user;
+	if (memory->size < memory->capacity)
+	{
+		cgltf_size available = memory->capacity - memory->size;
+		memcpy(memory->data + memory->size, data, size < available ? size : available);
+	}
+	memory->size += size;
+	return 1;
+}
+
+cgltf_size cgltf_write_glb(const cgltf_options* options, void* buffer, cgltf_size size, const cgltf_data* data)
+{
+	const cgltf_buffer* bin_buffer = cgltf_write_glb_bin_buffer(data);
+	uint8_t* out = (uint8_t*)buffer;
+
+	// The JSON goes straight to its place after the header, which is filled in once its length is known
+	cgltf_write_memory json;
+	json.data = out && size > CGLTF_GLB_PREFIX_SIZE ? (char*)out + CGLTF_GLB_PREFIX_SIZE : NULL;
+	json.capacity = json.data ? size - CGLTF_GLB_PREFIX_SIZE : 0;
+	json.size = 0;
+	cgltf_write_json_stream(options, &cgltf_write_to_memory, &json, data, bin_buffer, NULL);
+
+	cgltf_size json_padded = cgltf_write_glb_padded(json.size);
+	cgltf_size total_size = cgltf_write_glb_size(json.size, bin_buffer);
+	if (total_size > 0xffffffffu)
+	{
+		return 0;
+	}
+	if (!out || total_size > size)
+	{
+		return total_size;
+	}
+
+	memset(out + CGLTF_GLB_PREFIX_SIZE + json.size, ' ', json_padded - json.size);
+	cgltf_write_glb_prefix(out, total_size, json_padded);
+
+	if (bin_buffer)
+	{
+		uint8_t* chunk = out + CGLTF_GLB_PREFIX_SIZE + json_padded;
+		cgltf_size bin_padded = cgltf_write_glb_padded(bin_buffer->size);
+		cgltf_write_u32(chunk, (uint32_t)bin_padded);
+		cgltf_write_u32(chunk + 4, CGLTF_GLB_CHUNK_BIN);
+		memcpy(chunk + CGLTF_GLB_CHUNK_HEADER_SIZE, bin_buffer->data, bin_buffer->size);
+		memset(chunk + CGLTF_GLB_CHUNK_HEADER_SIZE + bin_buffer->size, 0, bin_padded - bin_buffer->size);
+	}
+
+	return total_size;
+}
+
+cgltf_result cgltf_write_glb_file(const cgltf_options* options, const char* path, const cgltf_data* data)
+{
+	FILE* file = fopen(path, "wb");
+	if (!file)
+	{
+		return cgltf_result_file_not_found;
+	}
+
+	const cgltf_buffer* bin_buffer = cgltf_write_glb_bin_buffer(data);
+	uint8_t prefix[CGLTF_GLB_PREFIX_SIZE] = {0};
+	static const char json_padding[3] = {' ', ' ', ' '};
+	static const char bin_padding[3] = {0, 0, 0};
+
+	// The JSON is streamed behind a placeholder header, which is rewritten once its length is known
+	cgltf_size json_size = 0;
+	cgltf_result result = fwrite(prefix, 1, sizeof(prefix), file) == sizeof(prefix) ? cgltf_result_success : cgltf_result_io_error;
+	if (result == cgltf_result_success)
+	{
+		result = cgltf_write_json_stream(options, &cgltf_write_to_file, file, data, bin_buffer, &json_size);
+	}
+
+	cgltf_size json_padded = cgltf_write_glb_padded(json_size);
+	cgltf_size total_size = cgltf_write_glb_size(json_size, bin_buffer);
+	if (result == cgltf_result_success && total_size > 0xffffffffu)
+	{
+		result = cgltf_result_invalid_options;
+	}
+
+	if (result == cgltf_result_success && fwrite(json_padding, 1, json_padded - json_size, file) != json_padded - json_size)
+	{
+		result = cgltf_result_io_error;
+	}
+
+	if (result == cgltf_result_success && bin_buffer)
+	{
+		uint8_t chunk[CGLTF_GLB_CHUNK_HEADER_SIZE];
+		cgltf_size bin_padded = cgltf_write_glb_padded(bin_buffer->size);
+		cgltf_write_u32(chunk, (uint32_t)bin_padded);
+		cgltf_write_u32(chunk + 4, CGLTF_GLB_CHUNK_BIN);
+		if (fwrite(chunk, 1, sizeof(chunk), file) != sizeof(chunk) ||
+			fwrite(bin_buffer->data, 1, bin_buffer->size, file) != bin_buffer->size ||
+			fwrite(bin_padding, 1, bin_padded - bin_buffer->size, file) != bin_padded - bin_buffer->size)
+		{
+			result = cgltf_result_io_error;
+		}
+	}
+
+	if (result == cgltf_result_success)
+	{
+		cgltf_write_glb_prefix(prefix, total_size, json_padded);
+		if (fseek(file, 0, SEEK_SET) != 0 || fwrite(prefix, 1, sizeof(prefix), file) != sizeof(prefix))
+		{
+			result = cgltf_result_io_error;
+		}
+	}
+
+	if (fclose(file) != 0 && result == cgltf_result_success)
+	{
+		result = cgltf_result_io_error;
+	}
+	return result;
+}
+
 #endif /* #ifdef CGLTF_WRITE_IMPLEMENTATION */
 
 /* cgltf is distributed under MIT license:
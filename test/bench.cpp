@@ -0,0 +1,287 @@
+// Measures the main cgltf stages on a set of models:
+//   cgltf_bench [-n iterations] model.gltf model.glb ...
+// For every stage, the best time over all iterations is reported along with the
+// throughput and the allocations that one run of the stage makes.
+
+#define CGLTF_IMPLEMENTATION
+#define CGLTF_WRITE_IMPLEMENTATION
+#include "../cgltf_write.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+struct AllocStats
+{
+	cgltf_size count;
+	cgltf_size bytes;
+};
+
+static void* counting_alloc(void* user, cgltf_size size)
+{
+	AllocStats* stats = static_cast<AllocStats*>(user);
+	stats->count++;
+	stats->bytes += size;
+	return malloc(size);
+}
+
+static void counting_free(void*, void* ptr)
+{
+	free(ptr);
+}
+
+struct StageResult
+{
+	double seconds;
+	cgltf_size bytes;
+	cgltf_size elements;
+	AllocStats allocs;
+};
+
+static const char* stage_names[] = {"parse", "load_buffers", "validate", "unpack_floats", "read_float", "transform_world", "write"};
+static const int stage_count = sizeof(stage_names) / sizeof(stage_names[0]);
+
+// Runs setup untimed, then run timed, then teardown untimed, and keeps the fastest run.
+static bool measure(int iterations, AllocStats* allocs, const std::function<bool()>& setup, const std::function<bool(StageResult&)>& run, const std::function<void()>& teardown, StageResult& result)
+{
+	result.seconds = -1;
+	for (int i = 0; i < iterations; ++i)
+	{
+		if (!setup())
+		{
+			return false;
+		}
+		StageResult current = {};
+		*allocs = AllocStats();
+		auto start = std::chrono::steady_clock::now();
+		bool ok = run(current);
+		auto end = std::chrono::steady_clock::now();
+		current.allocs = *allocs;
+		teardown();
+		if (!ok)
+		{
+			return false;
+		}
+		current.seconds = std::chrono::duration<double>(end - start).count();
+		if (result.seconds < 0 || current.seconds < result.seconds)
+		{
+			result = current;
+		}
+	}
+	return true;
+}
+
+static bool read_file(const char* path, std::vector<char>& contents)
+{
+	FILE* file = fopen(path, "rb");
+	if (!file)
+	{
+		return false;
+	}
+	fseek(file, 0, SEEK_END);
+	long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	contents.resize(size > 0 ? size : 0);
+	bool ok = size >= 0 && fread(contents.data(), 1, contents.size(), file) == contents.size();
+	fclose(file);
+	return ok;
+}
+
+static bool bench_file(const char* path, int iterations, StageResult* results)
+{
+	std::vector<char> contents;
+	if (!read_file(path, contents))
+	{
+		printf("%s: unable to read\n", path);
+		return false;
+	}
+
+	AllocStats allocs = {};
+	cgltf_options options = {};
+	options.memory_alloc = counting_alloc;
+	options.memory_free = counting_free;
+	options.memory_user_data = &allocs;
+
+	cgltf_data* data = NULL;
+	auto no_setup = [] { return true; };
+	auto free_data = [&] { cgltf_free(data); data = NULL; };
+	auto parse = [&] { return cgltf_parse(&options, contents.data(), contents.size(), &data) == cgltf_result_success; };
+	auto no_teardown = [] {};
+
+	cgltf_size objects = 0;
+	if (!measure(iterations, &allocs, no_setup, [&](StageResult& r) {
+			bool ok = parse();
+			r.bytes = contents.size();
+			if (ok)
+			{
+				objects = data->meshes_count + data->materials_count + data->accessors_count + data->buffer_views_count +
+					data->buffers_count + data->images_count + data->textures_count + data->samplers_count + data->skins_count +
+					data->cameras_count + data->lights_count + data->nodes_count + data->scenes_count + data->animations_count;
+			}
+			r.elements = objects;
+			return ok;
+		}, free_data, results[0]))
+	{
+		printf("%s: unable to parse\n", path);
+		return false;
+	}
+
+	if (!measure(iterations, &allocs, parse, [&](StageResult& r) {
+			bool ok = cgltf_load_buffers(&options, data, path) == cgltf_result_success;
+			for (cgltf_size i = 0; i < data->buffers_count; ++i)
+			{
+				r.bytes += data->buffers[i].size;
+			}
+			r.elements = data->buffers_count;
+			return ok;
+		}, free_data, results[1]))
+	{
+		printf("%s: unable to load buffers\n", path);
+		return false;
+	}
+
+	// The remaining stages share one document with loaded buffers
+	parse();
+	cgltf_load_buffers(&options, data, path);
+
+	cgltf_size accessor_bytes = 0;
+	cgltf_size accessor_elements = 0;
+	cgltf_size float_count = 0;
+	for (cgltf_size i = 0; i < data->accessors_count; ++i)
+	{
+		const cgltf_accessor* accessor = &data->accessors[i];
+		accessor_bytes += accessor->count * cgltf_calc_size(accessor->type, accessor->component_type);
+		accessor_elements += accessor->count;
+		float_count = std::max(float_count, cgltf_accessor_unpack_floats(accessor, NULL, 0));
+	}
+	std::vector<cgltf_float> floats(float_count);
+
+	bool ok = measure(iterations, &allocs, no_setup, [&](StageResult& r) {
+			r.bytes = accessor_bytes;
+			r.elements = data->accessors_count + data->meshes_count;
+			return cgltf_validate(data) == cgltf_result_success;
+		}, no_teardown, results[2]);
+
+	ok = ok && measure(iterations, &allocs, no_setup, [&](StageResult& r) {
+			for (cgltf_size i = 0; i < data->accessors_count; ++i)
+			{
+				const cgltf_accessor* accessor = &data->accessors[i];
+				cgltf_size count = cgltf_accessor_unpack_floats(accessor, NULL, 0);
+				if (cgltf_accessor_unpack_floats(accessor, floats.data(), count) != count)
+				{
+					return false;
+				}
+			}
+			r.bytes = accessor_bytes;
+			r.elements = accessor_elements;
+			return true;
+		}, no_teardown, results[3]);
+
+	ok = ok && measure(iterations, &allocs, no_setup, [&](StageResult& r) {
+			cgltf_float element[16];
+			for (cgltf_size i = 0; i < data->accessors_count; ++i)
+			{
+				const cgltf_accessor* accessor = &data->accessors[i];
+				for (cgltf_size j = 0; j < accessor->count; ++j)
+				{
+					if (!cgltf_accessor_read_float(accessor, j, element, 16))
+					{
+						return false;
+					}
+				}
+			}
+			r.bytes = accessor_bytes;
+			r.elements = accessor_elements;
+			return true;
+		}, no_teardown, results[4]);
+
+	ok = ok && measure(iterations, &allocs, no_setup, [&](StageResult& r) {
+			cgltf_float matrix[16];
+			for (cgltf_size i = 0; i < data->nodes_count; ++i)
+			{
+				cgltf_node_transform_world(&data->nodes[i], matrix);
+			}
+			r.bytes = data->nodes_count * sizeof(matrix);
+			r.elements = data->nodes_count;
+			return true;
+		}, no_teardown, results[5]);
+
+	std::vector<char> json;
+	ok = ok && measure(iterations, &allocs, no_setup, [&](StageResult& r) {
+			cgltf_size size = cgltf_write(&options, NULL, 0, data);
+			json.resize(size);
+			r.bytes = cgltf_write(&options, json.data(), json.size(), data);
+			r.elements = objects;
+			return r.bytes == size;
+		}, no_teardown, results[6]);
+
+	cgltf_free(data);
+
+	if (!ok)
+	{
+		printf("%s: a stage failed\n", path);
+	}
+	return ok;
+}
+
+static void print_results(const char* title, const StageResult* results)
+{
+	printf("%s\n", title);
+	printf("  %-16s %10s %10s %12s %10s %12s\n", "stage", "ms", "MB/s", "Melements/s", "allocs", "alloc bytes");
+	for (int stage = 0; stage < stage_count; ++stage)
+	{
+		const StageResult& r = results[stage];
+		double seconds = std::max(r.seconds, 1e-9);
+		printf("  %-16s %10.3f %10.1f %12.2f %10zu %12zu\n", stage_names[stage], r.seconds * 1e3,
+			r.bytes / seconds / 1e6, r.elements / seconds / 1e6, (size_t)r.allocs.count, (size_t)r.allocs.bytes);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int iterations = 10;
+	int first = 1;
+	if (argc > 2 && strcmp(argv[1], "-n") == 0)
+	{
+		iterations = std::max(1, atoi(argv[2]));
+		first = 3;
+	}
+
+	if (first >= argc)
+	{
+		printf("usage: %s [-n iterations] model.gltf model.glb ...\n", argv[0]);
+		return -1;
+	}
+
+	StageResult totals[stage_count] = {};
+	int failures = 0;
+
+	for (int i = first; i < argc; ++i)
+	{
+		StageResult results[stage_count] = {};
+		if (!bench_file(argv[i], iterations, results))
+		{
+			failures++;
+			continue;
+		}
+		print_results(argv[i], results);
+		for (int stage = 0; stage < stage_count; ++stage)
+		{
+			totals[stage].seconds += results[stage].seconds;
+			totals[stage].bytes += results[stage].bytes;
+			totals[stage].elements += results[stage].elements;
+			totals[stage].allocs.count += results[stage].allocs.count;
+			totals[stage].allocs.bytes += results[stage].allocs.bytes;
+		}
+	}
+
+	if (argc - first - failures > 1)
+	{
+		print_results("total", totals);
+	}
+
+	return failures;
+}
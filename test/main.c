@@ -4,6 +4,101 @@
 #include "../cgltf.h"
 
 #include <stdio.h>
+#include <stdlib.h>
+
+/* A chain of nodes deeper than any call stack, where the deep branch is never the last child */
+static int test_deep_hierarchy(void)
+{
+	const int depth = 200000;
+	char* json = (char*)malloc((size_t)depth * 64 + 64);
+	size_t length = (size_t)sprintf(json, "{\"asset\":{\"version\":\"2.0\"},\"nodes\":[");
+	for (int k = 0; k < depth - 1; ++k)
+		length += (size_t)sprintf(json + length, "{\"translation\":[0,0,1],\"children\":[%d,%d]},{},", 2 * k + 2, 2 * k + 1);
+	length += (size_t)sprintf(json + length, "{\"translation\":[0,0,1]}]}");
+
+	cgltf_options options = {0};
+	cgltf_data* data = NULL;
+	cgltf_result result = cgltf_parse(&options, json, length, &data);
+	free(json);
+	if (result != cgltf_result_success)
+		return -1;
+
+	cgltf_float* matrices = (cgltf_float*)malloc(data->nodes_count * 16 * sizeof(cgltf_float));
+	cgltf_scene_compute_world_transforms(data, NULL, matrices);
+
+	int failures = 0;
+	for (cgltf_size i = 0; i < data->nodes_count; ++i)
+	{
+		const cgltf_float* m = matrices + 16 * i;
+		if (m[14] != (cgltf_float)(i / 2 + 1) || m[3] != 0 || m[7] != 0 || m[11] != 0 || m[15] != 1)
+			failures++;
+	}
+
+	free(matrices);
+	cgltf_free(data);
+	return failures ? -1 : 0;
+}
+
+static void encode_base64(const unsigned char* data, size_t size, char* out, int padding)
+{
+	static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	size_t length = 0;
+	for (size_t i = 0; i < size; i += 3)
+	{
+		unsigned int bits = (unsigned int)data[i] << 16;
+		if (i + 1 < size)
+			bits |= (unsigned int)data[i + 1] << 8;
+		if (i + 2 < size)
+			bits |= data[i + 2];
+		out[length++] = alphabet[(bits >> 18) & 63];
+		out[length++] = alphabet[(bits >> 12) & 63];
+		if (i + 1 < size || padding)
+			out[length++] = i + 1 < size ? alphabet[(bits >> 6) & 63] : '=';
+		if (i + 2 < size || padding)
+			out[length++] = i + 2 < size ? alphabet[bits & 63] : '=';
+	}
+	out[length] = 0;
+}
+
+/* Lengths that end both inside and after the vectorized blocks, with and without padding, and with bad characters */
+static int test_base64(void)
+{
+	cgltf_options options = {0};
+	unsigned char data[68];
+	char text[96];
+
+	for (size_t i = 0; i < sizeof(data); ++i)
+		data[i] = (unsigned char)(i * 37 + 251);
+
+	for (size_t size = 0; size < sizeof(data); ++size)
+	{
+		for (int padding = 0; padding < 2; ++padding)
+		{
+			void* decoded = NULL;
+			encode_base64(data, size, text, padding);
+			if (cgltf_load_buffer_base64(&options, size, text, &decoded) != cgltf_result_success || memcmp(decoded, data, size) != 0)
+				return -1;
+			free(decoded);
+		}
+
+		size_t chars = (size * 4 + 2) / 3;
+		for (size_t i = 0; i < chars; ++i)
+		{
+			void* decoded = NULL;
+			encode_base64(data, size, text, 1);
+			text[i] = (i & 1) ? '*' : (char)0x80;
+			if (cgltf_load_buffer_base64(&options, size, text, &decoded) != cgltf_result_io_error)
+				return -1;
+
+			/* A string that ends too early */
+			text[i] = 0;
+			if (cgltf_load_buffer_base64(&options, size, text, &decoded) != cgltf_result_io_error)
+				return -1;
+		}
+	}
+
+	return 0;
+}
 
 int main(int argc, char** argv)
 {
@@ -13,16 +108,51 @@ int main(int argc, char** argv)
 		return -1;
 	}
 
+	if (test_base64() != 0)
+	{
+		printf("Base64 decoding does not match the reference\n");
+		return -1;
+	}
+
+	if (test_deep_hierarchy() != 0)
+	{
+		printf("World transforms of a deep hierarchy are wrong\n");
+		return -1;
+	}
+
 	cgltf_options options = {0};
 	cgltf_data* data = NULL;
 	cgltf_result result = cgltf_parse_file(&options, argv[1], &data);
 
+	if (result == cgltf_result_success)
+	{
+		/* Load individual buffers out of order, as a job system would, and let cgltf_load_buffers complete the rest */
+		for (cgltf_size i = 0; i < data->buffers_count && result == cgltf_result_success; i += 2)
+			result = cgltf_load_buffer(&options, data, data->buffers_count - 1 - i, argv[1]);
+	}
+
 	if (result == cgltf_result_success)
 		result = cgltf_load_buffers(&options, data, argv[1]);
 
 	if (result == cgltf_result_success)
 		result = cgltf_validate(data);
 
+	if (result == cgltf_result_success)
+	{
+		cgltf_asset_info info;
+		result = cgltf_parse_asset_info(&options, data->file_data, data->file_size, &info);
+
+		if (result == cgltf_result_success &&
+			(info.file_type != data->file_type || info.meshes_count != data->meshes_count || info.accessors_count != data->accessors_count ||
+			info.nodes_count != data->nodes_count || info.materials_count != data->materials_count || info.lights_count != data->lights_count ||
+			info.animations_count != data->animations_count || info.extensions_required_count != data->extensions_required_count ||
+			info.bin_size != data->bin_size || !info.version.data || strncmp(info.version.data, data->asset.version, info.version.size) != 0))
+		{
+			printf("Asset info does not match the parsed data\n");
+			result = cgltf_result_invalid_gltf;
+		}
+	}
+
 	printf("Result: %d\n", result);
 
 	if (result == cgltf_result_success)
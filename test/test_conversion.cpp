@@ -5,6 +5,7 @@
 #include <cmath>
 #include <cstdio>
 #include <limits>
+#include <vector>
 
 static bool is_near(cgltf_float a, cgltf_float b)
 {
@@ -34,10 +35,6 @@ int main(int argc, char** argv)
 	for (cgltf_size blob_index = 0; blob_index < data->accessors_count; ++blob_index)
 	{
 		const cgltf_accessor* blob = data->accessors + blob_index;
-		if (blob->is_sparse)
-		{
-			continue;
-		}
 		if (blob->has_max && blob->has_min)
 		{
 			cgltf_float min0 = std::numeric_limits<float>::max();
@@ -54,7 +51,356 @@ int main(int argc, char** argv)
 				return -1;
 			}
 		}
+
+		cgltf_size num_components = cgltf_accessor_unpack_floats(blob, NULL, 0) / std::max<cgltf_size>(blob->count, 1);
+		std::vector<cgltf_float> unpacked(blob->count * num_components);
+		if (cgltf_accessor_unpack_floats(blob, unpacked.data(), unpacked.size()) != unpacked.size())
+		{
+			printf("Unable to unpack accessor %d\n", (int)blob_index);
+			return -1;
+		}
+		for (cgltf_size index = 0; index < blob->count; index++)
+		{
+			cgltf_accessor_read_float(blob, index, element, 16);
+			if (memcmp(element, &unpacked[index * num_components], num_components * sizeof(cgltf_float)) != 0)
+			{
+				printf("Unpacked element %d of accessor %d does not match cgltf_accessor_read_float\n", (int)index, (int)blob_index);
+				return -1;
+			}
+		}
+
+		if (blob->count > 2)
+		{
+			cgltf_size first = blob->count / 2;
+			std::vector<cgltf_float> range(num_components * 2);
+			if (cgltf_accessor_unpack_floats_range(blob, first, 2, range.data(), range.size()) != range.size() ||
+				memcmp(range.data(), &unpacked[first * num_components], range.size() * sizeof(cgltf_float)) != 0)
+			{
+				printf("Unpacked range of accessor %d does not match\n", (int)blob_index);
+				return -1;
+			}
+		}
+	}
+
+	for (cgltf_size mesh_index = 0; mesh_index < data->meshes_count; ++mesh_index)
+	{
+		const cgltf_mesh* mesh = data->meshes + mesh_index;
+		for (cgltf_size prim_index = 0; prim_index < mesh->primitives_count; ++prim_index)
+		{
+			const cgltf_accessor* indices = mesh->primitives[prim_index].indices;
+			if (!indices || indices->is_sparse)
+			{
+				continue;
+			}
+
+			std::vector<uint32_t> unpacked(cgltf_accessor_unpack_indices(indices, NULL, 4, 0));
+			if (cgltf_accessor_unpack_indices(indices, unpacked.data(), 4, unpacked.size()) != indices->count)
+			{
+				printf("Unable to unpack indices of mesh %d\n", (int)mesh_index);
+				return -1;
+			}
+			for (cgltf_size index = 0; index < indices->count; index++)
+			{
+				if (unpacked[index] != cgltf_accessor_read_index(indices, index))
+				{
+					printf("Unpacked index %d of mesh %d does not match cgltf_accessor_read_index\n", (int)index, (int)mesh_index);
+					return -1;
+				}
+			}
+		}
+	}
+
+	for (cgltf_size mesh_index = 0; mesh_index < data->meshes_count; ++mesh_index)
+	{
+		const cgltf_mesh* mesh = data->meshes + mesh_index;
+		for (cgltf_size prim_index = 0; prim_index < mesh->primitives_count; ++prim_index)
+		{
+			const cgltf_primitive* primitive = mesh->primitives + prim_index;
+			if (primitive->attributes_count == 0 || primitive->attributes_count > CGLTF_VERTEX_ELEMENTS_MAX)
+			{
+				continue;
+			}
+			// Once in the stored formats, which are copied, and once converted to floats
+			for (int converted = 0; converted < 2; ++converted)
+			{
+				std::vector<cgltf_vertex_element> elements(primitive->attributes_count);
+				cgltf_size stride = 0;
+				for (cgltf_size i = 0; i < primitive->attributes_count; ++i)
+				{
+					const cgltf_attribute& attribute = primitive->attributes[i];
+					elements[i].attribute_type = attribute.type;
+					elements[i].index = attribute.index;
+					elements[i].type = attribute.data->type;
+					elements[i].component_type = converted ? cgltf_component_type_r_32f : attribute.data->component_type;
+					elements[i].normalized = converted ? 0 : attribute.data->normalized;
+					elements[i].offset = stride;
+					stride += (cgltf_calc_size(elements[i].type, elements[i].component_type) + 3) & ~cgltf_size(3);
+				}
+				cgltf_vertex_layout layout = {elements.data(), elements.size(), stride};
+				cgltf_size vertex_count = cgltf_primitive_write_vertices(primitive, &layout, NULL, 0);
+				std::vector<uint8_t> vertices(vertex_count * stride);
+				if (cgltf_primitive_write_vertices(primitive, &layout, vertices.data(), vertex_count) != vertex_count)
+				{
+					printf("Unable to write the vertices of mesh %d\n", (int)mesh_index);
+					return -1;
+				}
+				for (cgltf_size index = 0; index < vertex_count; ++index)
+				{
+					for (cgltf_size i = 0; i < elements.size(); ++i)
+					{
+						cgltf_float expected[16], written[16];
+						cgltf_accessor_read_float(primitive->attributes[i].data, index, expected, 16);
+						cgltf_element_read_float(&vertices[index * stride + elements[i].offset], elements[i].type, elements[i].component_type, elements[i].normalized, written, 16);
+						if (memcmp(expected, written, cgltf_num_components(elements[i].type) * sizeof(cgltf_float)) != 0)
+						{
+							printf("Vertex %d of mesh %d does not match its attributes\n", (int)index, (int)mesh_index);
+							return -1;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	std::vector<cgltf_float> world_matrices(data->nodes_count * 16);
+	cgltf_scene_compute_world_transforms(data, NULL, world_matrices.data());
+	for (cgltf_size node_index = 0; node_index < data->nodes_count; ++node_index)
+	{
+		cgltf_float matrix[16];
+		cgltf_node_transform_world(data->nodes + node_index, matrix);
+		cgltf_float magnitude = 1;
+		for (int i = 0; i < 16; ++i)
+		{
+			magnitude = std::max(magnitude, std::abs(matrix[i]));
+		}
+		for (int i = 0; i < 16; ++i)
+		{
+			// Parent transforms are combined in a different order, so the results may differ by rounding
+			if (std::abs(matrix[i] - world_matrices[node_index * 16 + i]) > 1e-4f * magnitude)
+			{
+				printf("World transform of node %d does not match cgltf_node_transform_world\n", (int)node_index);
+				return -1;
+			}
+		}
+	}
+
+	// The node table must reproduce the same world matrices in its single pass, and mirror the accessors.
+	cgltf_node_table node_table;
+	cgltf_accessor_table accessor_table;
+	if (cgltf_node_table_create(&options, data, &node_table) != cgltf_result_success ||
+		cgltf_accessor_table_create(&options, data, &accessor_table) != cgltf_result_success)
+	{
+		printf("Unable to create the node and accessor tables\n");
+		return -1;
+	}
+	std::vector<cgltf_float> table_matrices(world_matrices);
+	cgltf_node_table_compute_world_transforms(&node_table, table_matrices.data());
+	if (table_matrices != world_matrices)
+	{
+		printf("World transforms of the node table do not match cgltf_scene_compute_world_transforms\n");
+		return -1;
+	}
+	for (cgltf_size i = 0; i < data->accessors_count; ++i)
+	{
+		const cgltf_accessor* accessor = data->accessors + i;
+		if (accessor_table.counts[i] != accessor->count || accessor_table.strides[i] != accessor->stride ||
+			accessor_table.types[i] != accessor->type || accessor_table.component_types[i] != accessor->component_type ||
+			((accessor_table.flags[i] & cgltf_accessor_flag_sparse) != 0) != (accessor->is_sparse != 0))
+		{
+			printf("Accessor %d does not match the accessor table\n", (int)i);
+			return -1;
+		}
+	}
+	cgltf_node_table_free(&node_table);
+	cgltf_accessor_table_free(&accessor_table);
+
+	for (cgltf_size skin_index = 0; skin_index < data->skins_count; ++skin_index)
+	{
+		const cgltf_skin* skin = data->skins + skin_index;
+		std::vector<cgltf_float> inverse_bind_matrices(skin->joints_count * 16);
+		if (skin->inverse_bind_matrices)
+		{
+			cgltf_accessor_unpack_floats(skin->inverse_bind_matrices, inverse_bind_matrices.data(), inverse_bind_matrices.size());
+		}
+		std::vector<cgltf_float> joint_matrices(skin->joints_count * 16);
+		cgltf_skin_compute_joint_matrices(data, skin, world_matrices.data(), skin->inverse_bind_matrices ? inverse_bind_matrices.data() : NULL, joint_matrices.data());
+		for (cgltf_size joint_index = 0; joint_index < skin->joints_count; ++joint_index)
+		{
+			cgltf_float world[16];
+			cgltf_float inverse_bind[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+			cgltf_node_transform_world(skin->joints[joint_index], world);
+			if (skin->inverse_bind_matrices)
+			{
+				cgltf_accessor_read_float(skin->inverse_bind_matrices, joint_index, inverse_bind, 16);
+			}
+			for (int column = 0; column < 4; ++column)
+			{
+				for (int row = 0; row < 4; ++row)
+				{
+					cgltf_float expected = 0;
+					cgltf_float magnitude = 1;
+					for (int k = 0; k < 4; ++k)
+					{
+						expected += world[k * 4 + row] * inverse_bind[column * 4 + k];
+						magnitude = std::max(magnitude, std::abs(world[k * 4 + row] * inverse_bind[column * 4 + k]));
+					}
+					if (std::abs(joint_matrices[joint_index * 16 + column * 4 + row] - expected) > 1e-4f * magnitude)
+					{
+						printf("Joint matrix %d of skin %d does not match\n", (int)joint_index, (int)skin_index);
+						return -1;
+					}
+				}
+			}
+		}
+	}
+
+	for (cgltf_size animation_index = 0; animation_index < data->animations_count; ++animation_index)
+	{
+		cgltf_animation_clip clip;
+		if (cgltf_animation_clip_create(&options, data->animations + animation_index, &clip) != cgltf_result_success)
+		{
+			printf("Unable to create a clip for animation %d\n", (int)animation_index);
+			return -1;
+		}
+		std::vector<cgltf_float> output(clip.output_count);
+		for (cgltf_size track_index = 0; track_index < clip.tracks_count; ++track_index)
+		{
+			const cgltf_animation_track& track = clip.tracks[track_index];
+			const cgltf_animation_sampler* sampler = data->animations[animation_index].channels[track_index].sampler;
+			bool cubic = track.interpolation == cgltf_interpolation_type_cubic_spline;
+			// Sample every keyframe forwards, which steps the cursors, and backwards, which searches for them
+			for (cgltf_size step = 0; step < track.keyframes_count * 2; ++step)
+			{
+				cgltf_size key = step < track.keyframes_count ? step : track.keyframes_count * 2 - 1 - step;
+				cgltf_animation_clip_sample(&clip, track.times[key], output.data());
+				cgltf_accessor_read_float(sampler->input, key, element, 16);
+				if (element[0] != track.times[key])
+				{
+					printf("Keyframe %d of track %d does not match its input accessor\n", (int)key, (int)track_index);
+					return -1;
+				}
+				std::vector<cgltf_float> expected(track.components_count);
+				cgltf_float length_squared = 0;
+				for (cgltf_size component = 0; component < track.components_count; ++component)
+				{
+					cgltf_size value_index = (key * (cubic ? 3 : 1) + (cubic ? 1 : 0)) * track.components_count + component;
+					bool scalar = sampler->output->type == cgltf_type_scalar;
+					cgltf_accessor_read_float(sampler->output, scalar ? value_index : value_index / track.components_count, element, 16);
+					expected[component] = element[scalar ? 0 : component];
+					length_squared += expected[component] * expected[component];
+				}
+				for (cgltf_size component = 0; component < track.components_count; ++component)
+				{
+					// Rotations come out normalized
+					if (track.target_path == cgltf_animation_path_type_rotation)
+					{
+						expected[component] /= std::sqrt(length_squared);
+					}
+					if (std::abs(output[track.output_offset + component] - expected[component]) > 1e-5f * std::max(1.0f, std::abs(expected[component])))
+					{
+						printf("Sampling track %d at keyframe %d does not produce its value\n", (int)track_index, (int)key);
+						return -1;
+					}
+				}
+			}
+			// Sample between the keyframes in increasing order, which steps the cursors forward, and compare with a
+			// double-precision evaluation of the same interpolation
+			const cgltf_size components = track.components_count;
+			for (cgltf_size key = 0; key + 1 < track.keyframes_count; ++key)
+			{
+				const double fractions[] = {0.25, 0.5, 0.75};
+				for (double fraction : fractions)
+				{
+					cgltf_float time = track.times[key] + (track.times[key + 1] - track.times[key]) * (cgltf_float)fraction;
+					if (!(time > track.times[key] && time < track.times[key + 1]))
+					{
+						continue;
+					}
+					cgltf_animation_clip_sample(&clip, time, output.data());
+
+					double delta = (double)track.times[key + 1] - track.times[key];
+					double t = (time - (double)track.times[key]) / delta;
+					const cgltf_float* current = track.values + key * components * (cubic ? 3 : 1) + (cubic ? components : 0);
+					const cgltf_float* next = current + components * (cubic ? 3 : 1);
+					std::vector<double> expected(components);
+					double scale = 1;
+					for (cgltf_size i = 0; i < components; ++i)
+					{
+						if (track.interpolation == cgltf_interpolation_type_step)
+						{
+							expected[i] = current[i];
+						}
+						else if (cubic)
+						{
+							double out_tangent = current[components + i] * delta;
+							double in_tangent = next[i - components] * delta;
+							expected[i] = (2 * t * t * t - 3 * t * t + 1) * current[i] + (t * t * t - 2 * t * t + t) * out_tangent +
+								(-2 * t * t * t + 3 * t * t) * next[i] + (t * t * t - t * t) * in_tangent;
+							scale = std::max(scale, std::max(std::abs(out_tangent), std::abs(in_tangent)));
+						}
+						else
+						{
+							expected[i] = current[i] + (next[i] - (double)current[i]) * t;
+						}
+						scale = std::max(scale, (double)std::max(std::abs(current[i]), std::abs(next[i])));
+					}
+					if (track.target_path == cgltf_animation_path_type_rotation)
+					{
+						if (track.interpolation == cgltf_interpolation_type_linear)
+						{
+							// Slerp along the shorter arc, blending linearly where the sine of the angle vanishes
+							cgltf_float cos_angle_float = current[0] * next[0] + current[1] * next[1] + current[2] * next[2] + current[3] * next[3];
+							double cos_angle = 0;
+							for (int i = 0; i < 4; ++i)
+							{
+								cos_angle += (double)current[i] * next[i];
+							}
+							double sign = cos_angle < 0 ? -1 : 1;
+							double weight_current = 1 - t;
+							double weight_next = t;
+							if (std::abs(cos_angle_float) < 0.9995f)
+							{
+								double angle = std::acos(std::abs(cos_angle));
+								weight_current = std::sin((1 - t) * angle) / std::sin(angle);
+								weight_next = std::sin(t * angle) / std::sin(angle);
+							}
+							for (int i = 0; i < 4; ++i)
+							{
+								expected[i] = weight_current * current[i] + sign * weight_next * next[i];
+							}
+						}
+						double length = std::sqrt(expected[0] * expected[0] + expected[1] * expected[1] + expected[2] * expected[2] + expected[3] * expected[3]);
+						for (int i = 0; i < 4; ++i)
+						{
+							expected[i] /= length;
+						}
+						scale = 1;
+					}
+					for (cgltf_size i = 0; i < components; ++i)
+					{
+						if (std::abs(output[track.output_offset + i] - expected[i]) > 5e-7 * scale)
+						{
+							printf("Sampling track %d between keyframes %d and %d is off by %g\n", (int)track_index, (int)key, (int)key + 1,
+								std::abs(output[track.output_offset + i] - expected[i]));
+							return -1;
+						}
+					}
+				}
+			}
+		}
+		cgltf_animation_clip_free(&clip);
+	}
+
+	cgltf_options mesh_options = {};
+	mesh_options.sections = cgltf_section_meshes;
+	cgltf_data* mesh_data = NULL;
+	result = cgltf_parse_file(&mesh_options, argv[1], &mesh_data);
+	if (result != cgltf_result_success || mesh_data->meshes_count != data->meshes_count || mesh_data->accessors_count != data->accessors_count || mesh_data->nodes_count != 0)
+	{
+		printf("Parsing only meshes did not produce the meshes and their accessors\n");
+		return -1;
 	}
+	cgltf_free(mesh_data);
 
 	cgltf_free(data);
 
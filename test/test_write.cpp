@@ -1,11 +1,14 @@
 #define CGLTF_IMPLEMENTATION
 #define CGLTF_WRITE_IMPLEMENTATION
+// Small batches, so that the test files are parsed in several of them
+#define CGLTF_PARALLEL_BATCH_SIZE 2
 #include "../cgltf_write.h"
 
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <limits>
+#include <vector>
 
 int main(int argc, char** argv)
 {
@@ -36,10 +39,372 @@ int main(int argc, char** argv)
 	{
 		return result;
 	}
-	if (data0->meshes_count != data1->meshes_count) {
+	cgltf_size meshes_count = data1->meshes_count;
+	cgltf_free(data1);
+	remove("out.gltf");
+	if (data0->meshes_count != meshes_count) {
 		return -1;
 	}
-	cgltf_free(data1);
+
+	// Parsing into an arena with strings in place must produce the same data as individual allocations.
+	cgltf_options arena_options = {};
+	arena_options.arena_allocation = 1;
+	arena_options.strings_in_place = 1;
+	cgltf_data* data2 = NULL;
+	result = cgltf_parse_file(&arena_options, argv[1], &data2);
+	if (result != cgltf_result_success)
+	{
+		return result;
+	}
+	std::vector<char> json0(cgltf_write(&options, NULL, 0, data0));
+	std::vector<char> json2(cgltf_write(&options, NULL, 0, data2));
+	cgltf_write(&options, json0.data(), json0.size(), data0);
+	cgltf_write(&options, json2.data(), json2.size(), data2);
+	if (json0 != json2) {
+		return -1;
+	}
+
+	// Streaming must produce the same JSON as writing into a buffer, without the null terminator.
+	std::vector<char> streamed;
+	result = cgltf_write_stream(&options, [](void* user, const char* chunk, cgltf_size size) -> cgltf_bool {
+		std::vector<char>* out = static_cast<std::vector<char>*>(user);
+		out->insert(out->end(), chunk, chunk + size);
+		return 1;
+	}, &streamed, data0);
+	streamed.push_back(0);
+	if (result != cgltf_result_success || streamed != json0) {
+		return -1;
+	}
+	cgltf_free(data2);
+
+	// Parsing in batches that run out of order must produce the same data as a serial parse.
+	cgltf_options parallel_options = {};
+	parallel_options.parallel_for = [](void*, cgltf_size count, void (*task)(void*, cgltf_size), void* task_data) {
+		for (cgltf_size i = count; i > 0; --i)
+		{
+			task(task_data, i - 1);
+		}
+	};
+	cgltf_data* data6 = NULL;
+	result = cgltf_parse_file(&parallel_options, argv[1], &data6);
+	if (result != cgltf_result_success)
+	{
+		return result;
+	}
+	if (cgltf_validate_parallel(&parallel_options, data6) != cgltf_validate(data6)) {
+		return -1;
+	}
+	std::vector<char> json6(cgltf_write(&options, NULL, 0, data6));
+	cgltf_write(&options, json6.data(), json6.size(), data6);
+	cgltf_free(data6);
+	if (json0 != json6) {
+		return -1;
+	}
+
+	// Statistics must count every allocation, also when the elements are parsed in parallel batches.
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		cgltf_size allocations = 0;
+		cgltf_stats stats = {};
+		stats.clock = [](void* user) -> double { return (double)++*static_cast<int*>(user); };
+		int ticks = 0;
+		stats.clock_user_data = &ticks;
+		cgltf_options stats_options = pass ? parallel_options : options;
+		stats_options.stats = &stats;
+		stats_options.memory_user_data = &allocations;
+		stats_options.memory_alloc = [](void* user, cgltf_size size) { ++*static_cast<cgltf_size*>(user); return malloc(size); };
+		stats_options.memory_free = [](void*, void* ptr) { free(ptr); };
+		cgltf_data* data9 = NULL;
+		result = cgltf_parse_file(&stats_options, argv[1], &data9);
+		if (result != cgltf_result_success)
+		{
+			return result;
+		}
+		cgltf_validate_parallel(&stats_options, data9);
+		cgltf_free(data9);
+		if (stats.allocations_count != allocations || stats.tokens_count == 0 || stats.files_count != 1 ||
+			stats.file_time <= 0 || stats.tokenize_time <= 0 || stats.parse_time <= 0 || stats.validate_time <= 0) {
+			return -1;
+		}
+	}
+
+	// Allocations that fail are not counted.
+	{
+		cgltf_size budget[2] = { 2, 0 }; // allocations left, allocations made: the file and the tokens, but not the data
+		cgltf_stats stats = {};
+		cgltf_options failing_options = options;
+		failing_options.stats = &stats;
+		failing_options.memory_user_data = budget;
+		failing_options.memory_alloc = [](void* user, cgltf_size size) -> void* {
+			cgltf_size* budget = static_cast<cgltf_size*>(user);
+			if (budget[0] == 0) return NULL;
+			--budget[0];
+			++budget[1];
+			return malloc(size);
+		};
+		failing_options.memory_free = [](void*, void* ptr) { free(ptr); };
+		cgltf_data* data12 = NULL;
+		result = cgltf_parse_file(&failing_options, argv[1], &data12);
+		if (result != cgltf_result_out_of_memory || stats.allocations_count != budget[1]) {
+			return -1;
+		}
+	}
+
+	// A context recycles the token buffer and the arena between parses without changing the results.
+	cgltf_context context = {};
+	arena_options.context = &context;
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		cgltf_data* data3 = NULL;
+		result = cgltf_parse_file(&arena_options, argv[1], &data3);
+		if (result != cgltf_result_success)
+		{
+			return result;
+		}
+		std::vector<char> json3(cgltf_write(&options, NULL, 0, data3));
+		cgltf_write(&options, json3.data(), json3.size(), data3);
+		cgltf_free(data3);
+		if (json0 != json3 || !context.tokens || !context.arena_block) {
+			return -1;
+		}
+	}
+	cgltf_context_free(&context);
+
+	// A cache must load back as the same document, parsed both from memory and from a file.
+	const char* cache_path = "test_write.cache.tmp";
+	std::vector<char> cache(cgltf_write_cache(data0, NULL, 0));
+	if (cgltf_write_cache(data0, cache.data(), cache.size()) != cache.size()) {
+		return -1;
+	}
+	FILE* cache_file = fopen(cache_path, "wb");
+	if (!cache_file || fwrite(cache.data(), 1, cache.size(), cache_file) != cache.size() || fclose(cache_file) != 0) {
+		return -1;
+	}
+	cgltf_data* data7 = NULL;
+	cgltf_data* data8 = NULL;
+	result = cgltf_parse_cache(&options, cache.data(), cache.size(), &data7);
+	if (result == cgltf_result_success)
+	{
+		result = cgltf_parse_cache_file(&options, cache_path, &data8);
+	}
+	if (result != cgltf_result_success)
+	{
+		return result;
+	}
+	std::vector<char> json7(cgltf_write(&options, NULL, 0, data7));
+	std::vector<char> json8(cgltf_write(&options, NULL, 0, data8));
+	cgltf_write(&options, json7.data(), json7.size(), data7);
+	cgltf_write(&options, json8.data(), json8.size(), data8);
+	cgltf_free(data7);
+	cgltf_free(data8);
+	if (json0 != json7 || json0 != json8) {
+		return -1;
+	}
+
+	// A relocation table that overlaps the data, or a slot inside the table, must be rejected.
+	cgltf_cache_header cache_header;
+	memcpy(&cache_header, cache.data(), sizeof(cache_header));
+	if (cache_header.relocations_count > 0)
+	{
+		std::vector<char> bad_cache(cache);
+		cgltf_cache_header bad_header = cache_header;
+		bad_header.relocations_offset = 0;
+		memcpy(bad_cache.data(), &bad_header, sizeof(bad_header));
+		cgltf_data* bad_data = NULL;
+		if (cgltf_parse_cache(&options, bad_cache.data(), bad_cache.size(), &bad_data) != cgltf_result_invalid_gltf) {
+			return -1;
+		}
+		bad_cache = cache;
+		cgltf_size slot = cache_header.relocations_offset;
+		memcpy(bad_cache.data() + cache_header.relocations_offset, &slot, sizeof(slot));
+		if (cgltf_parse_cache(&options, bad_cache.data(), bad_cache.size(), &bad_data) != cgltf_result_invalid_gltf) {
+			return -1;
+		}
+	}
+
+	// Mapped files must produce the same document and buffers as files that are read.
+	cgltf_options map_options = {};
+	map_options.map_files = 1;
+	cgltf_data* data10 = NULL;
+	cgltf_data* data11 = NULL;
+	result = cgltf_parse_file(&map_options, argv[1], &data10);
+	if (result == cgltf_result_success)
+	{
+		result = cgltf_parse_file(&options, argv[1], &data11);
+	}
+	if (result != cgltf_result_success)
+	{
+		return result;
+	}
+	std::vector<char> json10(cgltf_write(&options, NULL, 0, data10));
+	cgltf_write(&options, json10.data(), json10.size(), data10);
+	if (json0 != json10 || data10->file_data_free_method != cgltf_data_free_method_unmap) {
+		return -1;
+	}
+	if (cgltf_load_buffers(&map_options, data10, argv[1]) == cgltf_result_success)
+	{
+		if (cgltf_load_buffers(&options, data11, argv[1]) != cgltf_result_success)
+		{
+			return -1;
+		}
+		for (cgltf_size i = 0; i < data10->buffers_count; ++i)
+		{
+			if (data10->buffers[i].size != data11->buffers[i].size || memcmp(data10->buffers[i].data, data11->buffers[i].data, data10->buffers[i].size) != 0) {
+				return -1;
+			}
+		}
+	}
+	cgltf_free(data10);
+	cgltf_free(data11);
+
+	// Every file read through the callbacks, including buffers and caches, must be released by cgltf_free.
+	int file_reads[2] = {};
+	cgltf_stats file_stats = {};
+	cgltf_options file_options = {};
+	file_options.stats = &file_stats;
+	file_options.file_user_data = file_reads;
+	file_options.file_read = [](void* user, const char* path, cgltf_size* size, void** data) {
+		FILE* file = fopen(path, "rb");
+		if (!file)
+		{
+			return cgltf_result_file_not_found;
+		}
+		fseek(file, 0, SEEK_END);
+		long length = ftell(file);
+		fseek(file, 0, SEEK_SET);
+		void* contents = malloc(length > 0 ? length : 1);
+		bool ok = length >= 0 && contents && fread(contents, 1, length, file) == (size_t)length;
+		fclose(file);
+		if (!ok)
+		{
+			free(contents);
+			return cgltf_result_io_error;
+		}
+		static_cast<int*>(user)[0]++;
+		*size = (cgltf_size)length;
+		*data = contents;
+		return cgltf_result_success;
+	};
+	file_options.file_release = [](void* user, void* data) {
+		static_cast<int*>(user)[1]++;
+		free(data);
+	};
+	cgltf_data* data12 = NULL;
+	cgltf_data* data13 = NULL;
+	result = cgltf_parse_file(&file_options, argv[1], &data12);
+	if (result == cgltf_result_success)
+	{
+		cgltf_load_buffers(&file_options, data12, argv[1]);
+		result = cgltf_parse_cache_file(&file_options, cache_path, &data13);
+	}
+	if (result != cgltf_result_success)
+	{
+		return result;
+	}
+	if (data12->file_data_free_method != cgltf_data_free_method_file_release || file_reads[1] != 0) {
+		return -1;
+	}
+	cgltf_free(data12);
+	cgltf_free(data13);
+	remove(cache_path);
+	if (file_reads[0] < 2 || file_reads[0] != file_reads[1] || file_stats.files_count != (cgltf_size)file_reads[0]) {
+		return -1;
+	}
+
+	// A compact GLB must read back as the same document, with the first buffer in its BIN chunk.
+	if (cgltf_load_buffers(&options, data0, argv[1]) == cgltf_result_success)
+	{
+		cgltf_options compact_options = {};
+		compact_options.compact_json = 1;
+		std::vector<char> glb(cgltf_write_glb(&compact_options, NULL, 0, data0));
+		if (glb.empty() || cgltf_write_glb(&compact_options, glb.data(), glb.size(), data0) != glb.size()) {
+			return -1;
+		}
+		cgltf_data* data4 = NULL;
+		result = cgltf_parse(&options, glb.data(), glb.size(), &data4);
+		if (result == cgltf_result_success)
+		{
+			result = cgltf_load_buffers(&options, data4, argv[1]);
+		}
+		if (result != cgltf_result_success)
+		{
+			return result;
+		}
+		if (data4->file_type != cgltf_file_type_glb || data4->meshes_count != data0->meshes_count ||
+			data4->accessors_count != data0->accessors_count || data4->nodes_count != data0->nodes_count ||
+			data4->buffers_count != data0->buffers_count || memchr(data4->json, '\n', data4->json_size)) {
+			return -1;
+		}
+		if (data0->buffers_count > 0 && memcmp(data4->buffers[0].data, data0->buffers[0].data, data0->buffers[0].size) != 0) {
+			return -1;
+		}
+		// Feeding the GLB in small pieces must signal every view of the BIN chunk once, with its bytes in place.
+		cgltf_stream stream;
+		cgltf_stream_init(&options, &stream);
+		std::vector<cgltf_buffer_view*> signaled;
+		stream.user_data = &signaled;
+		stream.on_buffer_view = [](void* user, cgltf_data*, cgltf_buffer_view* buffer_view) {
+			static_cast<std::vector<cgltf_buffer_view*>*>(user)->push_back(buffer_view);
+		};
+		for (cgltf_size offset = 0; offset < glb.size() && result == cgltf_result_success; offset += 7)
+		{
+			result = cgltf_stream_feed(&stream, glb.data() + offset, std::min<cgltf_size>(7, glb.size() - offset));
+		}
+		cgltf_stream_free(&stream);
+		if (result != cgltf_result_success || !stream.complete || !stream.data || stream.data->meshes_count != data0->meshes_count)
+		{
+			return -1;
+		}
+		for (cgltf_size i = 0; i < data4->buffer_views_count; ++i)
+		{
+			const cgltf_buffer_view* view = &data4->buffer_views[i];
+			cgltf_size count = std::count(signaled.begin(), signaled.end(), &stream.data->buffer_views[i]);
+			if (count != (view->buffer == data4->buffers ? 1u : 0u) ||
+				(count && memcmp((char*)stream.data->buffers[0].data + view->offset, (char*)data4->buffers[0].data + view->offset, view->size) != 0))
+			{
+				return -1;
+			}
+		}
+		cgltf_free(stream.data);
+
+		// A broken JSON chunk must fail every later feed with the same error, also when the caller keeps feeding.
+		std::vector<char> broken(glb);
+		broken[20] = 'x';
+		cgltf_stream_init(&options, &stream);
+		cgltf_result first = cgltf_result_success;
+		for (cgltf_size offset = 0; offset < broken.size(); offset += 7)
+		{
+			result = cgltf_stream_feed(&stream, broken.data() + offset, std::min<cgltf_size>(7, broken.size() - offset));
+			first = first == cgltf_result_success ? result : first;
+			if (first != cgltf_result_success && result != first)
+			{
+				return -1;
+			}
+		}
+		cgltf_stream_free(&stream);
+		if (first == cgltf_result_success || stream.error != first || stream.data || stream.complete)
+		{
+			return -1;
+		}
+		cgltf_free(data4);
+
+		result = cgltf_write_glb_file(&compact_options, "out.glb", data0);
+		cgltf_data* data5 = NULL;
+		if (result == cgltf_result_success)
+		{
+			result = cgltf_parse_file(&options, "out.glb", &data5);
+		}
+		remove("out.glb");
+		if (result != cgltf_result_success)
+		{
+			return result;
+		}
+		if (data5->file_size != glb.size() || memcmp(data5->file_data, glb.data(), glb.size()) != 0) {
+			return -1;
+		}
+		cgltf_free(data5);
+	}
+
 	cgltf_free(data0);
 	return cgltf_result_success;
 }